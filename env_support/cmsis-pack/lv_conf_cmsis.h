@@ -119,16 +119,17 @@
     #define LV_DRAW_SW_COMPLEX          1
 
     #if LV_DRAW_SW_COMPLEX == 1
-        /*Allow buffering some shadow calculation.
-        *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
-        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
-
-        /* Set number of maximally cached circle data.
-        * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+        /* Size of the cache for the blurred corners of box shadows in bytes.
+        * (shadow_width + radius)^2 * 2 bytes are used per shadow shape.
+        * The least recently used shapes are dropped when the cache is full.
         * 0: to disable caching */
-        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+        #define LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES (8 * 1024)
+
+        /* Size of the cache for the anti-aliased corners of rounded rectangles in bytes.
+        * The circumference of 1/4 circle is saved for each radius, radius * 6 bytes are used per radius.
+        * The least recently used radiuses are dropped when the cache is full.
+        * 0: to disable caching */
+        #define LV_DRAW_SW_CORNER_CACHE_SIZE (4 * 1024)
     #endif
 
     #if !defined(LV_USE_DRAW_SW_ASM) && defined(RTE_Acceleration_Arm_2D)
@@ -74,6 +74,10 @@
 /*Default display refresh, input device read and animation step period.*/
 #define LV_DEF_REFR_PERIOD  33      /*[ms]*/
 
+/*Default max. size of a strip rendered at once in LV_DISPLAY_RENDER_MODE_PARTIAL.
+ *Around the size of the L2 cache keeps the rendered strip in the cache. 0: fill the whole draw buffer*/
+#define LV_DEF_STRIP_SIZE   (256 * 1024)    /*[bytes]*/
+
 /*Default Dot Per Inch. Used to initialize default sizes such as widgets sized, style paddings.
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF 130     /*[px/inch]*/
@@ -113,11 +117,38 @@
 /*The target buffer size for simple layer chunks.*/
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (24 * 1024)   /*[bytes]*/
 
+/*Keep the rendered layers of widgets in a cache of this many bytes.
+ *While only the opacity or transformation of a widget changes (e.g. it's faded or rotated)
+ *it's not rendered again, just its cached layer is blended.
+ *The least recently used layers are dropped when the cache is full. 0: disable the cache*/
+#define LV_DRAW_LAYER_CACHE_DEF_SIZE     0   /*[bytes]*/
+
+/*Limit the memory used by all the layers, including the cached ones.
+ *If a new layer would exceed it the least recently used cached layers are dropped first
+ *and layers are not cached if they wouldn't fit. 0: no limit*/
+#define LV_DRAW_LAYER_MAX_MEMORY         0   /*[bytes]*/
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
 #define LV_DRAW_THREAD_STACK_SIZE    (8 * 1024)   /*[bytes]*/
 
+/* Number of draw tasks (and the same number of draw descriptors) to allocate from a pool
+ * instead of `lv_malloc`. The pool is allocated on first use and reset when all draw tasks are finished.
+ * If more draw tasks are needed they are allocated with `lv_malloc`.
+ * 0: don't use a pool*/
+#define LV_DRAW_TASK_POOL_CNT    0
+
+/* Number of the newest draw tasks of a layer which are kept back from the draw units,
+ * so that the later opaque tasks can still cull them. The older tasks are dispatched
+ * while the rest of the tasks are created.
+ * 0: dispatch the tasks right away and cull only the ones which weren't taken yet*/
+#define LV_DRAW_CULL_WINDOW    16
+
+/* Allow widgets with `LV_OBJ_FLAG_RETAIN_DRAW` to keep the draw tasks of their main part
+ * and replay them in the next refreshes while the widget is unchanged.*/
+#define LV_USE_DRAW_LIST    0
+
 #define LV_USE_DRAW_SW 1
 #if LV_USE_DRAW_SW == 1
     /* Set the number of draw unit.
@@ -136,16 +167,17 @@
     #define LV_DRAW_SW_COMPLEX          1
 
     #if LV_DRAW_SW_COMPLEX == 1
-        /*Allow buffering some shadow calculation.
-        *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
-        #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
-
-        /* Set number of maximally cached circle data.
-        * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+        /* Size of the cache for the blurred corners of box shadows in bytes.
+        * (shadow_width + radius)^2 * 2 bytes are used per shadow shape.
+        * The least recently used shapes are dropped when the cache is full.
+        * 0: to disable caching */
+        #define LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES (8 * 1024)
+
+        /* Size of the cache for the anti-aliased corners of rounded rectangles in bytes.
+        * The circumference of 1/4 circle is saved for each radius, radius * 6 bytes are used per radius.
+        * The least recently used radiuses are dropped when the cache is full.
         * 0: to disable caching */
-        #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+        #define LV_DRAW_SW_CORNER_CACHE_SIZE (4 * 1024)
     #endif
 
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
@@ -821,6 +853,15 @@
     #define LV_PROFILER_END_TAG   LV_PROFILER_BUILTIN_END_TAG
 #endif
 
+/*1: Record the type, area, draw unit, queue wait and execution time of each draw task.
+ * Print per type histograms with `lv_draw_trace_dump_stat()`
+ * or export a Chrome trace with `lv_draw_trace_dump_chrome()`*/
+#define LV_USE_DRAW_TRACE 0
+#if LV_USE_DRAW_TRACE
+    /*Number of the last draw tasks kept for the Chrome trace*/
+    #define LV_DRAW_TRACE_RECORD_CNT 1024
+#endif
+
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
 
@@ -110,6 +110,8 @@ extern "C" {
 
 #include "src/draw/lv_draw.h"
 #include "src/draw/lv_draw_buf.h"
+#include "src/draw/lv_draw_layer_cache.h"
+#include "src/draw/lv_draw_trace.h"
 #include "src/draw/lv_draw_vector.h"
 
 #include "src/themes/lv_theme.h"
@@ -48,6 +48,9 @@ fout.write(
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_SSE2         3
+#define LV_DRAW_SW_ASM_AVX2         4
+#define LV_DRAW_SW_ASM_X86          5
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 /* Handle special Kconfig options */
@@ -197,6 +200,14 @@ LV_EXPORT_CONST_INT(LV_DRAW_BUF_ALIGN);
     #define LV_USE_THORVG  (LV_USE_THORVG_INTERNAL || LV_USE_THORVG_EXTERNAL)
 #endif
 
+#if LV_DRAW_SW_COMPLEX && defined(LV_DRAW_SW_CIRCLE_CACHE_SIZE)
+    #warning "LV_DRAW_SW_CIRCLE_CACHE_SIZE was replaced by LV_DRAW_SW_CORNER_CACHE_SIZE which is set in bytes. Please update lv_conf.h or run menuconfig again."
+#endif
+
+#if LV_DRAW_SW_COMPLEX && defined(LV_DRAW_SW_SHADOW_CACHE_SIZE)
+    #warning "LV_DRAW_SW_SHADOW_CACHE_SIZE was replaced by LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES which is set in bytes instead of shadow size. Please update lv_conf.h or run menuconfig again."
+#endif
+
 #if LV_USE_OS
     #if (LV_USE_FREETYPE || LV_USE_THORVG) && LV_DRAW_THREAD_STACK_SIZE < (32 * 1024)
         #warning "Increase LV_DRAW_THREAD_STACK_SIZE to at least 32KB for FreeType or ThorVG."
@@ -56,10 +56,18 @@ struct _snippet_stack;
 struct _lv_freetype_context_t;
 #endif
 
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+struct _lv_draw_sw_blend_x86_kernels_t;
+#endif
+
 #if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
 struct _lv_profiler_builtin_ctx_t;
 #endif
 
+#if LV_USE_DRAW_TRACE
+struct _lv_draw_trace_ctx_t;
+#endif
+
 #if LV_USE_NUTTX
 struct _lv_nuttx_ctx_t;
 #endif
@@ -106,13 +114,15 @@ typedef struct _lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+    lv_cache_t * layer_cache;
 
     lv_draw_global_info_t draw_info;
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    lv_draw_sw_shadow_cache_t sw_shadow_cache;
-#endif
 #if LV_DRAW_SW_COMPLEX
-    _lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+    lv_cache_t * sw_corner_cache;
+    lv_cache_t * sw_shadow_cache;
+#endif
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+    const struct _lv_draw_sw_blend_x86_kernels_t * sw_blend_x86_kernels;
 #endif
 
 #if LV_USE_LOG
@@ -183,6 +193,10 @@ typedef struct _lv_global_t {
     struct _lv_profiler_builtin_ctx_t * profiler_context;
 #endif
 
+#if LV_USE_DRAW_TRACE
+    struct _lv_draw_trace_ctx_t * draw_trace_context;
+#endif
+
 #if LV_USE_FILE_EXPLORER != 0
     lv_style_t fe_list_button_style;
 #endif
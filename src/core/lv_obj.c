@@ -20,6 +20,8 @@
 #include "../misc/lv_types.h"
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_string.h"
+#include "../draw/lv_draw_list.h"
+#include "../draw/lv_draw_layer_cache.h"
 
 /*********************
  *      DEFINES
@@ -374,6 +376,11 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
         lv_event_remove_all(&obj->spec_attr->event_list);
 
+#if LV_USE_DRAW_LIST
+        lv_draw_list_delete(obj->spec_attr->draw_list);
+#endif
+        lv_draw_layer_cache_drop(obj);
+
         lv_free(obj->spec_attr);
         obj->spec_attr = NULL;
     }
@@ -11,6 +11,8 @@
 #include "../display/lv_display.h"
 #include "../indev/lv_indev.h"
 #include "../stdlib/lv_string.h"
+#include "../draw/lv_draw_list.h"
+#include "../draw/lv_draw_layer_cache.h"
 
 /*********************
  *      DEFINES
@@ -24,6 +26,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void invalidate_children_layer_cache(const lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -319,6 +322,54 @@ lv_layer_type_t _lv_obj_get_layer_type(const lv_obj_t * obj)
     else return LV_LAYER_TYPE_NONE;
 }
 
+void _lv_obj_invalidate_draw_list(const lv_obj_t * obj, bool recursive)
+{
+#if LV_USE_DRAW_LIST
+    if(obj->spec_attr == NULL) return;
+    if(obj->spec_attr->draw_list) lv_draw_list_invalidate(obj->spec_attr->draw_list);
+
+    if(recursive) {
+        uint32_t i;
+        for(i = 0; i < obj->spec_attr->child_cnt; i++) {
+            _lv_obj_invalidate_draw_list(obj->spec_attr->children[i], true);
+        }
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(recursive);
+#endif
+}
+
+void _lv_obj_invalidate_layer_cache(const lv_obj_t * obj, bool recursive)
+{
+    if(!lv_draw_layer_cache_is_enabled()) return;
+
+    if(recursive) invalidate_children_layer_cache(obj);
+
+    /*The cached layers of the parents contain the object too*/
+    while(obj) {
+        /*Only the objects with special attributes can have a layer*/
+        if(obj->spec_attr) lv_draw_layer_cache_drop(obj);
+        obj = obj->parent;
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Drop the cached layers of all the descendants of an object
+ * @param obj       pointer to an object
+ */
+static void invalidate_children_layer_cache(const lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < obj->spec_attr->child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(child->spec_attr) lv_draw_layer_cache_drop(child);
+        invalidate_children_layer_cache(child);
+    }
+}
@@ -107,6 +107,22 @@ int32_t _lv_obj_get_ext_draw_size(const lv_obj_t * obj);
 
 lv_layer_type_t _lv_obj_get_layer_type(const lv_obj_t * obj);
 
+/**
+ * Mark the retained draw tasks of an object as outdated, so that it will be drawn again in the next refresh.
+ * Should be called when anything changes that affects the drawing of the object.
+ * @param obj       pointer to an object
+ * @param recursive true: outdate the draw tasks of the children too (e.g. as styles are inherited)
+ */
+void _lv_obj_invalidate_draw_list(const lv_obj_t * obj, bool recursive);
+
+/**
+ * Drop the cached layers of an object and its parents, so that they will be rendered again in the next refresh.
+ * Should be called when anything changes that affects the drawing of the object.
+ * @param obj       pointer to an object
+ * @param recursive true: drop the cached layers of the descendants too (e.g. as styles are inherited)
+ */
+void _lv_obj_invalidate_layer_cache(const lv_obj_t * obj, bool recursive);
+
 /**********************
  *      MACROS
  **********************/
@@ -29,6 +29,8 @@ static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
+static void invalidate_area_core(const lv_obj_t * obj, const lv_area_t * area);
+static void get_ext_coords(const lv_obj_t * obj, lv_area_t * coords);
 
 /**********************
  *  STATIC VARIABLES
@@ -807,20 +809,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    lv_display_t * disp   = lv_obj_get_display(obj);
-    if(!lv_display_is_invalidation_enabled(disp)) return;
+    /*Even if the object is not visible now its retained draw tasks and cached layers are not valid anymore*/
+    _lv_obj_invalidate_draw_list(obj, false);
+    _lv_obj_invalidate_layer_cache(obj, false);
 
-    lv_area_t area_tmp;
-    lv_area_copy(&area_tmp, area);
-
-    if(!lv_obj_area_is_visible(obj, &area_tmp)) return;
-    if(obj->spec_attr && obj->spec_attr->layer_type == LV_LAYER_TYPE_TRANSFORM) {
-        /*Make the area slightly larger to avoid rounding errors.
-         *5 is an empirical value*/
-        lv_area_increase(&area_tmp, 5, 5);
-    }
-
-    _lv_inv_area(lv_obj_get_display(obj),  &area_tmp);
+    invalidate_area_core(obj, area);
 }
 
 void lv_obj_invalidate(const lv_obj_t * obj)
@@ -829,16 +822,21 @@ void lv_obj_invalidate(const lv_obj_t * obj)
 
     /*Truncate the area to the object*/
     lv_area_t obj_coords;
-    int32_t ext_size = _lv_obj_get_ext_draw_size(obj);
-    lv_area_copy(&obj_coords, &obj->coords);
-    obj_coords.x1 -= ext_size;
-    obj_coords.y1 -= ext_size;
-    obj_coords.x2 += ext_size;
-    obj_coords.y2 += ext_size;
+    get_ext_coords(obj, &obj_coords);
 
     lv_obj_invalidate_area(obj, &obj_coords);
 }
 
+void _lv_obj_invalidate_layer_blending(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_area_t obj_coords;
+    get_ext_coords(obj, &obj_coords);
+
+    invalidate_area_core(obj, &obj_coords);
+}
+
 bool lv_obj_area_is_visible(const lv_obj_t * obj, lv_area_t * area)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
@@ -1161,3 +1159,41 @@ static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p
 
     lv_point_array_transform(p, p_count, angle, scale_x, scale_y, &pivot, !inv);
 }
+
+/**
+ * Mark an area of an object as invalid on its display
+ * @param obj       pointer to an object
+ * @param area      the area to redraw
+ */
+static void invalidate_area_core(const lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_display_t * disp   = lv_obj_get_display(obj);
+    if(!lv_display_is_invalidation_enabled(disp)) return;
+
+    lv_area_t area_tmp;
+    lv_area_copy(&area_tmp, area);
+
+    if(!lv_obj_area_is_visible(obj, &area_tmp)) return;
+    if(obj->spec_attr && obj->spec_attr->layer_type == LV_LAYER_TYPE_TRANSFORM) {
+        /*Make the area slightly larger to avoid rounding errors.
+         *5 is an empirical value*/
+        lv_area_increase(&area_tmp, 5, 5);
+    }
+
+    _lv_inv_area(lv_obj_get_display(obj),  &area_tmp);
+}
+
+/**
+ * Get the coordinates of an object including its extra draw size
+ * @param obj       pointer to an object
+ * @param coords    store the result area here
+ */
+static void get_ext_coords(const lv_obj_t * obj, lv_area_t * coords)
+{
+    int32_t ext_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_copy(coords, &obj->coords);
+    coords->x1 -= ext_size;
+    coords->y1 -= ext_size;
+    coords->x2 += ext_size;
+    coords->y2 += ext_size;
+}
@@ -385,6 +385,13 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area);
  */
 void lv_obj_invalidate(const lv_obj_t * obj);
 
+/**
+ * Mark the object as invalid to redrawn its area, but keep its retained draw tasks and cached layer.
+ * Used when only the blending of the object's layer changes (e.g. its opacity or transformation).
+ * @param obj       pointer to an object
+ */
+void _lv_obj_invalidate_layer_blending(const lv_obj_t * obj);
+
 /**
  * Tell whether an area of an object is visible (even partially) now or not
  * @param obj       pointer to an object
@@ -11,6 +11,8 @@
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_scroll.h"
 #include "../display/lv_display.h"
+#include "../display/lv_display_private.h"
+#include "lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -36,6 +38,10 @@ static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_end_cb(lv_anim_t * a);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+static bool scroll_blit(lv_obj_t * obj, int32_t dx, int32_t dy);
+static bool scroll_blit_is_possible(lv_obj_t * obj);
+static bool has_draw_event_cb(lv_obj_t * obj, lv_event_code_t first_code);
+static bool is_drawn_over(lv_obj_t * obj, uint32_t first_idx, const lv_area_t * area);
 
 /**********************
  *  STATIC VARIABLES
@@ -420,7 +426,9 @@ lv_result_t _lv_obj_scroll_by_raw(lv_obj_t * obj, int32_t x, int32_t y)
     lv_obj_move_children_by(obj, x, y, true);
     lv_result_t res = lv_obj_send_event(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RESULT_OK) return res;
-    lv_obj_invalidate(obj);
+
+    /*Move the already rendered pixels if possible, else redraw the whole object*/
+    if(!scroll_blit(obj, x, y)) lv_obj_invalidate(obj);
     return LV_RESULT_OK;
 }
 
@@ -788,3 +796,171 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en == LV_ANIM_OFF ? 0 : y_scroll;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+/**
+ * Move the already rendered pixels of a scrolled object and invalidate only the areas which were not moved.
+ * @param obj       pointer to the scrolled object
+ * @param dx        the children were moved by this many pixels horizontally
+ * @param dy        the children were moved by this many pixels vertically
+ * @return          true: the pixels will be moved; false: the object needs to be invalidated
+ */
+static bool scroll_blit(lv_obj_t * obj, int32_t dx, int32_t dy)
+{
+    lv_display_t * disp = lv_obj_get_display(obj);
+    if(!disp->scroll_blit_en || disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return false;
+    if(!scroll_blit_is_possible(obj)) return false;
+
+    /*The border is not moved with the content*/
+    lv_area_t area = obj->coords;
+    int32_t bw = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    if(bw > 0) lv_area_increase(&area, -bw, -bw);
+
+    /*Neither the scrollbars*/
+    lv_area_t hor_area;
+    lv_area_t ver_area;
+    lv_obj_get_scrollbar_area(obj, &hor_area, &ver_area);
+    if(lv_area_get_size(&ver_area) > 0) {
+        if(ver_area.x1 > (obj->coords.x1 + obj->coords.x2) / 2) area.x2 = LV_MIN(area.x2, ver_area.x1 - 1);
+        else area.x1 = LV_MAX(area.x1, ver_area.x2 + 1);
+    }
+    if(lv_area_get_size(&hor_area) > 0) area.y2 = LV_MIN(area.y2, hor_area.y1 - 1);
+
+    /*The visible area is rounded outwards by the transformation, so only truncate to it*/
+    lv_area_t vis_area = area;
+    if(!lv_obj_area_is_visible(obj, &vis_area)) return false;
+    if(!_lv_area_intersect(&area, &area, &vis_area)) return false;
+    if(!_lv_inv_area_scroll(disp, &area, dx, dy)) return false;
+
+    _lv_obj_invalidate_draw_list(obj, false);
+    _lv_obj_invalidate_layer_cache(obj, false);
+
+    /*Redraw the parts of the object which were not moved*/
+    lv_area_t parts[4];
+    int8_t part_cnt = _lv_area_diff(parts, &obj->coords, &area);
+    int8_t i;
+    for(i = 0; i < part_cnt; i++) {
+        lv_obj_invalidate_area(obj, &parts[i]);
+    }
+
+    return true;
+}
+
+/**
+ * Check if the pixels of an object come only from the object and its children
+ * and nothing else is drawn over it, so they can be moved when it's scrolled.
+ * @param obj       pointer to an object
+ * @return          true: the pixels can be moved
+ */
+static bool scroll_blit_is_possible(lv_obj_t * obj)
+{
+    lv_display_t * disp = lv_obj_get_display(obj);
+    if(disp->prev_scr || lv_obj_get_screen(obj) != disp->act_scr) return false;
+
+    /*Only a flat background covers the object*/
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) != LV_OPA_COVER) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_grad(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_radius(obj, LV_PART_MAIN) != 0) return false;
+    if(lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN) != LV_OPA_COVER) return false;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+
+    /*The drawing of the object can't be changed*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) return false;
+    if(has_draw_event_cb(obj, LV_EVENT_DRAW_MAIN_BEGIN)) return false;
+    const lv_obj_class_t * class_p = obj->class_p;
+    while(class_p && class_p != &lv_obj_class) {
+        if(class_p->event_cb) return false;
+        class_p = class_p->base_class;
+    }
+
+    /*The floating children don't move with the content*/
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = lv_obj_get_child(obj, i);
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING) && !lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) return false;
+    }
+
+    /*Nothing is drawn over the object by its parents, the later siblings or the layers above the screen*/
+    lv_obj_t * child = obj;
+    lv_obj_t * parent = obj;
+    while(parent) {
+        if(_lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+        if(parent != obj) {
+            if(lv_obj_has_flag(parent, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) return false;
+            if(has_draw_event_cb(parent, LV_EVENT_DRAW_POST_BEGIN)) return false;
+            /*The rounded corners are masked out after the children are drawn*/
+            if(lv_obj_get_style_clip_corner(parent, LV_PART_MAIN) &&
+               lv_obj_get_style_radius(parent, LV_PART_MAIN) != 0) return false;
+            if(lv_obj_get_style_border_post(parent, LV_PART_MAIN)) {
+                lv_area_t inner_area = parent->coords;
+                int32_t bw = lv_obj_get_style_border_width(parent, LV_PART_MAIN);
+                lv_area_increase(&inner_area, -bw, -bw);
+                if(!_lv_area_is_in(&obj->coords, &inner_area, 0)) return false;
+            }
+
+            lv_area_t hor_area;
+            lv_area_t ver_area;
+            lv_obj_get_scrollbar_area(parent, &hor_area, &ver_area);
+            if(lv_area_get_size(&hor_area) > 0 && _lv_area_is_on(&hor_area, &obj->coords)) return false;
+            if(lv_area_get_size(&ver_area) > 0 && _lv_area_is_on(&ver_area, &obj->coords)) return false;
+
+            if(is_drawn_over(parent, (uint32_t)lv_obj_get_index(child) + 1, &obj->coords)) return false;
+        }
+        child = parent;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    if(is_drawn_over(disp->top_layer, 0, &obj->coords)) return false;
+    if(is_drawn_over(disp->sys_layer, 0, &obj->coords)) return false;
+
+    return true;
+}
+
+/**
+ * Check if an object has an event callback for a drawing event
+ * @param obj           pointer to an object
+ * @param first_code    the first drawing event to check until `LV_EVENT_DRAW_POST_END`
+ * @return              true: there is a callback which might draw
+ */
+static bool has_draw_event_cb(lv_obj_t * obj, lv_event_code_t first_code)
+{
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_event_dsc_t * dsc = lv_obj_get_event_dsc(obj, i);
+        uint32_t code = dsc->filter & ~LV_EVENT_PREPROCESS;
+        if(code == LV_EVENT_ALL || (code >= first_code && code <= LV_EVENT_DRAW_POST_END)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Check if the children of an object from a given index draw on an area
+ * @param parent        pointer to an object (can be NULL)
+ * @param first_idx     index of the first child to check. For a layer it's 0 and its background is checked too.
+ * @param area          the area to check
+ * @return              true: something is drawn on the area
+ */
+static bool is_drawn_over(lv_obj_t * parent, uint32_t first_idx, const lv_area_t * area)
+{
+    if(parent == NULL) return false;
+    if(first_idx == 0 && lv_obj_get_style_bg_opa(parent, LV_PART_MAIN) > LV_OPA_TRANSP) return true;
+
+    uint32_t child_cnt = lv_obj_get_child_count(parent);
+    uint32_t i;
+    for(i = first_idx; i < child_cnt; i++) {
+        lv_obj_t * child = lv_obj_get_child(parent, i);
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        if(_lv_obj_get_layer_type(child) == LV_LAYER_TYPE_TRANSFORM) return true;
+
+        lv_area_t child_area = child->coords;
+        int32_t ext_size = _lv_obj_get_ext_draw_size(child);
+        lv_area_increase(&child_area, ext_size, ext_size);
+        if(_lv_area_is_on(&child_area, area)) return true;
+    }
+
+    return false;
+}
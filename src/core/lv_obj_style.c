@@ -275,8 +275,6 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 
     if(!style_refr) return;
 
-    lv_obj_invalidate(obj);
-
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
     bool is_layout_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYOUT_UPDATE);
@@ -284,6 +282,20 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
     bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYER_UPDATE);
 
+    /*If only the blending of the layer changes (e.g. fading or rotating) the rendered content remains the same*/
+    bool is_layer_blending = prop != LV_STYLE_PROP_ANY && part == LV_PART_MAIN && is_layer_refr && !is_inheritable;
+
+    if(is_layer_blending) {
+        _lv_obj_invalidate_layer_blending(obj);
+    }
+    else {
+        lv_obj_invalidate(obj);
+
+        /*The children's draw descriptors can depend on the parent's styles too (inherited properties, opa, etc)*/
+        _lv_obj_invalidate_draw_list(obj, true);
+        _lv_obj_invalidate_layer_cache(obj, true);
+    }
+
     if(is_layout_refr) {
         if(part == LV_PART_ANY ||
            part == LV_PART_MAIN ||
@@ -306,7 +318,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     if(prop == LV_STYLE_PROP_ANY || is_ext_draw) {
         lv_obj_refresh_ext_draw_size(obj);
     }
-    lv_obj_invalidate(obj);
+
+    if(is_layer_blending) _lv_obj_invalidate_layer_blending(obj);
+    else lv_obj_invalidate(obj);
 
     if(prop == LV_STYLE_PROP_ANY || (is_inheritable && (is_ext_draw || is_layout_refr))) {
         if(part != LV_PART_SCROLLBAR) {
@@ -352,7 +366,8 @@ void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_
 {
     lv_style_t * style = get_local_style(obj, selector);
     if(selector == LV_PART_MAIN && lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_TRANSFORM)) {
-        lv_obj_invalidate(obj);
+        if(lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYER_UPDATE)) _lv_obj_invalidate_layer_blending(obj);
+        else lv_obj_invalidate(obj);
     }
 
     lv_style_set_prop(style, prop, value);
@@ -15,6 +15,8 @@
 #include "../misc/lv_profiler.h"
 #include "../misc/lv_types.h"
 #include "../draw/lv_draw.h"
+#include "../draw/lv_draw_list.h"
+#include "../draw/lv_draw_layer_cache.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../stdlib/lv_string.h"
 #include "lv_global.h"
@@ -33,18 +35,45 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void lv_refr_join_area(void);
-static void refr_invalid_areas(void);
-static void refr_sync_areas(void);
-static void refr_area(const lv_area_t * area_p);
-static void refr_area_part(lv_layer_t * layer);
+static void lv_refr_join_area(lv_display_t * disp);
+static void inv_area_add(lv_area_t * areas, uint32_t * cnt, const lv_area_t * area_p);
+static void inv_area_join_cheapest(lv_area_t * areas, uint32_t * cnt, const lv_area_t * area_p);
+static int32_t get_join_cost(const lv_area_t * a1, const lv_area_t * a2);
+static void refr_invalid_areas(lv_display_t * disp);
+static void refr_sync_areas(lv_display_t * disp);
+static void buf_damage_add(lv_display_t * disp, const lv_draw_buf_t * buf_rendered);
+static void buf_damage_add_area(lv_display_buf_damage_t * damage, const lv_area_t * area_p);
+static void buf_damage_remove(lv_display_buf_damage_t * damage, const lv_area_t * area_p);
+static uint32_t get_buf_idx(lv_display_t * disp, const lv_draw_buf_t * buf);
+static bool scroll_blit_get_valid_area(const lv_display_scroll_blit_t * blit, lv_area_t * valid_area);
+static void refr_scroll_blits(lv_display_t * disp);
+static void flush_scroll_blit(lv_display_t * disp, const lv_display_scroll_blit_t * blit);
+static void refr_area(lv_display_t * disp, const lv_area_t * area_p);
+static void refr_area_part(lv_display_t * disp, lv_layer_t * layer);
+static void refr_layer_objs(lv_layer_t * layer);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
+static lv_result_t refr_obj_cached_layer(lv_layer_t * layer, lv_obj_t * obj, lv_layer_type_t layer_type,
+                                         const lv_area_t * obj_draw_size);
+static bool layer_buf_is_rendering(lv_display_t * disp, const lv_draw_buf_t * draw_buf);
+static void layer_draw_dsc_init(lv_draw_image_dsc_t * dsc, lv_obj_t * obj, lv_layer_t * obj_layer,
+                                const lv_area_t * obj_draw_size, lv_opa_t opa);
+#if LV_USE_DRAW_LIST
+    static void refr_obj_main_retained(lv_layer_t * layer, lv_obj_t * obj, bool fully_visible);
+#endif
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
+static int32_t round_max_row(lv_display_t * disp, int32_t max_row);
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
-static void wait_for_flushing(lv_display_t * disp);
+static void wait_for_flushing(lv_display_t * disp, uint32_t max_pending);
+static uint32_t get_flush_pending_cnt(lv_display_t * disp);
+static void wait_for_buf_act_free(lv_display_t * disp);
+static bool frame_sched_start(lv_display_t * disp, lv_timer_t * tmr);
+static void frame_sched_finish(lv_display_t * disp, uint32_t start_tick, bool rendered);
+static bool frame_sched_is_active(lv_display_t * disp);
+static void frame_sched_take_vsync(lv_display_t * disp);
+static void frame_sched_stop_waiting(lv_display_t * disp, lv_timer_t * tmr);
 
 /**********************
  *  STATIC VARIABLES
@@ -68,10 +97,12 @@ static void wait_for_flushing(lv_display_t * disp);
  */
 void _lv_refr_init(void)
 {
+    lv_draw_layer_cache_init(LV_DRAW_LAYER_CACHE_DEF_SIZE);
 }
 
 void _lv_refr_deinit(void)
 {
+    lv_draw_layer_cache_deinit();
 }
 
 void lv_refr_now(lv_display_t * disp)
@@ -93,6 +124,9 @@ void lv_refr_now(lv_display_t * disp)
 
 void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
 {
+    /*E.g. a layer of a canvas: render for the display of the object*/
+    if(layer->disp == NULL) layer->disp = lv_obj_get_display(obj);
+
     lv_area_t clip_area_ori = layer->_clip_area;
     lv_area_t clip_coords_for_obj;
 
@@ -106,9 +140,13 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
     /*If the object is visible on the current clip area*/
     layer->_clip_area = clip_coords_for_obj;
 
+#if LV_USE_DRAW_LIST
+    refr_obj_main_retained(layer, obj, _lv_area_is_equal(&clip_coords_for_obj, &obj_coords_ext));
+#else
     lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
     lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
     lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+#endif
 #if LV_USE_REFR_DEBUG
     lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
     lv_draw_rect_dsc_t draw_dsc;
@@ -259,6 +297,7 @@ void _lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+        disp->scroll_blit_cnt = 0;
         return;
     }
 
@@ -291,16 +330,94 @@ void _lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
         if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
 
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    /*Save the area. If there is no place for it join the areas which cost the least to join*/
+    if(disp->inv_p < LV_INV_BUF_SIZE) inv_area_add(disp->inv_areas, &disp->inv_p, &com_area);
+    else inv_area_join_cheapest(disp->inv_areas, &disp->inv_p, &com_area);
+
+    lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+}
+
+bool _lv_inv_area_scroll(lv_display_t * disp, const lv_area_t * area_p, int32_t dx, int32_t dy)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return false;
+    if(!disp->scroll_blit_en || disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return false;
+    if(!lv_display_is_invalidation_enabled(disp) || disp->rendering_in_progress) return false;
+
+    /*The pixels can't be moved if the buffer is rotated or they are not byte aligned*/
+    if(disp->rotation != LV_DISPLAY_ROTATION_0) return false;
+    if(lv_color_format_get_bpp(disp->color_format) < 8) return false;
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_display_get_horizontal_resolution(disp) - 1;
+    scr_area.y2 = lv_display_get_vertical_resolution(disp) - 1;
+
+    lv_area_t area;
+    if(!_lv_area_intersect(&area, area_p, &scr_area)) return false;
+
+    /*If the area is changed (e.g. rounded) by the driver the exact area can't be moved*/
+    lv_area_t area_tmp = area;
+    lv_result_t res = lv_display_send_event(disp, LV_EVENT_INVALIDATE_AREA, &area_tmp);
+    if(res != LV_RESULT_OK || !_lv_area_is_equal(&area, &area_tmp)) return false;
+
+    /*No need to move the pixels if the whole area will be rendered anyway*/
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(_lv_area_is_in(&area, &disp->inv_areas[i], 0)) return false;
+    }
+
+    /*Scrolling the same area again moves the pixels once by the sum of the scrolls.
+     *Scrolling other areas (e.g. a parent) keeps the order of the moves.*/
+    lv_display_scroll_blit_t * blit = NULL;
+    if(disp->scroll_blit_cnt > 0) {
+        blit = &disp->scroll_blits[disp->scroll_blit_cnt - 1];
+        if(!_lv_area_is_equal(&blit->area, &area)) blit = NULL;
+    }
+
+    if(blit == NULL) {
+        if(disp->scroll_blit_cnt >= LV_DISPLAY_SCROLL_BLIT_MAX) return false;
+        blit = &disp->scroll_blits[disp->scroll_blit_cnt];
+        blit->area = area;
+        blit->dx = 0;
+        blit->dy = 0;
+        disp->scroll_blit_cnt++;
+    }
+
+    blit->dx += dx;
+    blit->dy += dy;
+
+    /*Nothing remains visible from the moved pixels*/
+    lv_area_t valid_area;
+    if(!scroll_blit_get_valid_area(blit, &valid_area)) {
+        disp->scroll_blit_cnt--;
+        return false;
+    }
+
+    /*The outdated pixels of the invalid areas are moved too, so invalidate them where they are moved*/
+    lv_area_t inv_areas[LV_INV_BUF_SIZE];
+    uint32_t inv_cnt = disp->inv_p;
+    lv_memcpy(inv_areas, disp->inv_areas, inv_cnt * sizeof(lv_area_t));
+    for(i = 0; i < inv_cnt; i++) {
+        lv_area_t moved_area;
+        if(!_lv_area_intersect(&moved_area, &inv_areas[i], &area)) continue;
+        lv_area_move(&moved_area, dx, dy);
+        if(!_lv_area_intersect(&moved_area, &moved_area, &area)) continue;
+        _lv_inv_area(disp, &moved_area);
+    }
+
+    /*Invalidate the parts which become visible*/
+    lv_area_t new_areas[4];
+    int8_t new_cnt = _lv_area_diff(new_areas, &area, &valid_area);
+    int8_t j;
+    for(j = 0; j < new_cnt; j++) {
+        _lv_inv_area(disp, &new_areas[j]);
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
-    disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+
+    return true;
 }
 
 /**
@@ -326,8 +443,20 @@ void _lv_display_refr_timer(lv_timer_t * tmr)
     LV_PROFILER_BEGIN;
     LV_TRACE_REFR("begin");
 
+    uint32_t start_tick = lv_tick_get();
+    bool rendered = false;
+
+    lv_display_t * disp;
     if(tmr) {
-        disp_refr = tmr->user_data;
+        disp = tmr->user_data;
+
+        /*Wait if it's too early to start the frame for the next vsync*/
+        if(frame_sched_start(disp, tmr)) {
+            LV_TRACE_REFR("waiting for the vsync");
+            LV_PROFILER_END;
+            return;
+        }
+
         /* Ensure the timer does not run again automatically.
          * This is done before refreshing in case refreshing invalidates something else.
          * However if the performance monitor is enabled keep the timer running to count the FPS.*/
@@ -336,76 +465,76 @@ void _lv_display_refr_timer(lv_timer_t * tmr)
 #endif
     }
     else {
-        disp_refr = lv_display_get_default();
+        disp = lv_display_get_default();
     }
 
-    if(disp_refr == NULL) {
+    if(disp == NULL) {
         LV_LOG_WARN("No display registered");
         return;
     }
 
-    lv_draw_buf_t * buf_act = disp_refr->buf_act;
+    /*Only for external code (e.g. custom draw units) which asks for the refreshed display.
+     *LVGL passes `disp` to the refr_* functions and draws with the display of the layers.*/
+    disp_refr = disp;
+
+    lv_draw_buf_t * buf_act = disp->buf_act;
     if(!(buf_act && buf_act->data && buf_act->data_size)) {
         LV_LOG_WARN("No draw buffer");
         return;
     }
 
-    lv_display_send_event(disp_refr, LV_EVENT_REFR_START, NULL);
+    lv_display_send_event(disp, LV_EVENT_REFR_START, NULL);
 
     /*Refresh the screen's layout if required*/
     LV_PROFILER_BEGIN_TAG("layout");
-    lv_obj_update_layout(disp_refr->act_scr);
-    if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
+    lv_obj_update_layout(disp->act_scr);
+    if(disp->prev_scr) lv_obj_update_layout(disp->prev_scr);
 
-    lv_obj_update_layout(disp_refr->bottom_layer);
-    lv_obj_update_layout(disp_refr->top_layer);
-    lv_obj_update_layout(disp_refr->sys_layer);
+    lv_obj_update_layout(disp->bottom_layer);
+    lv_obj_update_layout(disp->top_layer);
+    lv_obj_update_layout(disp->sys_layer);
     LV_PROFILER_END_TAG("layout");
 
     /*Do nothing if there is no active screen*/
-    if(disp_refr->act_scr == NULL) {
-        disp_refr->inv_p = 0;
+    if(disp->act_scr == NULL) {
+        disp->inv_p = 0;
+        disp->scroll_blit_cnt = 0;
         LV_LOG_WARN("there is no active screen");
         goto refr_finish;
     }
 
-    lv_refr_join_area();
-    refr_sync_areas();
-    refr_invalid_areas();
+    lv_refr_join_area(disp);
+    refr_sync_areas(disp);
+    refr_scroll_blits(disp);
+    refr_invalid_areas(disp);
 
-    if(disp_refr->inv_p == 0) goto refr_finish;
+    if(disp->inv_p == 0 && disp->scroll_blit_cnt == 0) goto refr_finish;
 
     /*If refresh happened ...*/
-    lv_display_send_event(disp_refr, LV_EVENT_RENDER_READY, NULL);
-
-    if(!lv_display_is_double_buffered(disp_refr) ||
-       disp_refr->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) goto refr_clean_up;
+    rendered = true;
+    lv_display_send_event(disp, LV_EVENT_RENDER_READY, NULL);
 
-    /*With double buffered direct mode synchronize the rendered areas to the other buffer*/
-    /*We need to wait for ready here to not mess up the active screen*/
-    wait_for_flushing(disp_refr);
+    if(!lv_display_is_double_buffered(disp) ||
+       disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) goto refr_clean_up;
 
-    uint32_t i;
-    for(i = 0; i < disp_refr->inv_p; i++) {
-        if(disp_refr->inv_area_joined[i])
-            continue;
+    /*With double buffered direct mode synchronize the rendered areas to the other buffers later*/
+    /*Wait for ready here to not mess up the active screen*/
+    wait_for_buf_act_free(disp);
 
-        lv_area_t * sync_area = _lv_ll_ins_tail(&disp_refr->sync_areas);
-        *sync_area = disp_refr->inv_areas[i];
-    }
+    /*`buf_act` is the buffer which was rendered (before swapping the buffers)*/
+    buf_damage_add(disp, buf_act);
 
 refr_clean_up:
-    lv_memzero(disp_refr->inv_areas, sizeof(disp_refr->inv_areas));
-    lv_memzero(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
-    disp_refr->inv_p = 0;
+    lv_memzero(disp->inv_areas, sizeof(disp->inv_areas));
+    lv_memzero(disp->inv_area_joined, sizeof(disp->inv_area_joined));
+    disp->inv_p = 0;
+    disp->scroll_blit_cnt = 0;
 
 refr_finish:
 
-#if LV_DRAW_SW_COMPLEX == 1
-    _lv_draw_sw_mask_cleanup();
-#endif
+    frame_sched_finish(disp, start_tick, rendered);
 
-    lv_display_send_event(disp_refr, LV_EVENT_REFR_READY, NULL);
+    lv_display_send_event(disp, LV_EVENT_REFR_READY, NULL);
 
     LV_TRACE_REFR("finished");
     LV_PROFILER_END;
@@ -418,156 +547,378 @@ refr_finish:
 /**
  * Join the areas which has got common parts
  */
-static void lv_refr_join_area(void)
+static void lv_refr_join_area(lv_display_t * disp)
 {
     LV_PROFILER_BEGIN;
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
+    for(join_in = 0; join_in < disp->inv_p; join_in++) {
+        if(disp->inv_area_joined[join_in] != 0) continue;
 
         /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
+        for(join_from = 0; join_from < disp->inv_p; join_from++) {
             /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
+            if(disp->inv_area_joined[join_from] != 0 || join_in == join_from) {
                 continue;
             }
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+            /*Join two area only if refreshing the joined area is cheaper*/
+            if(get_join_cost(&disp->inv_areas[join_in], &disp->inv_areas[join_from]) < 0) {
+                _lv_area_join(&joined_area, &disp->inv_areas[join_in], &disp->inv_areas[join_from]);
+                lv_area_copy(&disp->inv_areas[join_in], &joined_area);
+
+                /*Mark 'join_form' is joined into 'join_in'*/
+                disp->inv_area_joined[join_from] = 1;
             }
+        }
+    }
+    LV_PROFILER_END;
+}
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+/**
+ * Save a new area and remove the saved areas which are covered by it.
+ * There must be place for the new area.
+ * @param areas     array of `LV_INV_BUF_SIZE` areas, e.g. the invalid areas of a display
+ * @param cnt       pointer to the number of saved areas. Updated by this function.
+ * @param area_p    the new area
+ */
+static void inv_area_add(lv_area_t * areas, uint32_t * cnt, const lv_area_t * area_p)
+{
+    uint32_t new_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < *cnt; i++) {
+        if(_lv_area_is_in(&areas[i], area_p, 0)) continue;
+        areas[new_cnt] = areas[i];
+        new_cnt++;
+    }
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+    areas[new_cnt] = *area_p;
+    *cnt = new_cnt + 1;
+}
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+/**
+ * Make place for a new area by joining the two areas (including the new one)
+ * which cost the least to be refreshed together.
+ * It's used instead of invalidating the whole screen when there is no place for more areas.
+ * @param areas     array of `LV_INV_BUF_SIZE` areas, e.g. the invalid areas of a display
+ * @param cnt       pointer to the number of saved areas. Updated by this function.
+ * @param area_p    the new area
+ */
+static void inv_area_join_cheapest(lv_area_t * areas, uint32_t * cnt, const lv_area_t * area_p)
+{
+    LV_PROFILER_BEGIN;
+    uint32_t old_cnt = *cnt;
+
+    /*The index `old_cnt` refers to the new area*/
+    uint32_t best_i = 0;
+    uint32_t best_j = old_cnt;
+    int32_t best_cost = INT32_MAX;
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < old_cnt; i++) {
+        for(j = i + 1; j <= old_cnt; j++) {
+            int32_t cost = get_join_cost(&areas[i], j < old_cnt ? &areas[j] : area_p);
+            if(cost < best_cost) {
+                best_cost = cost;
+                best_i = i;
+                best_j = j;
             }
         }
     }
+
+    lv_area_t joined_area;
+    _lv_area_join(&joined_area, &areas[best_i], best_j < old_cnt ? &areas[best_j] : area_p);
+    areas[best_i] = joined_area;
+    if(best_j < old_cnt) areas[best_j] = *area_p;
+
+    /*The joined area might cover other areas too*/
+    uint32_t new_cnt = 0;
+    for(i = 0; i < old_cnt; i++) {
+        if(i != best_i && _lv_area_is_in(&areas[i], &joined_area, 0)) continue;
+        areas[new_cnt] = areas[i];
+        new_cnt++;
+    }
+    *cnt = new_cnt;
     LV_PROFILER_END;
 }
 
 /**
- * Refresh the sync areas
+ * Get how much more it costs to refresh two areas together than separately.
+ * The cost is the number of refreshed pixels plus `LV_INV_AREA_COST` per area.
+ * @param a1        pointer to an area
+ * @param a2        pointer to an other area
+ * @return          <0: it's cheaper to refresh the areas together; >=0: it's not worth joining them
+ */
+static int32_t get_join_cost(const lv_area_t * a1, const lv_area_t * a2)
+{
+    lv_area_t joined_area;
+    _lv_area_join(&joined_area, a1, a2);
+
+    return (int32_t)lv_area_get_size(&joined_area) - (int32_t)lv_area_get_size(a1) - (int32_t)lv_area_get_size(a2) -
+           LV_INV_AREA_COST;
+}
+
+/**
+ * In direct mode with more buffers bring the active buffer up to date before rendering into it.
+ * The areas which were rendered only into the other buffers since the active buffer was rendered
+ * are copied from the most recently rendered buffer, except the areas which will be rendered anyway.
  */
-static void refr_sync_areas(void)
+static void refr_sync_areas(lv_display_t * disp)
 {
     /*Do not sync if not direct or double buffered*/
-    if(disp_refr->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return;
+    if(disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return;
 
     /*Do not sync if not double buffered*/
-    if(!lv_display_is_double_buffered(disp_refr)) return;
+    if(!lv_display_is_double_buffered(disp)) return;
+
+    /*Do not sync if nothing was rendered yet*/
+    if(disp->buf_damage == NULL) return;
+
+    uint32_t buf_cnt = lv_display_get_draw_buffer_count(disp);
+    uint32_t act_idx = get_buf_idx(disp, disp->buf_act);
+    lv_display_buf_damage_t * damage = &disp->buf_damage[act_idx];
 
     /*Do not sync if no sync areas*/
-    if(_lv_ll_is_empty(&disp_refr->sync_areas)) return;
+    if(damage->cnt == 0) return;
 
     LV_PROFILER_BEGIN;
-    /*With double buffered direct mode synchronize the rendered areas to the other buffer*/
-    /*We need to wait for ready here to not mess up the active screen*/
-    wait_for_flushing(disp_refr);
+    /*The active buffer can be still on the screen or being flushed*/
+    wait_for_buf_act_free(disp);
 
     /*The buffers are already swapped.
      *So the active buffer is the off screen buffer where LVGL will render*/
-    lv_draw_buf_t * off_screen = disp_refr->buf_act;
-    lv_draw_buf_t * on_screen = disp_refr->buf_act == disp_refr->buf_1 ? disp_refr->buf_2 : disp_refr->buf_1;
-
-    uint32_t hor_res = lv_display_get_horizontal_resolution(disp_refr);
-    uint32_t ver_res = lv_display_get_vertical_resolution(disp_refr);
+    lv_draw_buf_t * off_screen = disp->buf_act;
+    lv_draw_buf_t * on_screen = lv_display_get_draw_buffer(disp, (act_idx + buf_cnt - 1) % buf_cnt);
 
-    /*Iterate through invalidated areas to see if sync area should be copied*/
-    uint16_t i;
-    int8_t j;
-    lv_area_t res[4] = {0};
-    int8_t res_c;
-    lv_area_t * sync_area, * new_area, * next_area;
-    for(i = 0; i < disp_refr->inv_p; i++) {
+    /*No need to copy the areas which will be rendered anyway,
+     *unless their pixels are moved to an other place by scrolling*/
+    uint32_t i;
+    for(i = 0; i < disp->inv_p && disp->scroll_blit_cnt == 0; i++) {
         /*Skip joined areas*/
-        if(disp_refr->inv_area_joined[i]) continue;
-
-        /*Iterate over sync areas*/
-        sync_area = _lv_ll_get_head(&disp_refr->sync_areas);
-        while(sync_area != NULL) {
-            /*Get next sync area*/
-            next_area = _lv_ll_get_next(&disp_refr->sync_areas, sync_area);
-
-            /*Remove intersect of redraw area from sync area and get remaining areas*/
-            res_c = _lv_area_diff(res, sync_area, &disp_refr->inv_areas[i]);
-
-            /*New sub areas created after removing intersect*/
-            if(res_c != -1) {
-                /*Replace old sync area with new areas*/
-                for(j = 0; j < res_c; j++) {
-                    new_area = _lv_ll_ins_prev(&disp_refr->sync_areas, sync_area);
-                    *new_area = res[j];
-                }
-                _lv_ll_remove(&disp_refr->sync_areas, sync_area);
-                lv_free(sync_area);
-            }
+        if(disp->inv_area_joined[i]) continue;
 
-            /*Move on to next sync area*/
-            sync_area = next_area;
-        }
+        buf_damage_remove(damage, &disp->inv_areas[i]);
     }
 
+    uint32_t hor_res = lv_display_get_horizontal_resolution(disp);
+    uint32_t ver_res = lv_display_get_vertical_resolution(disp);
     lv_area_t disp_area = {0, 0, (int32_t)hor_res - 1, (int32_t)ver_res - 1};
-    /*Copy sync areas (if any remaining)*/
-    for(sync_area = _lv_ll_get_head(&disp_refr->sync_areas); sync_area != NULL;
-        sync_area = _lv_ll_get_next(&disp_refr->sync_areas, sync_area)) {
-        /**
-         * @todo Resize SDL window will trigger crash because of sync_area is larger than disp_area
-         */
-        _lv_area_intersect(sync_area, sync_area, &disp_area);
-        lv_draw_buf_copy(off_screen, sync_area, on_screen, sync_area);
-    }
-
-    /*Clear sync areas*/
-    _lv_ll_clear(&disp_refr->sync_areas);
+    for(i = 0; i < damage->cnt; i++) {
+        lv_area_t sync_area;
+        if(!_lv_area_intersect(&sync_area, &damage->areas[i], &disp_area)) continue;
+        lv_draw_buf_copy(off_screen, &sync_area, on_screen, &sync_area);
+    }
+
+    damage->cnt = 0;
     LV_PROFILER_END;
 }
 
 /**
- * Refresh the joined areas
+ * Save the rendered areas as the damage of the other draw buffers
+ * @param buf_rendered  the draw buffer into which the invalid areas were rendered
+ */
+static void buf_damage_add(lv_display_t * disp, const lv_draw_buf_t * buf_rendered)
+{
+    uint32_t buf_cnt = lv_display_get_draw_buffer_count(disp);
+    if(disp->buf_damage == NULL) {
+        disp->buf_damage = lv_malloc_zeroed(buf_cnt * sizeof(lv_display_buf_damage_t));
+        LV_ASSERT_MALLOC(disp->buf_damage);
+        if(disp->buf_damage == NULL) return;
+    }
+
+    uint32_t b;
+    for(b = 0; b < buf_cnt; b++) {
+        if(lv_display_get_draw_buffer(disp, b) == buf_rendered) continue;
+
+        lv_display_buf_damage_t * damage = &disp->buf_damage[b];
+        uint32_t i;
+        for(i = 0; i < disp->inv_p; i++) {
+            if(disp->inv_area_joined[i]) continue;
+            buf_damage_add_area(damage, &disp->inv_areas[i]);
+        }
+
+        /*The moved pixels are changed too*/
+        for(i = 0; i < disp->scroll_blit_cnt; i++) {
+            buf_damage_add_area(damage, &disp->scroll_blits[i].area);
+        }
+    }
+}
+
+/**
+ * Add an area to the damage of a draw buffer
+ * @param damage    pointer to the damage of a draw buffer
+ * @param area_p    the changed area
+ */
+static void buf_damage_add_area(lv_display_buf_damage_t * damage, const lv_area_t * area_p)
+{
+    uint32_t i;
+    for(i = 0; i < damage->cnt; i++) {
+        if(_lv_area_is_in(area_p, &damage->areas[i], 0)) return;
+    }
+
+    if(damage->cnt < LV_INV_BUF_SIZE) inv_area_add(damage->areas, &damage->cnt, area_p);
+    else inv_area_join_cheapest(damage->areas, &damage->cnt, area_p);
+}
+
+/**
+ * Remove an area from the damage of a draw buffer.
+ * If there is no place for the remaining parts of a damaged area it's kept as it is.
+ * @param damage    pointer to the damage of a draw buffer
+ * @param area_p    the area to remove
  */
-static void refr_invalid_areas(void)
+static void buf_damage_remove(lv_display_buf_damage_t * damage, const lv_area_t * area_p)
 {
-    if(disp_refr->inv_p == 0) return;
+    lv_area_t new_areas[LV_INV_BUF_SIZE];
+    uint32_t new_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < damage->cnt; i++) {
+        lv_area_t res[4];
+        int8_t res_c = _lv_area_diff(res, &damage->areas[i], area_p);
+
+        /*Keep the whole area if not affected or if there is no place for the parts of it*/
+        uint32_t remaining_cnt = damage->cnt - i - 1;
+        if(res_c < 0 || new_cnt + res_c + remaining_cnt > LV_INV_BUF_SIZE) {
+            res[0] = damage->areas[i];
+            res_c = 1;
+        }
+
+        int8_t j;
+        for(j = 0; j < res_c; j++) {
+            new_areas[new_cnt] = res[j];
+            new_cnt++;
+        }
+    }
+
+    lv_memcpy(damage->areas, new_areas, new_cnt * sizeof(lv_area_t));
+    damage->cnt = new_cnt;
+}
+
+/**
+ * Get the index of a draw buffer of a display
+ * @param disp      pointer to a display
+ * @param buf       pointer to one of the draw buffers of the display
+ * @return          the index of the draw buffer
+ */
+static uint32_t get_buf_idx(lv_display_t * disp, const lv_draw_buf_t * buf)
+{
+    uint32_t buf_cnt = lv_display_get_draw_buffer_count(disp);
+    uint32_t i;
+    for(i = 0; i < buf_cnt; i++) {
+        if(lv_display_get_draw_buffer(disp, i) == buf) return i;
+    }
+
+    return 0;
+}
+
+/**
+ * Get the area of a scrolled area where the moved pixels remain visible
+ * @param blit          pointer to a scrolled area
+ * @param valid_area    store the result here
+ * @return              true: some moved pixels are visible; false: nothing remained from the moved pixels
+ */
+static bool scroll_blit_get_valid_area(const lv_display_scroll_blit_t * blit, lv_area_t * valid_area)
+{
+    lv_area_t moved_area = blit->area;
+    lv_area_move(&moved_area, blit->dx, blit->dy);
+    return _lv_area_intersect(valid_area, &blit->area, &moved_area);
+}
+
+/**
+ * Move the pixels of the scrolled areas in the draw buffer before rendering the invalid areas
+ */
+static void refr_scroll_blits(lv_display_t * disp)
+{
+    if(disp->scroll_blit_cnt == 0) return;
+
+    /*The render mode could be changed since scrolling*/
+    if(disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) {
+        disp->scroll_blit_cnt = 0;
+        return;
+    }
+
     LV_PROFILER_BEGIN;
+    /*The active buffer can be still on the screen or being flushed*/
+    wait_for_buf_act_free(disp);
+
+    lv_draw_buf_t * buf_act = disp->buf_act;
+    uint32_t i;
+    for(i = 0; i < disp->scroll_blit_cnt; i++) {
+        const lv_display_scroll_blit_t * blit = &disp->scroll_blits[i];
+        lv_area_t valid_area;
+        if(!scroll_blit_get_valid_area(blit, &valid_area)) continue;
+
+        lv_area_t src_area = valid_area;
+        lv_area_move(&src_area, -blit->dx, -blit->dy);
+        lv_draw_buf_copy(buf_act, &valid_area, buf_act, &src_area);
+    }
+    LV_PROFILER_END;
+}
+
+/**
+ * Flush the moved pixels of a scrolled area
+ * @param blit      pointer to a scrolled area
+ */
+static void flush_scroll_blit(lv_display_t * disp, const lv_display_scroll_blit_t * blit)
+{
+    lv_area_t valid_area;
+    if(!scroll_blit_get_valid_area(blit, &valid_area)) return;
 
-    /*Find the last area which will be drawn*/
+    lv_layer_t * layer = disp->layer_head;
+    layer->draw_buf = disp->buf_act;
+    disp->refreshed_area = valid_area;
+    disp->last_part = disp->last_area;
+
+    if(!lv_display_is_double_buffered(disp)) {
+        wait_for_flushing(disp, 0);
+    }
+
+    draw_buf_flush(disp);
+}
+
+/**
+ * Refresh the joined areas and flush the moved pixels of the scrolled areas
+ */
+static void refr_invalid_areas(lv_display_t * disp)
+{
+    uint32_t blit_cnt = disp->scroll_blit_cnt;
+    if(disp->inv_p == 0 && blit_cnt == 0) return;
+    LV_PROFILER_BEGIN;
+
+    /*Find the last area which will be drawn. The scrolled areas are flushed after the rendered ones.*/
     int32_t i;
-    int32_t last_i = 0;
-    for(i = disp_refr->inv_p - 1; i >= 0; i--) {
-        if(disp_refr->inv_area_joined[i] == 0) {
+    int32_t last_i = blit_cnt ? -1 : 0;
+    for(i = disp->inv_p - 1; i >= 0 && blit_cnt == 0; i--) {
+        if(disp->inv_area_joined[i] == 0) {
             last_i = i;
             break;
         }
     }
 
     /*Notify the display driven rendering has started*/
-    lv_display_send_event(disp_refr, LV_EVENT_RENDER_START, NULL);
+    lv_display_send_event(disp, LV_EVENT_RENDER_START, NULL);
 
-    disp_refr->last_area = 0;
-    disp_refr->last_part = 0;
-    disp_refr->rendering_in_progress = true;
+    disp->last_area = 0;
+    disp->last_part = 0;
+    disp->rendering_in_progress = true;
 
-    for(i = 0; i < (int32_t)disp_refr->inv_p; i++) {
+    for(i = 0; i < (int32_t)disp->inv_p; i++) {
         /*Refresh the unjoined areas*/
-        if(disp_refr->inv_area_joined[i] == 0) {
+        if(disp->inv_area_joined[i] == 0) {
 
-            if(i == last_i) disp_refr->last_area = 1;
-            disp_refr->last_part = 0;
-            refr_area(&disp_refr->inv_areas[i]);
+            if(i == last_i) disp->last_area = 1;
+            disp->last_part = 0;
+            refr_area(disp, &disp->inv_areas[i]);
         }
     }
 
-    disp_refr->rendering_in_progress = false;
+    uint32_t b;
+    for(b = 0; b < blit_cnt; b++) {
+        if(b == blit_cnt - 1) disp->last_area = 1;
+        flush_scroll_blit(disp, &disp->scroll_blits[b]);
+    }
+
+    disp->rendering_in_progress = false;
     LV_PROFILER_END;
 }
 
@@ -590,33 +941,34 @@ static void layer_reshape_draw_buf(lv_layer_t * layer)
  * Refresh an area if there is Virtual Display Buffer
  * @param area_p  pointer to an area to refresh
  */
-static void refr_area(const lv_area_t * area_p)
+static void refr_area(lv_display_t * disp, const lv_area_t * area_p)
 {
     LV_PROFILER_BEGIN;
-    lv_layer_t * layer = disp_refr->layer_head;
-    layer->draw_buf = disp_refr->buf_act;
+    lv_layer_t * layer = disp->layer_head;
+    layer->draw_buf = disp->buf_act;
+    disp->strip_stat.area_cnt++;
 
     /*With full refresh just redraw directly into the buffer*/
     /*In direct mode draw directly on the absolute coordinates of the buffer*/
-    if(disp_refr->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+    if(disp->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
         layer->buf_area.x1 = 0;
         layer->buf_area.y1 = 0;
-        layer->buf_area.x2 = lv_display_get_horizontal_resolution(disp_refr) - 1;
-        layer->buf_area.y2 = lv_display_get_vertical_resolution(disp_refr) - 1;
+        layer->buf_area.x2 = lv_display_get_horizontal_resolution(disp) - 1;
+        layer->buf_area.y2 = lv_display_get_vertical_resolution(disp) - 1;
         layer_reshape_draw_buf(layer);
         lv_area_t disp_area;
-        lv_area_set(&disp_area, 0, 0, lv_display_get_horizontal_resolution(disp_refr) - 1,
-                    lv_display_get_vertical_resolution(disp_refr) - 1);
+        lv_area_set(&disp_area, 0, 0, lv_display_get_horizontal_resolution(disp) - 1,
+                    lv_display_get_vertical_resolution(disp) - 1);
 
-        if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_FULL) {
-            disp_refr->last_part = 1;
+        if(disp->render_mode == LV_DISPLAY_RENDER_MODE_FULL) {
+            disp->last_part = 1;
             layer->_clip_area = disp_area;
-            refr_area_part(layer);
+            refr_area_part(disp, layer);
         }
-        else if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
-            disp_refr->last_part = disp_refr->last_area;
+        else if(disp->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
+            disp->last_part = disp->last_area;
             layer->_clip_area = *area_p;
-            refr_area_part(layer);
+            refr_area_part(disp, layer);
         }
         LV_PROFILER_END;
         return;
@@ -626,10 +978,10 @@ static void refr_area(const lv_area_t * area_p)
     /*Calculate the max row num*/
     int32_t w = lv_area_get_width(area_p);
     int32_t h = lv_area_get_height(area_p);
-    int32_t y2 = area_p->y2 >= lv_display_get_vertical_resolution(disp_refr) ?
-                 lv_display_get_vertical_resolution(disp_refr) - 1 : area_p->y2;
+    int32_t y2 = area_p->y2 >= lv_display_get_vertical_resolution(disp) ?
+                 lv_display_get_vertical_resolution(disp) - 1 : area_p->y2;
 
-    int32_t max_row = get_max_row(disp_refr, w, h);
+    int32_t max_row = get_max_row(disp, w, h);
 
     int32_t row;
     int32_t row_last = 0;
@@ -640,14 +992,14 @@ static void refr_area(const lv_area_t * area_p)
         sub_area.x2 = area_p->x2;
         sub_area.y1 = row;
         sub_area.y2 = row + max_row - 1;
-        layer->draw_buf = disp_refr->buf_act;
+        layer->draw_buf = disp->buf_act;
         layer->buf_area = sub_area;
         layer->_clip_area = sub_area;
         layer_reshape_draw_buf(layer);
         if(sub_area.y2 > y2) sub_area.y2 = y2;
         row_last = sub_area.y2;
-        if(y2 == row_last) disp_refr->last_part = 1;
-        refr_area_part(layer);
+        if(y2 == row_last) disp->last_part = 1;
+        refr_area_part(disp, layer);
     }
 
     /*If the last y coordinates are not handled yet ...*/
@@ -657,79 +1009,149 @@ static void refr_area(const lv_area_t * area_p)
         sub_area.x2 = area_p->x2;
         sub_area.y1 = row;
         sub_area.y2 = y2;
-        layer->draw_buf = disp_refr->buf_act;
+        layer->draw_buf = disp->buf_act;
         layer->buf_area = sub_area;
         layer->_clip_area = sub_area;
         layer_reshape_draw_buf(layer);
-        disp_refr->last_part = 1;
-        refr_area_part(layer);
+        disp->last_part = 1;
+        refr_area_part(disp, layer);
     }
     LV_PROFILER_END;
 }
 
-static void refr_area_part(lv_layer_t * layer)
+static void refr_area_part(lv_display_t * disp, lv_layer_t * layer)
 {
     LV_PROFILER_BEGIN;
-    disp_refr->refreshed_area = layer->_clip_area;
+    disp->refreshed_area = layer->_clip_area;
 
     /* In single buffered mode wait here until the buffer is freed.
      * Else we would draw into the buffer while it's still being transferred to the display*/
-    if(!lv_display_is_double_buffered(disp_refr)) {
-        wait_for_flushing(disp_refr);
+    if(!lv_display_is_double_buffered(disp)) {
+        wait_for_flushing(disp, 0);
+    }
+    /* In direct mode the active buffer can be still shown or flushed if there are more buffers*/
+    else if(disp->render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
+        wait_for_buf_act_free(disp);
     }
     /*If the screen is transparent initialize it when the flushing is ready*/
-    if(lv_color_format_has_alpha(disp_refr->color_format)) {
-        lv_area_t a = disp_refr->refreshed_area;
-        if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+    if(lv_color_format_has_alpha(disp->color_format)) {
+        lv_area_t a = disp->refreshed_area;
+        if(disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
             /*The area always starts at 0;0*/
-            lv_area_move(&a, -disp_refr->refreshed_area.x1, -disp_refr->refreshed_area.y1);
+            lv_area_move(&a, -disp->refreshed_area.x1, -disp->refreshed_area.y1);
         }
 
         lv_draw_buf_clear(layer->draw_buf, &a);
     }
 
+    uint32_t task_cnt = LV_GLOBAL_DEFAULT()->draw_info.task_cnt;
+
+    /*The tasks covering more tiles are split to the tiles when they are created*/
+    layer->_tile_size = disp->tile_size;
+    refr_layer_objs(layer);
+
+    /*Count the draw tasks of the strip to see how much is created again for each strip*/
+    lv_display_strip_stat_t * stat = &disp->strip_stat;
+    task_cnt = LV_GLOBAL_DEFAULT()->draw_info.task_cnt - task_cnt;
+    stat->strip_cnt++;
+    stat->task_cnt += task_cnt;
+    stat->task_cnt_max = LV_MAX(stat->task_cnt_max, task_cnt);
+
+    draw_buf_flush(disp);
+    LV_PROFILER_END;
+}
+
+/**
+ * Draw the screens and the top and sys layers of the refreshed display on the clip area of a layer
+ * @param layer     pointer to a layer with a configured clip area
+ */
+static void refr_layer_objs(lv_layer_t * layer)
+{
+    lv_display_t * disp = layer->disp;
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
     /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(&layer->_clip_area, lv_display_get_screen_active(disp_refr));
-    if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(&layer->_clip_area, disp_refr->prev_scr);
+    top_act_scr = lv_refr_get_top_obj(&layer->_clip_area, lv_display_get_screen_active(disp));
+    if(disp->prev_scr) {
+        top_prev_scr = lv_refr_get_top_obj(&layer->_clip_area, disp->prev_scr);
     }
 
     /*Draw a bottom layer background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
-        refr_obj_and_children(layer, lv_display_get_layer_bottom(disp_refr));
+        refr_obj_and_children(layer, lv_display_get_layer_bottom(disp));
     }
 
-    if(disp_refr->draw_prev_over_act) {
-        if(top_act_scr == NULL) top_act_scr = disp_refr->act_scr;
+    if(disp->draw_prev_over_act) {
+        if(top_act_scr == NULL) top_act_scr = disp->act_scr;
         refr_obj_and_children(layer, top_act_scr);
 
         /*Refresh the previous screen if any*/
-        if(disp_refr->prev_scr) {
-            if(top_prev_scr == NULL) top_prev_scr = disp_refr->prev_scr;
+        if(disp->prev_scr) {
+            if(top_prev_scr == NULL) top_prev_scr = disp->prev_scr;
             refr_obj_and_children(layer, top_prev_scr);
         }
     }
     else {
         /*Refresh the previous screen if any*/
-        if(disp_refr->prev_scr) {
-            if(top_prev_scr == NULL) top_prev_scr = disp_refr->prev_scr;
+        if(disp->prev_scr) {
+            if(top_prev_scr == NULL) top_prev_scr = disp->prev_scr;
             refr_obj_and_children(layer, top_prev_scr);
         }
 
-        if(top_act_scr == NULL) top_act_scr = disp_refr->act_scr;
+        if(top_act_scr == NULL) top_act_scr = disp->act_scr;
         refr_obj_and_children(layer, top_act_scr);
     }
 
     /*Also refresh top and sys layer unconditionally*/
-    refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
-    refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
+    refr_obj_and_children(layer, lv_display_get_layer_top(disp));
+    refr_obj_and_children(layer, lv_display_get_layer_sys(disp));
+}
 
-    draw_buf_flush(disp_refr);
-    LV_PROFILER_END;
+#if LV_USE_DRAW_LIST
+/**
+ * Draw the main part of an object by replaying its retained draw tasks if they are still valid.
+ * Else send the draw events and record the new draw tasks for the next refreshes.
+ * @param layer             pointer to a layer with the clip area set to the object's visible area
+ * @param obj               pointer to an object to draw
+ * @param fully_visible     true: the whole object (with its extended draw size) is on the clip area.
+ *                          Only such drawings are recorded as some widgets skip the invisible parts.
+ */
+static void refr_obj_main_retained(lv_layer_t * layer, lv_obj_t * obj, bool fully_visible)
+{
+    bool retain = lv_obj_has_flag(obj, LV_OBJ_FLAG_RETAIN_DRAW) &&
+                  !lv_obj_has_flag(obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_draw_list_t * list = obj->spec_attr ? obj->spec_attr->draw_list : NULL;
+
+    if(!retain) {
+        if(list) {
+            lv_draw_list_delete(list);
+            obj->spec_attr->draw_list = NULL;
+        }
+        lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
+        lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
+        lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+        return;
+    }
+
+    if(list && lv_draw_list_is_valid(list, &obj->coords)) {
+        lv_draw_list_replay(list, layer);
+        return;
+    }
+
+    if(list == NULL && fully_visible) {
+        lv_obj_allocate_spec_attr(obj);
+        list = lv_draw_list_create();
+        obj->spec_attr->draw_list = list;
+    }
+
+    if(list && fully_visible) lv_draw_list_record_start(list, layer, &obj->coords);
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
+    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+    if(list && fully_visible) lv_draw_list_record_finish(list);
 }
+#endif
 
 /**
  * Search the most top object which fully covers an area
@@ -782,7 +1204,7 @@ static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj)
     /*Normally always will be a top_obj (at least the screen)
      *but in special cases (e.g. if the screen has alpha) it won't.
      *In this case use the screen directly*/
-    if(top_obj == NULL) top_obj = lv_display_get_screen_active(disp_refr);
+    if(top_obj == NULL) top_obj = lv_display_get_screen_active(layer->disp);
     if(top_obj == NULL) return;  /*Shouldn't happen*/
 
     LV_PROFILER_BEGIN;
@@ -900,12 +1322,14 @@ void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
         lv_result_t res = layer_get_area(layer, obj, layer_type, &layer_area_full, &obj_draw_size);
         if(res != LV_RESULT_OK) return;
 
+        if(refr_obj_cached_layer(layer, obj, layer_type, &obj_draw_size) == LV_RESULT_OK) return;
+
         /*Simple layers can be subdivied into smaller layers*/
         uint32_t max_rgb_row_height = lv_area_get_height(&layer_area_full);
         uint32_t max_argb_row_height = lv_area_get_height(&layer_area_full);
         if(layer_type == LV_LAYER_TYPE_SIMPLE) {
             int32_t w = lv_area_get_width(&layer_area_full);
-            uint8_t px_size = lv_color_format_get_size(disp_refr->color_format);
+            uint8_t px_size = lv_color_format_get_size(layer->disp->color_format);
             max_rgb_row_height = LV_DRAW_LAYER_SIMPLE_BUF_SIZE / w / px_size;
             max_argb_row_height = LV_DRAW_LAYER_SIMPLE_BUF_SIZE / w / sizeof(lv_color32_t);
         }
@@ -931,37 +1355,8 @@ void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
                                                           area_need_alpha ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_NATIVE, &layer_area_act);
             lv_obj_redraw(new_layer, obj);
 
-            lv_point_t pivot = {
-                .x = lv_obj_get_style_transform_pivot_x(obj, 0),
-                .y = lv_obj_get_style_transform_pivot_y(obj, 0)
-            };
-
-            if(LV_COORD_IS_PCT(pivot.x)) {
-                pivot.x = (LV_COORD_GET_PCT(pivot.x) * lv_area_get_width(&obj->coords)) / 100;
-            }
-            if(LV_COORD_IS_PCT(pivot.y)) {
-                pivot.y = (LV_COORD_GET_PCT(pivot.y) * lv_area_get_height(&obj->coords)) / 100;
-            }
-
             lv_draw_image_dsc_t layer_draw_dsc;
-            lv_draw_image_dsc_init(&layer_draw_dsc);
-            layer_draw_dsc.pivot.x = obj->coords.x1 + pivot.x - new_layer->buf_area.x1;
-            layer_draw_dsc.pivot.y = obj->coords.y1 + pivot.y - new_layer->buf_area.y1;
-
-            layer_draw_dsc.opa = opa;
-            layer_draw_dsc.rotation = lv_obj_get_style_transform_rotation(obj, 0);
-            while(layer_draw_dsc.rotation > 3600) layer_draw_dsc.rotation -= 3600;
-            while(layer_draw_dsc.rotation < 0) layer_draw_dsc.rotation += 3600;
-            layer_draw_dsc.scale_x = lv_obj_get_style_transform_scale_x(obj, 0);
-            layer_draw_dsc.scale_y = lv_obj_get_style_transform_scale_y(obj, 0);
-            layer_draw_dsc.skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
-            layer_draw_dsc.skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
-            layer_draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
-            layer_draw_dsc.antialias = disp_refr->antialiasing;
-            layer_draw_dsc.bitmap_mask_src = lv_obj_get_style_bitmap_mask_src(obj, 0);
-            layer_draw_dsc.original_area = obj_draw_size;
-            layer_draw_dsc.src = new_layer;
-
+            layer_draw_dsc_init(&layer_draw_dsc, obj, new_layer, &obj_draw_size, opa);
             lv_draw_layer(layer, &layer_draw_dsc, &layer_area_act);
 
             layer_area_act.y1 = layer_area_act.y2 + 1;
@@ -969,6 +1364,156 @@ void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     }
 }
 
+/**
+ * Draw a widget by blending its layer from the layer cache.
+ * If the widget is not cached yet, its whole layer is rendered and added to the cache.
+ * @param layer         the layer to draw the widget to
+ * @param obj           the widget which needs a layer
+ * @param layer_type    the type of the widget's layer
+ * @param obj_draw_size the area of the widget including the extra draw size
+ * @return              LV_RESULT_OK: the widget was drawn;
+ *                      LV_RESULT_INVALID: the cache can't be used now, draw the widget normally
+ */
+static lv_result_t refr_obj_cached_layer(lv_layer_t * layer, lv_obj_t * obj, lv_layer_type_t layer_type,
+                                         const lv_area_t * obj_draw_size)
+{
+    if(!lv_draw_layer_cache_is_enabled()) return LV_RESULT_INVALID;
+
+    /*The draw task events wouldn't be sent when the cached layer is used*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) return LV_RESULT_INVALID;
+
+    /*Use the same area as `layer_get_area()` if the widget is fully visible*/
+    lv_area_t layer_area = *obj_draw_size;
+    if(layer_type == LV_LAYER_TYPE_TRANSFORM) lv_area_increase(&layer_area, 5, 5);
+
+    lv_layer_t * obj_layer;
+    lv_cache_entry_t * entry = lv_draw_layer_cache_acquire(obj);
+    if(entry) {
+        lv_draw_layer_cache_data_t * data = lv_cache_entry_get_data(entry);
+
+        /*E.g. in an other tile the same layer might be still being rendered*/
+        if(layer_buf_is_rendering(layer->disp, data->draw_buf)) {
+            lv_draw_layer_cache_release(entry);
+            return LV_RESULT_INVALID;
+        }
+
+        /*The widget was moved or resized, render it again*/
+        if(!_lv_area_is_equal(&data->area, &layer_area)) {
+            lv_draw_layer_cache_release(entry);
+            entry = NULL;
+        }
+    }
+
+    if(entry) {
+        lv_draw_layer_cache_data_t * data = lv_cache_entry_get_data(entry);
+        obj_layer = lv_draw_layer_create(layer, data->draw_buf->header.cf, &data->area);
+        if(obj_layer == NULL) {
+            lv_draw_layer_cache_release(entry);
+            return LV_RESULT_INVALID;
+        }
+        obj_layer->draw_buf = data->draw_buf;
+        obj_layer->cache_entry = entry;
+    }
+    else {
+        lv_color_format_t cf = alpha_test_area_on_obj(obj, &layer_area) ?
+                               LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_NATIVE;
+        lv_draw_buf_t * draw_buf = lv_draw_buf_create(lv_area_get_width(&layer_area),
+                                                      lv_area_get_height(&layer_area), cf, 0);
+        if(draw_buf == NULL) return LV_RESULT_INVALID;
+
+        entry = lv_draw_layer_cache_add(obj, draw_buf, &layer_area);
+        if(entry == NULL) {
+            lv_draw_buf_destroy(draw_buf);
+            return LV_RESULT_INVALID;
+        }
+
+        if(lv_color_format_has_alpha(cf)) {
+            lv_draw_buf_clear(draw_buf, NULL);
+        }
+
+        obj_layer = lv_draw_layer_create(layer, cf, &layer_area);
+        if(obj_layer == NULL) {
+            lv_draw_layer_cache_release(entry);
+            lv_draw_layer_cache_drop(obj);
+            return LV_RESULT_INVALID;
+        }
+        obj_layer->draw_buf = draw_buf;
+        obj_layer->cache_entry = entry;
+
+        lv_obj_redraw(obj_layer, obj);
+    }
+
+    lv_draw_image_dsc_t layer_draw_dsc;
+    layer_draw_dsc_init(&layer_draw_dsc, obj, obj_layer, obj_draw_size, lv_obj_get_style_opa_layered(obj, 0));
+    lv_draw_layer(layer, &layer_draw_dsc, &layer_area);
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Check if a layer of the refreshed display is still being rendered to a draw buffer
+ * @param draw_buf      pointer to a draw buffer
+ * @return              true: there are draw tasks in a layer which render to `draw_buf`
+ */
+static bool layer_buf_is_rendering(lv_display_t * disp, const lv_draw_buf_t * draw_buf)
+{
+    lv_layer_t * l;
+    for(l = disp->layer_head; l; l = l->next) {
+        if(l->draw_buf == draw_buf && l->draw_task_head) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Initialize a draw descriptor to blend the layer of a widget
+ * @param dsc           the descriptor to initialize
+ * @param obj           the widget drawn to the layer
+ * @param obj_layer     the layer to blend
+ * @param obj_draw_size the area of the widget including the extra draw size
+ * @param opa           the opacity of the layer
+ */
+static void layer_draw_dsc_init(lv_draw_image_dsc_t * dsc, lv_obj_t * obj, lv_layer_t * obj_layer,
+                                const lv_area_t * obj_draw_size, lv_opa_t opa)
+{
+    lv_point_t pivot = {
+        .x = lv_obj_get_style_transform_pivot_x(obj, 0),
+        .y = lv_obj_get_style_transform_pivot_y(obj, 0)
+    };
+
+    if(LV_COORD_IS_PCT(pivot.x)) {
+        pivot.x = (LV_COORD_GET_PCT(pivot.x) * lv_area_get_width(&obj->coords)) / 100;
+    }
+    if(LV_COORD_IS_PCT(pivot.y)) {
+        pivot.y = (LV_COORD_GET_PCT(pivot.y) * lv_area_get_height(&obj->coords)) / 100;
+    }
+
+    lv_draw_image_dsc_init(dsc);
+    dsc->pivot.x = obj->coords.x1 + pivot.x - obj_layer->buf_area.x1;
+    dsc->pivot.y = obj->coords.y1 + pivot.y - obj_layer->buf_area.y1;
+
+    dsc->opa = opa;
+    dsc->rotation = lv_obj_get_style_transform_rotation(obj, 0);
+    while(dsc->rotation > 3600) dsc->rotation -= 3600;
+    while(dsc->rotation < 0) dsc->rotation += 3600;
+    dsc->scale_x = lv_obj_get_style_transform_scale_x(obj, 0);
+    dsc->scale_y = lv_obj_get_style_transform_scale_y(obj, 0);
+    dsc->skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
+    dsc->skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
+    dsc->blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+    dsc->antialias = obj_layer->disp->antialiasing;
+    dsc->bitmap_mask_src = lv_obj_get_style_bitmap_mask_src(obj, 0);
+    dsc->original_area = *obj_draw_size;
+    dsc->src = obj_layer;
+}
+
+/**
+ * Get the height of the strips to render an area in partial render mode
+ * @param disp      pointer to a display
+ * @param area_w    width of the area
+ * @param area_h    height of the area
+ * @return          the height of the strips or 0 if no height fits after rounding
+ */
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 {
     bool has_alpha = lv_color_format_has_alpha(disp->color_format);
@@ -976,7 +1521,38 @@ static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
     uint32_t stride = lv_draw_buf_width_to_stride(area_w, cf);
     int32_t max_row = (uint32_t)disp->buf_act->data_size / stride;
 
-    if(max_row > area_h) max_row = area_h;
+    /*Keep the strips in the cache, but don't make them so thin that walking the widgets dominates*/
+    if(disp->strip_size) {
+        int32_t strip_row = LV_MAX(disp->strip_size / stride, LV_DISPLAY_STRIP_MIN_ROWS);
+        if(max_row > strip_row) max_row = strip_row;
+    }
+
+    if(max_row >= area_h) return round_max_row(disp, area_h);
+
+    int32_t row_rounded = round_max_row(disp, max_row);
+    if(row_rounded <= 0) return 0;
+
+    /*Use strips with similar height instead of a thin last strip*/
+    int32_t strip_cnt = (area_h + row_rounded - 1) / row_rounded;
+    int32_t row_even = round_max_row(disp, (area_h + strip_cnt - 1) / strip_cnt);
+    if(row_even > 0 && (area_h + row_even - 1) / row_even == strip_cnt) return row_even;
+
+    return row_rounded;
+}
+
+/**
+ * Get the largest strip height which is not taller than `max_row` after rounding
+ * with `LV_EVENT_INVALIDATE_AREA`. The results are remembered in the display.
+ * @param disp      pointer to a display
+ * @param max_row   the max. height of the strip
+ * @return          the height to use or 0 if no height fits after rounding
+ */
+static int32_t round_max_row(lv_display_t * disp, int32_t max_row)
+{
+    uint32_t i;
+    for(i = 0; i < LV_DISPLAY_STRIP_ROUND_CACHE_CNT; i++) {
+        if(disp->strip_round[i].row == max_row) return disp->strip_round[i].row_rounded;
+    }
 
     /*Round down the lines of draw_buf if rounding is added*/
     lv_area_t tmp;
@@ -987,25 +1563,32 @@ static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
     int32_t h_tmp = max_row;
     do {
         tmp.y2 = h_tmp - 1;
-        lv_display_send_event(disp_refr, LV_EVENT_INVALIDATE_AREA, &tmp);
+        lv_display_send_event(disp, LV_EVENT_INVALIDATE_AREA, &tmp);
 
         /*If this height fits into `max_row` then fine*/
-        if(lv_area_get_height(&tmp) <= max_row) break;
+        int32_t h_rounded = lv_area_get_height(&tmp);
+        if(h_rounded <= max_row) break;
 
-        /*Decrement the height of the area until it fits into `max_row` after rounding*/
-        h_tmp--;
+        /*Decrease the height by the overflow to get below `max_row` after rounding*/
+        h_tmp -= LV_MAX(h_rounded - max_row, 1);
     } while(h_tmp > 0);
 
+    int32_t row_rounded;
     if(h_tmp <= 0) {
         LV_LOG_WARN("Can't set draw_buf height using the round function. (Wrong round_cb or too "
                     "small draw_buf)");
-        return 0;
+        row_rounded = 0;
     }
     else {
-        max_row = tmp.y2 + 1;
+        row_rounded = tmp.y2 + 1;
     }
 
-    return max_row;
+    lv_display_strip_round_t * entry = &disp->strip_round[disp->strip_round_next];
+    entry->row = max_row;
+    entry->row_rounded = row_rounded;
+    disp->strip_round_next = (disp->strip_round_next + 1) % LV_DISPLAY_STRIP_ROUND_CACHE_CNT;
+
+    return row_rounded;
 }
 
 /**
@@ -1018,35 +1601,36 @@ static void draw_buf_flush(lv_display_t * disp)
 
     while(layer->draw_task_head) {
         lv_draw_dispatch_wait_for_request();
-        lv_draw_dispatch();
+        lv_draw_dispatch_display(disp);
     }
 
     /* In double buffered mode wait until the other buffer is freed
      * and driver is ready to receive the new buffer.
      * If we need to wait here it means that the content of one buffer is being sent to display
-     * and other buffer already contains the new rendered image. */
+     * and other buffer already contains the new rendered image.
+     * With N buffers N-2 flushes can be in progress, so the next buffer will be free
+     * after the flush of the oldest buffer is finished. */
     if(lv_display_is_double_buffered(disp)) {
-        wait_for_flushing(disp_refr);
+        wait_for_flushing(disp, lv_display_get_draw_buffer_count(disp) - 2);
     }
 
-    disp->flushing = 1;
-
     if(disp->last_area && disp->last_part) disp->flushing_last = 1;
     else disp->flushing_last = 0;
 
     bool flushing_last = disp->flushing_last;
 
     if(disp->flush_cb) {
+        disp->flush_started_cnt++;
+        disp->flush_stat.flush_cnt++;
+        uint32_t pending_cnt = get_flush_pending_cnt(disp);
+        if(pending_cnt > disp->flush_stat.flush_pending_max) disp->flush_stat.flush_pending_max = pending_cnt;
+
         call_flush_cb(disp, &disp->refreshed_area, layer->draw_buf->data);
     }
-    /*If there are 2 buffers swap them. With direct mode swap only on the last area*/
+    /*If there are more buffers use the next one. With direct mode swap only on the last area*/
     if(lv_display_is_double_buffered(disp) && (disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT || flushing_last)) {
-        if(disp->buf_act == disp->buf_1) {
-            disp->buf_act = disp->buf_2;
-        }
-        else {
-            disp->buf_act = disp->buf_1;
-        }
+        uint32_t buf_cnt = lv_display_get_draw_buffer_count(disp);
+        disp->buf_act = lv_display_get_draw_buffer(disp, (get_buf_idx(disp, disp->buf_act) + 1) % buf_cnt);
     }
 }
 
@@ -1070,23 +1654,222 @@ static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t *
     LV_PROFILER_END;
 }
 
-static void wait_for_flushing(lv_display_t * disp)
+/**
+ * Wait until the number of flushes in progress is not more than a given value
+ * @param disp          pointer to a display
+ * @param max_pending   the max. number of flushes which can be still in progress
+ */
+static void wait_for_flushing(lv_display_t * disp, uint32_t max_pending)
 {
+    if(get_flush_pending_cnt(disp) <= max_pending) return;
+
     LV_PROFILER_BEGIN;
     LV_LOG_TRACE("begin");
 
     lv_display_send_event(disp, LV_EVENT_FLUSH_WAIT_START, NULL);
+    uint32_t wait_start = lv_tick_get();
 
     if(disp->flush_wait_cb) {
-        disp->flush_wait_cb(disp);
+        while(get_flush_pending_cnt(disp) > max_pending) {
+            uint32_t ready_cnt = disp->flush_ready_cnt;
+            disp->flush_wait_cb(disp);
+
+            /*If the driver doesn't call `lv_display_flush_ready()`
+             *all flushes are finished when the callback returns*/
+            if(ready_cnt == disp->flush_ready_cnt) disp->flush_waited_cnt += get_flush_pending_cnt(disp);
+        }
     }
     else {
-        while(disp->flushing);
+        while(get_flush_pending_cnt(disp) > max_pending);
     }
     disp->flushing_last = 0;
 
+    uint32_t wait_time = lv_tick_elaps(wait_start);
+    disp->flush_stat.wait_cnt++;
+    disp->flush_stat.wait_time_sum += wait_time;
+    if(wait_time > disp->flush_stat.wait_time_max) disp->flush_stat.wait_time_max = wait_time;
+
     lv_display_send_event(disp, LV_EVENT_FLUSH_WAIT_FINISH, NULL);
 
     LV_LOG_TRACE("end");
     LV_PROFILER_END;
 }
+
+/**
+ * Get the number of flushes which are in progress
+ * @param disp          pointer to a display
+ * @return              the number of `flush_cb` calls without `lv_display_flush_ready()`
+ */
+static uint32_t get_flush_pending_cnt(lv_display_t * disp)
+{
+    return disp->flush_started_cnt - disp->flush_waited_cnt - disp->flush_ready_cnt;
+}
+
+/**
+ * In direct mode wait until the active buffer is neither shown nor flushed.
+ * A buffer is shown until the flush of a later buffer is finished, so with N buffers
+ * the active buffer is free if the flushes of at most the last N-2 buffers are in progress.
+ * @param disp          pointer to a display
+ */
+static void wait_for_buf_act_free(lv_display_t * disp)
+{
+    uint32_t buf_cnt = lv_display_get_draw_buffer_count(disp);
+    wait_for_flushing(disp, buf_cnt >= 2 ? buf_cnt - 2 : 0);
+}
+
+/**
+ * Pace the refreshing to the vsyncs reported by the driver.
+ * Delay the refresh timer to start the rendering just in time to be ready before the next vsync
+ * and evaluate the animations for the time when that vsync presents the frame.
+ * @param disp      pointer to a display
+ * @param tmr       the refresh timer of the display
+ * @return          true: the refresh timer was delayed; false: the frame can be rendered now
+ */
+static bool frame_sched_start(lv_display_t * disp, lv_timer_t * tmr)
+{
+    lv_display_frame_sched_t * sched = &disp->frame_sched;
+    if(!frame_sched_is_active(disp)) {
+        frame_sched_stop_waiting(disp, tmr);
+        sched->deadline_valid = 0;
+        return false;
+    }
+
+    uint32_t now = lv_tick_get();
+    uint32_t period_us = sched->period_us;
+
+    /*The first vsync before which the frame can be ready*/
+    uint32_t ready = now - sched->vsync_tick + sched->render_time + LV_DISPLAY_VSYNC_MARGIN;
+    uint32_t vsync_idx = (ready * 1000 + period_us - 1) / period_us;
+    if(vsync_idx == 0) vsync_idx = 1;
+
+    /*Render only one frame for a vsync*/
+    if(sched->deadline_valid && (int32_t)(sched->deadline - sched->vsync_tick) >= 0) {
+        uint32_t last_idx = ((sched->deadline - sched->vsync_tick) * 1000 + period_us / 2) / period_us;
+        if(vsync_idx <= last_idx) vsync_idx = last_idx + 1;
+    }
+
+    uint32_t deadline = sched->vsync_tick + vsync_idx * period_us / 1000;
+    uint32_t start = deadline - sched->render_time - LV_DISPLAY_VSYNC_MARGIN;
+    if((int32_t)(start - now) > 0) {
+        if(!sched->waiting) {
+            sched->timer_period = tmr->period;
+            sched->waiting = 1;
+        }
+        lv_timer_set_period(tmr, start - now);
+        lv_timer_reset(tmr);
+        return true;
+    }
+
+    frame_sched_stop_waiting(disp, tmr);
+    sched->deadline = deadline;
+    sched->deadline_valid = 1;
+    sched->paced = 1;
+
+    /*Show the animations as they should look when the frame is presented*/
+    lv_anim_set_frame_time(deadline);
+    lv_anim_refr_now();
+
+    return false;
+}
+
+/**
+ * Update the predicted render time and check if the frame was ready before its vsync
+ * @param disp          pointer to a display
+ * @param start_tick    the time when the refreshing started
+ * @param rendered      true: something was rendered; false: there was nothing to refresh
+ */
+static void frame_sched_finish(lv_display_t * disp, uint32_t start_tick, bool rendered)
+{
+    lv_display_frame_sched_t * sched = &disp->frame_sched;
+    if(!sched->paced) return;
+    sched->paced = 0;
+
+    /*The frame time belongs to this display, don't use it for the other displays*/
+    lv_anim_clear_frame_time();
+
+    /*The vsync can be used by the next frame*/
+    if(!rendered) {
+        sched->deadline_valid = 0;
+        return;
+    }
+
+    uint32_t now = lv_tick_get();
+    uint32_t render_time = now - start_tick;
+
+    /*Follow the slower frames immediately to not miss the next vsyncs too*/
+    if(render_time > sched->render_time) sched->render_time = render_time;
+    else sched->render_time = (sched->render_time * 7 + render_time) / 8;
+
+    sched->stat.frame_cnt++;
+
+    int32_t late = (int32_t)(now - sched->deadline);
+    if(late > 0) {
+        sched->stat.missed_cnt++;
+        sched->stat.late_time_max = LV_MAX(sched->stat.late_time_max, (uint32_t)late);
+        LV_TRACE_REFR("the frame missed its vsync by %" LV_PRId32 " ms", late);
+    }
+}
+
+/**
+ * Check if the refreshing of a display needs to be paced to the vsync
+ * @param disp      pointer to a display
+ * @return          true: the vsyncs are reported and the period is known
+ */
+static bool frame_sched_is_active(lv_display_t * disp)
+{
+    lv_display_frame_sched_t * sched = &disp->frame_sched;
+    frame_sched_take_vsync(disp);
+    if(!sched->vsync_reported || sched->period_us == 0) return false;
+
+    /*Render immediately if the vsyncs are not reported anymore (e.g. the display is idle)*/
+    return lv_tick_elaps(sched->vsync_tick) < sched->period_us * LV_DISPLAY_VSYNC_TIMEOUT / 1000;
+}
+
+/**
+ * Take the last vsync reported by `lv_display_report_vsync()` and measure the vsync period
+ * @param disp      pointer to a display
+ */
+static void frame_sched_take_vsync(lv_display_t * disp)
+{
+    lv_display_frame_sched_t * sched = &disp->frame_sched;
+
+    /*Read the tick again if a vsync was reported meanwhile*/
+    uint32_t cnt;
+    uint32_t tick;
+    do {
+        cnt = sched->irq_vsync_cnt;
+        tick = sched->irq_vsync_tick;
+    } while(cnt != sched->irq_vsync_cnt);
+
+    uint32_t vsync_cnt = cnt - sched->vsync_cnt;
+    if(vsync_cnt == 0) return;
+
+    if(sched->vsync_reported && !sched->period_set) {
+        /*Ignore the long gaps when the vsyncs were not reported (e.g. no new frame was shown).
+         *If more vsyncs were reported since the last refresh use their average period.*/
+        uint32_t diff = tick - sched->vsync_tick;
+        if(diff >= vsync_cnt && diff / vsync_cnt < 1000) {
+            uint32_t diff_us = diff * 1000 / vsync_cnt;
+            if(sched->period_us == 0) sched->period_us = diff_us;
+            else if(diff_us < sched->period_us * 3 / 2) sched->period_us = (sched->period_us * 7 + diff_us) / 8;
+        }
+    }
+
+    sched->vsync_cnt = cnt;
+    sched->vsync_tick = tick;
+    sched->vsync_reported = 1;
+}
+
+/**
+ * Restore the period of the refresh timer if it was shortened to start a frame in time
+ * @param disp      pointer to a display
+ * @param tmr       the refresh timer of the display
+ */
+static void frame_sched_stop_waiting(lv_display_t * disp, lv_timer_t * tmr)
+{
+    lv_display_frame_sched_t * sched = &disp->frame_sched;
+    if(!sched->waiting) return;
+
+    lv_timer_set_period(tmr, sched->timer_period);
+    sched->waiting = 0;
+}
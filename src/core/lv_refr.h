@@ -76,7 +76,21 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj);
 void _lv_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 
 /**
- * Get the display which is being refreshed
+ * Move the already rendered pixels of a scrolled area in the next refresh instead of rendering them again.
+ * The parts which become visible and the invalid areas moved by the scroll are invalidated.
+ * Works only in `LV_DISPLAY_RENDER_MODE_DIRECT` as the pixels of the previous frame are required.
+ * @param disp      pointer to display where the area is scrolled
+ * @param area_p    the scrolled area. Nothing else should be drawn on it.
+ * @param dx        move the pixels by this many pixels horizontally
+ * @param dy        move the pixels by this many pixels vertically
+ * @return          true: the pixels will be moved; false: the area needs to be invalidated
+ */
+bool _lv_inv_area_scroll(lv_display_t * disp, const lv_area_t * area_p, int32_t dx, int32_t dy);
+
+/**
+ * Get the display which is being refreshed.
+ * Kept for external code, LVGL doesn't use it anymore.
+ * While drawing use the display of the layer (`lv_layer_t::disp`) instead.
  * @return the display being refreshed
  */
 lv_display_t * _lv_refr_get_disp_refreshing(void);
@@ -33,6 +33,7 @@
  **********************/
 static lv_obj_tree_walk_res_t invalidate_layout_cb(lv_obj_t * obj, void * user_data);
 static void update_resolution(lv_display_t * disp);
+static void strip_round_reset(lv_display_t * disp);
 static void scr_load_internal(lv_obj_t * scr);
 static void scr_load_anim_start(lv_anim_t * a);
 static void opa_scale_anim(void * obj, int32_t v);
@@ -70,12 +71,15 @@ lv_display_t * lv_display_create(int32_t hor_res, int32_t ver_res)
     disp->offset_y         = 0;
     disp->antialiasing     = LV_COLOR_DEPTH > 8 ? 1 : 0;
     disp->dpi              = LV_DPI_DEF;
+    disp->strip_size       = LV_DEF_STRIP_SIZE;
+    disp->scroll_blit_en   = 1;
     disp->color_format = LV_COLOR_FORMAT_NATIVE;
 
     disp->layer_head = lv_malloc_zeroed(sizeof(lv_layer_t));
     LV_ASSERT_MALLOC(disp->layer_head);
     if(disp->layer_head == NULL) return NULL;
 
+    disp->layer_head->disp = disp;
     if(disp->layer_init) disp->layer_init(disp, disp->layer_head);
     disp->layer_head->buf_area.x1 = 0;
     disp->layer_head->buf_area.y1 = 0;
@@ -86,8 +90,6 @@ lv_display_t * lv_display_create(int32_t hor_res, int32_t ver_res)
     disp->inv_en_cnt = 1;
     disp->last_activity_time = lv_tick_get();
 
-    _lv_ll_init(&disp->sync_areas, sizeof(lv_area_t));
-
     lv_display_t * disp_def_tmp = disp_def;
     disp_def                 = disp; /*Temporarily change the default screen to create the default screens on the
                                         new display*/
@@ -182,7 +184,7 @@ void lv_display_delete(lv_display_t * disp)
         lv_obj_delete(disp->screens[0]);
     }
 
-    _lv_ll_clear(&disp->sync_areas);
+    lv_free(disp->buf_damage);
     _lv_ll_remove(disp_ll_p, disp);
     if(disp->refr_timer) lv_timer_delete(disp->refr_timer);
 
@@ -393,7 +395,111 @@ void lv_display_set_draw_buffers(lv_display_t * disp, lv_draw_buf_t * buf1, lv_d
 
     disp->buf_1 = buf1;
     disp->buf_2 = buf2;
+    disp->buf_extra_cnt = 0;
     disp->buf_act = disp->buf_1;
+
+    /*The damage of the previous buffers is meaningless*/
+    lv_free(disp->buf_damage);
+    disp->buf_damage = NULL;
+}
+
+lv_result_t lv_display_add_draw_buffer(lv_display_t * disp, lv_draw_buf_t * buf)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return LV_RESULT_INVALID;
+
+    LV_ASSERT_NULL(buf);
+    if(disp->buf_1 == NULL || disp->buf_2 == NULL) {
+        LV_LOG_WARN("set the first two draw buffers first");
+        return LV_RESULT_INVALID;
+    }
+
+    if(disp->buf_extra_cnt >= LV_DISPLAY_DRAW_BUF_MAX_CNT - 2) {
+        LV_LOG_WARN("max. %d draw buffers are supported", LV_DISPLAY_DRAW_BUF_MAX_CNT);
+        return LV_RESULT_INVALID;
+    }
+
+    disp->buf_extra[disp->buf_extra_cnt] = buf;
+    disp->buf_extra_cnt++;
+
+    lv_free(disp->buf_damage);
+    disp->buf_damage = NULL;
+
+    return LV_RESULT_OK;
+}
+
+const lv_display_flush_stat_t * lv_display_get_flush_stat(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return NULL;
+
+    return &disp->flush_stat;
+}
+
+void lv_display_reset_flush_stat(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_memzero(&disp->flush_stat, sizeof(disp->flush_stat));
+}
+
+void lv_display_report_vsync(lv_display_t * disp, uint32_t tick)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    /*Only store the vsync here and let the refreshing process it to not share any other data with an interrupt*/
+    lv_display_frame_sched_t * sched = &disp->frame_sched;
+    sched->irq_vsync_tick = tick;
+    sched->irq_vsync_cnt = sched->irq_vsync_cnt + 1;
+}
+
+void lv_display_set_vsync_period(lv_display_t * disp, uint32_t period_us)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->frame_sched.period_us = period_us;
+    disp->frame_sched.period_set = period_us ? 1 : 0;
+}
+
+const lv_display_frame_stat_t * lv_display_get_frame_stat(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return NULL;
+
+    disp->frame_sched.stat.render_time = disp->frame_sched.render_time;
+    return &disp->frame_sched.stat;
+}
+
+void lv_display_reset_frame_stat(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_memzero(&disp->frame_sched.stat, sizeof(disp->frame_sched.stat));
+}
+
+uint32_t lv_display_get_draw_buffer_count(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return 0;
+
+    if(disp->buf_1 == NULL) return 0;
+    if(disp->buf_2 == NULL) return 1;
+    return 2 + disp->buf_extra_cnt;
+}
+
+lv_draw_buf_t * lv_display_get_draw_buffer(lv_display_t * disp, uint32_t idx)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return NULL;
+
+    if(idx >= lv_display_get_draw_buffer_count(disp)) return NULL;
+    if(idx == 0) return disp->buf_1;
+    if(idx == 1) return disp->buf_2;
+    return disp->buf_extra[idx - 2];
 }
 
 void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint32_t buf_size,
@@ -457,8 +563,11 @@ void lv_display_set_color_format(lv_display_t * disp, lv_color_format_t color_fo
 
     disp->color_format = color_format;
     disp->layer_head->color_format = color_format;
-    if(disp->buf_1) disp->buf_1->header.cf = color_format;
-    if(disp->buf_2) disp->buf_2->header.cf = color_format;
+    uint32_t buf_cnt = lv_display_get_draw_buffer_count(disp);
+    uint32_t i;
+    for(i = 0; i < buf_cnt; i++) {
+        lv_display_get_draw_buffer(disp, i)->header.cf = color_format;
+    }
 
     lv_display_send_event(disp, LV_EVENT_COLOR_FORMAT_CHANGED, NULL);
 }
@@ -487,9 +596,76 @@ bool lv_display_get_antialiasing(lv_display_t * disp)
     return disp->antialiasing;
 }
 
+void lv_display_set_tile_size(lv_display_t * disp, uint32_t size)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->tile_size = size;
+}
+
+uint32_t lv_display_get_tile_size(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return 0;
+
+    return disp->tile_size;
+}
+
+void lv_display_set_strip_size(lv_display_t * disp, uint32_t size)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->strip_size = size;
+}
+
+uint32_t lv_display_get_strip_size(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return 0;
+
+    return disp->strip_size;
+}
+
+const lv_display_strip_stat_t * lv_display_get_strip_stat(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return NULL;
+
+    return &disp->strip_stat;
+}
+
+void lv_display_reset_strip_stat(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    lv_memzero(&disp->strip_stat, sizeof(disp->strip_stat));
+}
+
+void lv_display_set_scroll_blit(lv_display_t * disp, bool en)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->scroll_blit_en = en;
+}
+
+bool lv_display_get_scroll_blit(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return false;
+
+    return disp->scroll_blit_en;
+}
+
 LV_ATTRIBUTE_FLUSH_READY void lv_display_flush_ready(lv_display_t * disp)
 {
-    disp->flushing = 0;
+    /*Don't count more finished flushes than started. Only this function writes `flush_ready_cnt`.*/
+    if(disp->flush_started_cnt - disp->flush_waited_cnt != disp->flush_ready_cnt) {
+        disp->flush_ready_cnt = disp->flush_ready_cnt + 1;
+    }
 }
 
 LV_ATTRIBUTE_FLUSH_READY bool lv_display_flush_is_last(lv_display_t * disp)
@@ -723,6 +899,9 @@ void lv_display_add_event_cb(lv_display_t * disp, lv_event_cb_t event_cb, lv_eve
     LV_ASSERT_NULL(disp);
 
     lv_event_add(&disp->event_list, event_cb, filter, user_data);
+
+    /*The new callback might round the areas differently*/
+    if(filter == LV_EVENT_INVALIDATE_AREA || filter == LV_EVENT_ALL) strip_round_reset(disp);
 }
 
 uint32_t lv_display_get_event_count(lv_display_t * disp)
@@ -742,6 +921,7 @@ bool lv_display_delete_event(lv_display_t * disp, uint32_t index)
 {
     LV_ASSERT_NULL(disp);
 
+    strip_round_reset(disp);
     return lv_event_remove(&disp->event_list, index);
 }
 
@@ -990,6 +1170,13 @@ static void update_resolution(lv_display_t * disp)
     lv_memzero(disp->inv_areas, sizeof(disp->inv_areas));
     lv_memzero(disp->inv_area_joined, sizeof(disp->inv_area_joined));
     disp->inv_p = 0;
+    strip_round_reset(disp);
+    if(disp->buf_damage) {
+        uint32_t buf_cnt = lv_display_get_draw_buffer_count(disp);
+        for(i = 0; i < buf_cnt; i++) {
+            disp->buf_damage[i].cnt = 0;
+        }
+    }
     lv_obj_invalidate(disp->sys_layer);
 
     lv_obj_tree_walk(NULL, invalidate_layout_cb, NULL);
@@ -1089,3 +1276,13 @@ static void disp_event_cb(lv_event_t * e)
             break;
     }
 }
+
+/**
+ * Forget the remembered rounding of the strip heights
+ * @param disp  pointer to a display
+ */
+static void strip_round_reset(lv_display_t * disp)
+{
+    lv_memzero(disp->strip_round, sizeof(disp->strip_round));
+    disp->strip_round_next = 0;
+}
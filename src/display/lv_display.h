@@ -59,6 +59,31 @@ typedef enum {
     LV_DISPLAY_RENDER_MODE_FULL,
 } lv_display_render_mode_t;
 
+/** Statistics about how long the rendering waited for flushing. The times are in milliseconds.*/
+typedef struct {
+    uint32_t flush_cnt;             /**< Number of `flush_cb` calls*/
+    uint32_t flush_pending_max;     /**< Max. number of flushes in progress at the same time*/
+    uint32_t wait_cnt;              /**< Number of times the rendering had to wait for flushing*/
+    uint32_t wait_time_sum;         /**< Total time spent with waiting*/
+    uint32_t wait_time_max;         /**< Longest wait*/
+} lv_display_flush_stat_t;
+
+/** Statistics of the frames paced to the vsync of the display. The times are in milliseconds.*/
+typedef struct {
+    uint32_t frame_cnt;             /**< Number of frames rendered for a vsync*/
+    uint32_t missed_cnt;            /**< Number of frames which were ready only after their vsync*/
+    uint32_t late_time_max;         /**< The most a frame was late*/
+    uint32_t render_time;           /**< The predicted time of rendering a frame*/
+} lv_display_frame_stat_t;
+
+/** Statistics of rendering the invalid areas in strips (in parts of the areas in partial render mode)*/
+typedef struct {
+    uint32_t area_cnt;              /**< Number of rendered areas*/
+    uint32_t strip_cnt;             /**< Number of rendered strips*/
+    uint32_t task_cnt;              /**< Number of draw tasks created for the strips*/
+    uint32_t task_cnt_max;          /**< The most draw tasks created for a strip*/
+} lv_display_strip_stat_t;
+
 typedef enum {
     LV_SCR_LOAD_ANIM_NONE,
     LV_SCR_LOAD_ANIM_OVER_LEFT,
@@ -247,6 +272,79 @@ void lv_display_set_buffers(lv_display_t * disp, void * buf1, void * buf2, uint3
  */
 void lv_display_set_draw_buffers(lv_display_t * disp, lv_draw_buf_t * buf1, lv_draw_buf_t * buf2);
 
+/**
+ * Add one more draw buffer after the buffers set by `lv_display_set_draw_buffers`.
+ * The draw buffers are used in a ring. With N buffers N-1 flushes can be in progress while LVGL
+ * renders into the next buffer, so `flush_cb` needs to queue the flushes.
+ * In direct mode each buffer is brought up to date by copying only the areas
+ * which were rendered into the other buffers since it was rendered the last time.
+ * @param disp              pointer to a display (NULL to use the default display)
+ * @param buf               a draw buffer with the same size and color format as the others
+ * @return                  LV_RESULT_OK: the buffer is added;
+ *                          LV_RESULT_INVALID: there is no second buffer or there are already
+ *                          `LV_DISPLAY_DRAW_BUF_MAX_CNT` buffers
+ */
+lv_result_t lv_display_add_draw_buffer(lv_display_t * disp, lv_draw_buf_t * buf);
+
+/**
+ * Get the statistics about how long the rendering waited for flushing
+ * @param disp              pointer to a display (NULL to use the default display)
+ * @return                  pointer to the statistics
+ */
+const lv_display_flush_stat_t * lv_display_get_flush_stat(lv_display_t * disp);
+
+/**
+ * Clear the flushing statistics of a display
+ * @param disp              pointer to a display (NULL to use the default display)
+ */
+void lv_display_reset_flush_stat(lv_display_t * disp);
+
+/**
+ * Tell when the display started to show a new frame (vsync or the completion of a page flip).
+ * It can be called from `flush_cb`, from an interrupt or from a vsync callback of the driver.
+ * Once a vsync is reported the refreshing is paced to the vsyncs: the rendering is started to be ready
+ * just before the next vsync and the animations are evaluated for the time when the frame becomes visible.
+ * If no vsync is reported for a while the display is refreshed immediately again.
+ * @param disp              pointer to a display (NULL to use the default display)
+ * @param tick              the time of the vsync in the same time base as `lv_tick_get()`
+ */
+void lv_display_report_vsync(lv_display_t * disp, uint32_t tick);
+
+/**
+ * Set the time between two vsyncs. If not set it's measured from the reported vsyncs.
+ * @param disp              pointer to a display (NULL to use the default display)
+ * @param period_us         the vsync period in microseconds (e.g. 16667 for 60 Hz), or 0 to measure it
+ */
+void lv_display_set_vsync_period(lv_display_t * disp, uint32_t period_us);
+
+/**
+ * Get the statistics of the frames paced to the vsync
+ * @param disp              pointer to a display (NULL to use the default display)
+ * @return                  pointer to the statistics
+ */
+const lv_display_frame_stat_t * lv_display_get_frame_stat(lv_display_t * disp);
+
+/**
+ * Clear the frame statistics of a display
+ * @param disp              pointer to a display (NULL to use the default display)
+ */
+void lv_display_reset_frame_stat(lv_display_t * disp);
+
+/**
+ * Get the number of draw buffers of a display
+ * @param disp              pointer to a display (NULL to use the default display)
+ * @return                  number of draw buffers
+ */
+uint32_t lv_display_get_draw_buffer_count(lv_display_t * disp);
+
+/**
+ * Get a draw buffer of a display. The buffers are rendered in the order of their index.
+ * @param disp              pointer to a display (NULL to use the default display)
+ * @param idx               index of the buffer. 0: `buf1`, 1: `buf2`, 2...: the buffers added by `lv_display_add_draw_buffer`
+ * @return                  pointer to the draw buffer or NULL if not exists
+ */
+lv_draw_buf_t * lv_display_get_draw_buffer(lv_display_t * disp, uint32_t idx);
+
 /**
  * Set display render mode
  * @param disp              pointer to a display
@@ -264,7 +362,9 @@ void lv_display_set_flush_cb(lv_display_t * disp, lv_display_flush_cb_t flush_cb
 /**
  * Set a callback to be used while LVGL is waiting flushing to be finished.
  * It can do any complex logic to wait, including semaphores, mutexes, polling flags, etc.
- * If not set the `disp->flushing` flag is used which can be cleared with `lv_display_flush_ready()`
+ * If `lv_display_flush_ready()` is not called while it runs, all the flushes in progress are
+ * considered finished when it returns. Else it's called until enough flushes are finished.
+ * If not set LVGL waits until `lv_display_flush_ready()` is called.
  * @param disp      pointer to a display
  * @param wait_cb   a callback to call while LVGL is waiting for flush ready.
  *                  If NULL `lv_display_flush_ready()` can be used to signal that flushing is ready.
@@ -305,10 +405,78 @@ void lv_display_set_antialiasing(lv_display_t * disp, bool en);
  */
 bool lv_display_get_antialiasing(lv_display_t * disp);
 
+/**
+ * Render the invalidated areas in square tiles.
+ * The draw tasks covering more tiles are split to a task for each tile, and the tasks of different
+ * tiles never wait for each other, so multiple draw units can work on them in parallel
+ * and the data touched by a draw task stays small.
+ * As each part of a split task is drawn separately, small tiles are expensive with few draw units.
+ * `task_cnt` of `lv_display_get_strip_stat()` shows how many draw tasks were created with the split ones.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param size      width and height of a tile in pixels. 0: don't use tiles
+ */
+void lv_display_set_tile_size(lv_display_t * disp, uint32_t size);
+
+/**
+ * Get the size of the tiles used for rendering
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          the size of the tiles or 0 if tiles are not used
+ */
+uint32_t lv_display_get_tile_size(lv_display_t * disp);
+
+/**
+ * Limit the size of a strip which is rendered at once in `LV_DISPLAY_RENDER_MODE_PARTIAL`.
+ * Around the size of the L2 cache keeps the rendered pixels in the cache. The invalid areas are split
+ * to strips with similar height, but not to more strips than with `LV_DISPLAY_STRIP_MIN_ROWS` rows
+ * as the widgets are walked and their draw tasks are created again for each strip.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param size      max. size of a strip in bytes. 0: fill the whole draw buffer
+ */
+void lv_display_set_strip_size(lv_display_t * disp, uint32_t size);
+
+/**
+ * Get the max. size of a rendered strip
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          the max. size of a strip in bytes or 0 if the whole draw buffer is filled
+ */
+uint32_t lv_display_get_strip_size(lv_display_t * disp);
+
+/**
+ * Get the statistics of rendering in strips. If the draw tasks per strip is close to the draw tasks
+ * of a whole area the same widgets are drawn again in each strip, so taller strips can be faster.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          pointer to the statistics
+ */
+const lv_display_strip_stat_t * lv_display_get_strip_stat(lv_display_t * disp);
+
+/**
+ * Clear the strip statistics of a display
+ * @param disp      pointer to a display (NULL to use the default display)
+ */
+void lv_display_reset_strip_stat(lv_display_t * disp);
+
+/**
+ * Enable moving the already rendered pixels of the scrolled widgets in `LV_DISPLAY_RENDER_MODE_DIRECT`.
+ * If a widget with opaque, flat background is scrolled and nothing is drawn over it
+ * only the area which becomes visible is rendered, the rest is copied in the draw buffer.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param en        true: move the pixels if possible (default); false: always render the whole widget
+ */
+void lv_display_set_scroll_blit(lv_display_t * disp, bool en);
+
+/**
+ * Get whether the pixels of the scrolled widgets are moved instead of rendered
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          true: the pixels are moved if possible
+ */
+bool lv_display_get_scroll_blit(lv_display_t * disp);
+
 //! @cond Doxygen_Suppress
 
 /**
- * Call from the display driver when the flushing is finished
+ * Call from the display driver when the flushing is finished.
+ * With more than 2 draw buffers `flush_cb` can be called again before the previous flush is finished.
+ * In this case call it once for each flush, in the order of the `flush_cb` calls.
  * @param disp      pointer to display whose `flush_cb` was called
  */
 LV_ATTRIBUTE_FLUSH_READY void lv_display_flush_ready(lv_display_t * disp);
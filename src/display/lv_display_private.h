@@ -25,10 +25,80 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas*/
 #endif
 
+#ifndef LV_DISPLAY_DRAW_BUF_MAX_CNT
+#define LV_DISPLAY_DRAW_BUF_MAX_CNT 4 /*Max. number of draw buffers of a display*/
+#endif
+
+#ifndef LV_INV_AREA_COST
+#define LV_INV_AREA_COST 256 /*Fixed cost of refreshing an invalid area in pixels. Used to decide whether to join areas*/
+#endif
+
+#ifndef LV_DISPLAY_STRIP_MIN_ROWS
+#define LV_DISPLAY_STRIP_MIN_ROWS 16 /*Don't make the strips thinner to not walk the widget tree too many times*/
+#endif
+
+#ifndef LV_DISPLAY_STRIP_ROUND_CACHE_CNT
+#define LV_DISPLAY_STRIP_ROUND_CACHE_CNT 4 /*Number of strip heights whose rounding is remembered*/
+#endif
+
+#ifndef LV_DISPLAY_SCROLL_BLIT_MAX
+#define LV_DISPLAY_SCROLL_BLIT_MAX 4 /*Max. number of scrolled areas per frame whose pixels are moved instead of rendered*/
+#endif
+
+#ifndef LV_DISPLAY_VSYNC_MARGIN
+#define LV_DISPLAY_VSYNC_MARGIN 2 /*Time [ms] to be ready earlier than the vsync to tolerate the variance of rendering*/
+#endif
+
+#ifndef LV_DISPLAY_VSYNC_TIMEOUT
+#define LV_DISPLAY_VSYNC_TIMEOUT 8 /*Stop pacing the frames if no vsync was reported for this many vsync periods*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/** A strip height and the height after rounding it with `LV_EVENT_INVALIDATE_AREA`*/
+typedef struct {
+    int32_t row;                    /**< The requested height. 0: unused entry*/
+    int32_t row_rounded;            /**< The largest height which is not more than `row` after rounding*/
+} lv_display_strip_round_t;
+
+/** An area whose already rendered pixels are moved in the next refresh*/
+typedef struct {
+    lv_area_t area;                 /**< The scrolled area*/
+    int32_t dx;                     /**< The pixels are moved by this many pixels horizontally*/
+    int32_t dy;                     /**< The pixels are moved by this many pixels vertically*/
+} lv_display_scroll_blit_t;
+
+/** State of pacing the frames to the vsync of the display*/
+typedef struct {
+    /*Written only by `lv_display_report_vsync()` which can be called from an interrupt.
+     *`irq_vsync_cnt` is incremented after `irq_vsync_tick` is set, so a reader sees a consistent pair
+     *if the counter didn't change while the tick was read.*/
+    volatile uint32_t irq_vsync_tick;   /**< Time of the last reported vsync*/
+    volatile uint32_t irq_vsync_cnt;    /**< Number of the reported vsyncs*/
+
+    /*Used only by the refreshing*/
+    uint32_t vsync_cnt;             /**< Value of `irq_vsync_cnt` when the vsyncs were last taken*/
+    uint32_t vsync_tick;            /**< Time of the last vsync taken from `irq_vsync_tick`*/
+    uint32_t period_us;             /**< Time between two vsyncs [us]. 0: unknown*/
+    uint32_t render_time;           /**< Predicted time of rendering a frame [ms]*/
+    uint32_t deadline;              /**< The vsync for which the last frame was rendered. The animations are evaluated for this time while the display is refreshed*/
+    uint32_t timer_period;          /**< Period of the refresh timer while it's shortened to start a frame in time*/
+    uint32_t vsync_reported : 1;
+    uint32_t period_set : 1;        /**< 1: `period_us` was set by the user and is not measured*/
+    uint32_t deadline_valid : 1;
+    uint32_t waiting : 1;           /**< 1: the refresh timer waits for the start of the frame*/
+    uint32_t paced : 1;             /**< 1: the frame being refreshed is rendered for `deadline`*/
+    lv_display_frame_stat_t stat;
+} lv_display_frame_sched_t;
+
+/** The areas of a draw buffer which are outdated as they were rendered only into the other draw buffers*/
+typedef struct {
+    lv_area_t areas[LV_INV_BUF_SIZE];
+    uint32_t cnt;
+} lv_display_buf_damage_t;
+
 struct _lv_display_t {
 
     /*---------------------
@@ -61,6 +131,10 @@ struct _lv_display_t {
     lv_draw_buf_t * buf_1;
     lv_draw_buf_t * buf_2;
 
+    /** More draw buffers used after `buf_1` and `buf_2` in a ring. See `lv_display_add_draw_buffer()`*/
+    lv_draw_buf_t * buf_extra[LV_DISPLAY_DRAW_BUF_MAX_CNT - 2];
+    uint32_t buf_extra_cnt;
+
     /** Internal, used by the library*/
     lv_draw_buf_t * buf_act;
 
@@ -71,11 +145,18 @@ struct _lv_display_t {
     /**
      * Used to wait while flushing is ready.
      * It can do any complex logic to wait, including semaphores, mutexes, polling flags, etc.
-     * If not set `flushing` flag is used which can be cleared with `lv_display_flush_ready()`*/
+     * If not set LVGL waits until `lv_display_flush_ready()` increments `flush_ready_cnt`*/
     lv_display_flush_wait_cb_t flush_wait_cb;
 
-    /*1: flushing is in progress. (It can't be a bit field because when it's cleared from IRQ Read-Modify-Write issue might occur)*/
-    volatile int flushing;
+    /* Number of `flush_cb` calls and finished flushes. `flush_started_cnt - flush_ready_cnt - flush_waited_cnt`
+     * is the number of flushes in progress. `flush_ready_cnt` is written only by `lv_display_flush_ready()` (maybe from IRQ),
+     * the others only by the refreshing, so there is no Read-Modify-Write issue.*/
+    volatile uint32_t flush_started_cnt;
+    volatile uint32_t flush_ready_cnt;
+    volatile uint32_t flush_waited_cnt;     /**< Flushes finished by returning from `flush_wait_cb` without `lv_display_flush_ready()`*/
+
+    /** Statistics about waiting for flushing*/
+    lv_display_flush_stat_t flush_stat;
 
     /*1: It was the last chunk to flush. (It can't be a bit field because when it's cleared from IRQ Read-Modify-Write issue might occur)*/
     volatile int flushing_last;
@@ -85,6 +166,19 @@ struct _lv_display_t {
     lv_display_render_mode_t render_mode;
     uint32_t antialiasing : 1;       /**< 1: anti-aliasing is enabled on this display.*/
 
+    /** Render the areas in independent tiles of this size. 0: don't use tiles*/
+    uint32_t tile_size;
+
+    /** Max. size of a strip in partial render mode in bytes. 0: fill the whole draw buffer*/
+    uint32_t strip_size;
+
+    /** The remembered rounding of the strip heights*/
+    lv_display_strip_round_t strip_round[LV_DISPLAY_STRIP_ROUND_CACHE_CNT];
+    uint32_t strip_round_next;      /**< The entry of `strip_round` to replace next*/
+
+    /** Statistics of rendering the invalid areas in strips*/
+    lv_display_strip_stat_t strip_stat;
+
     /** 1: The current screen rendering is in progress*/
     uint32_t rendering_in_progress : 1;
 
@@ -96,8 +190,13 @@ struct _lv_display_t {
     uint32_t inv_p;
     int32_t inv_en_cnt;
 
-    /** Double buffer sync areas (redrawn during last refresh) */
-    lv_ll_t sync_areas;
+    /** Scrolled areas whose pixels are moved in the draw buffer in direct mode, in the order of scrolling*/
+    lv_display_scroll_blit_t scroll_blits[LV_DISPLAY_SCROLL_BLIT_MAX];
+    uint32_t scroll_blit_cnt;
+    uint32_t scroll_blit_en : 1;    /**< 1: move the pixels of the scrolled areas if possible*/
+
+    /** In direct mode with more buffers the damage of each buffer. Allocated on the first use.*/
+    lv_display_buf_damage_t * buf_damage;
 
     lv_draw_buf_t _static_buf1; /*Used when user pass in a raw buffer as display draw buffer*/
     lv_draw_buf_t _static_buf2;
@@ -143,6 +242,9 @@ struct _lv_display_t {
     /** A timer which periodically checks the dirty areas and refreshes them*/
     lv_timer_t * refr_timer;
 
+    /** Pacing the refreshing to the vsyncs reported by the driver*/
+    lv_display_frame_sched_t frame_sched;
+
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
 
@@ -7,25 +7,79 @@
  *      INCLUDES
  *********************/
 #include "lv_draw.h"
+#include "lv_draw_list.h"
+#include "lv_draw_layer_cache.h"
+#include "lv_draw_trace.h"
 #include "sw/lv_draw_sw.h"
 #include "../display/lv_display_private.h"
 #include "../core/lv_global.h"
 #include "../core/lv_refr.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/lv_math.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+/*The layers are divided into a grid of this many columns and rows to quickly find the overlapping draw tasks.
+ *Can't be more than 32 as a row of cells is stored in an `uint32_t`*/
+#define DEP_GRID_SIZE   32
+
+/*Marks the empty cells of the dependency grid*/
+#define DEP_SEQ_NONE    0xFFFF
+
+/*The tasks after this many unfinished tasks get the same sequence number and they are never independent*/
+#define DEP_SEQ_MAX     (DEP_SEQ_NONE - 1)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_TASK_POOL_CNT
+/*Used only to get the size of the largest draw descriptor*/
+typedef union {
+    lv_draw_fill_dsc_t fill;
+    lv_draw_border_dsc_t border;
+    lv_draw_box_shadow_dsc_t box_shadow;
+    lv_draw_label_dsc_t label;
+    lv_draw_image_dsc_t image;
+    lv_draw_line_dsc_t line;
+    lv_draw_arc_dsc_t arc;
+    lv_draw_triangle_dsc_t triangle;
+    lv_draw_mask_rect_dsc_t mask_rect;
+#if LV_USE_VECTOR_GRAPHIC
+    lv_draw_vector_task_dsc_t vector;
+#endif
+} draw_dsc_union_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
+static void set_grid_cells(lv_layer_t * layer, lv_draw_task_t * t);
+static void schedule_task(lv_layer_t * layer, lv_draw_task_t * t);
+static void schedule_task_in_tiles(lv_layer_t * layer, lv_draw_task_t * t);
+static void queue_new_tasks(lv_layer_t * layer);
+static void queue_tasks_out_of_cull_window(lv_layer_t * layer);
+static inline bool is_new_task(const lv_draw_task_t * t);
+static lv_draw_task_t * merge_with_prev_task(lv_layer_t * layer, lv_draw_task_t * t);
+static bool is_mergeable_dsc(const lv_draw_task_t * t1, const lv_draw_task_t * t2, bool * hor, bool * ver);
+static void free_task(lv_draw_task_t * t);
+static void cull_covered_tasks(lv_layer_t * layer, lv_draw_task_t * t);
+static bool get_cover_area(const lv_draw_task_t * t, lv_area_t * cover_area);
+static void dep_grid_init(lv_layer_t * layer);
+static void dep_grid_add_task(lv_layer_t * layer, lv_draw_task_t * t);
+static void dep_grid_remove_task(lv_layer_t * layer, lv_draw_task_t * t);
+static void dep_grid_rebuild(lv_layer_t * layer);
+static bool dep_grid_is_independent(const lv_layer_t * layer, const lv_draw_task_t * t);
+#if LV_DRAW_TASK_POOL_CNT
+    static void pool_init(lv_draw_pool_t * pool, size_t block_size);
+    static void pool_deinit(lv_draw_pool_t * pool);
+    static void * pool_alloc(lv_draw_pool_t * pool, size_t size);
+    static void pool_free(lv_draw_pool_t * pool, void * p);
+    static void pool_monitor(const lv_draw_pool_t * pool, lv_draw_pool_monitor_t * mon);
+#endif
 
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
 {
@@ -51,6 +105,17 @@ void lv_draw_init(void)
 {
 #if LV_USE_OS
     lv_thread_sync_init(&_draw_info.sync);
+#endif
+    lv_mutex_init(&_draw_info.task_list_mutex);
+    lv_mutex_init(&_draw_info.layer_mem_mutex);
+
+#if LV_DRAW_TASK_POOL_CNT
+    pool_init(&_draw_info.task_pool, sizeof(lv_draw_task_t));
+    pool_init(&_draw_info.dsc_pool, sizeof(draw_dsc_union_t));
+#endif
+
+#if LV_USE_DRAW_TRACE
+    lv_draw_trace_init();
 #endif
 }
 
@@ -59,6 +124,17 @@ void lv_draw_deinit(void)
 #if LV_USE_OS
     lv_thread_sync_delete(&_draw_info.sync);
 #endif
+    lv_mutex_delete(&_draw_info.task_list_mutex);
+    lv_mutex_delete(&_draw_info.layer_mem_mutex);
+
+#if LV_DRAW_TASK_POOL_CNT
+    pool_deinit(&_draw_info.task_pool);
+    pool_deinit(&_draw_info.dsc_pool);
+#endif
+
+#if LV_USE_DRAW_TRACE
+    lv_draw_trace_deinit();
+#endif
 
     lv_draw_unit_t * u = _draw_info.unit_head;
     while(u) {
@@ -84,14 +160,22 @@ void * lv_draw_create_unit(size_t size)
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 {
     LV_PROFILER_BEGIN;
+#if LV_DRAW_TASK_POOL_CNT
+    lv_draw_task_t * new_task = pool_alloc(&_draw_info.task_pool, sizeof(lv_draw_task_t));
+    LV_ASSERT_MALLOC(new_task);
+    lv_memzero(new_task, sizeof(lv_draw_task_t));
+#else
     lv_draw_task_t * new_task = lv_malloc_zeroed(sizeof(lv_draw_task_t));
+#endif
 
     new_task->area = *coords;
     new_task->_real_area = *coords;
     new_task->clip_area = layer->_clip_area;
-    new_task->state = LV_DRAW_TASK_STATE_QUEUED;
+    /*Don't let the draw units take it until it's finalized*/
+    new_task->state = LV_DRAW_TASK_STATE_WAITING;
 
     /*Find the tail*/
+    lv_mutex_lock(&_draw_info.task_list_mutex);
     if(layer->draw_task_head == NULL) {
         layer->draw_task_head = new_task;
     }
@@ -102,77 +186,128 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
         tail->next = new_task;
     }
 
+    /*Until its real area is known block all the later tasks*/
+    if(layer->_dep_grid == NULL) dep_grid_init(layer);
+    new_task->_dep_seq = layer->_dep_seq_next;
+    if(layer->_dep_seq_next < DEP_SEQ_MAX) layer->_dep_seq_next++;
+    if(layer->_dep_barrier == DEP_SEQ_NONE) layer->_dep_barrier = new_task->_dep_seq;
+    _draw_info.task_cnt++;
+    lv_mutex_unlock(&_draw_info.task_list_mutex);
+
     LV_PROFILER_END;
     return new_task;
 }
 
+void * lv_draw_dsc_alloc(size_t size)
+{
+#if LV_DRAW_TASK_POOL_CNT
+    return pool_alloc(&_draw_info.dsc_pool, size);
+#else
+    return lv_malloc(size);
+#endif
+}
+
+void lv_draw_dsc_free(void * dsc)
+{
+#if LV_DRAW_TASK_POOL_CNT
+    pool_free(&_draw_info.dsc_pool, dsc);
+#else
+    lv_free(dsc);
+#endif
+}
+
+void lv_draw_pool_monitor(lv_draw_pool_monitor_t * task_mon, lv_draw_pool_monitor_t * dsc_mon)
+{
+    if(task_mon) lv_memzero(task_mon, sizeof(lv_draw_pool_monitor_t));
+    if(dsc_mon) lv_memzero(dsc_mon, sizeof(lv_draw_pool_monitor_t));
+
+#if LV_DRAW_TASK_POOL_CNT
+    if(task_mon) pool_monitor(&_draw_info.task_pool, task_mon);
+    if(dsc_mon) pool_monitor(&_draw_info.dsc_pool, dsc_mon);
+#endif
+}
+
 void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
 {
     LV_PROFILER_BEGIN;
     lv_draw_dsc_base_t * base_dsc = t->draw_dsc;
     base_dsc->layer = layer;
+    /*The descriptor might be copied from the descriptor of an other task*/
+    base_dsc->_tile_copy_cnt = 0;
 
     lv_draw_global_info_t * info = &_draw_info;
 
-    /*Send LV_EVENT_DRAW_TASK_ADDED and dispatch only on the "main" draw_task
+#if LV_USE_DRAW_LIST
+    if(info->rec_list) _lv_draw_list_record_task(layer, t);
+#endif
+
+    /*Send LV_EVENT_DRAW_TASK_ADDED only on the "main" draw_task
      *and not on the draw tasks added in the event.
-     *Sending LV_EVENT_DRAW_TASK_ADDED events might cause recursive event sends and besides
-     *dispatching might remove the "main" draw task while it's still being used in the event*/
-
-    if(info->task_running == false) {
-        if(base_dsc->obj && lv_obj_has_flag(base_dsc->obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) {
-            info->task_running = true;
-            lv_obj_send_event(base_dsc->obj, LV_EVENT_DRAW_TASK_ADDED, t);
-            info->task_running = false;
-        }
+     *Sending LV_EVENT_DRAW_TASK_ADDED events might cause recursive event sends*/
+    if(info->task_running == false && base_dsc->obj &&
+       lv_obj_has_flag(base_dsc->obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) {
+        info->task_running = true;
+        lv_obj_send_event(base_dsc->obj, LV_EVENT_DRAW_TASK_ADDED, t);
+        info->task_running = false;
+    }
 
-        /*Let the draw units set their preference score*/
-        t->preference_score = 100;
-        t->preferred_draw_unit_id = 0;
-        lv_draw_unit_t * u = info->unit_head;
-        while(u) {
-            if(u->evaluate_cb) u->evaluate_cb(u, t);
-            u = u->next;
-        }
+    set_grid_cells(layer, t);
 
-        lv_draw_dispatch();
-    }
-    else {
-        /*Let the draw units set their preference score*/
-        t->preference_score = 100;
-        t->preferred_draw_unit_id = 0;
-        lv_draw_unit_t * u = info->unit_head;
-        while(u) {
-            if(u->evaluate_cb) u->evaluate_cb(u, t);
-            u = u->next;
-        }
+    /*Let the draw units set their preference score*/
+    t->preference_score = 100;
+    t->preferred_draw_unit_id = 0;
+    lv_draw_unit_t * u = info->unit_head;
+    while(u) {
+        if(u->evaluate_cb) u->evaluate_cb(u, t);
+        u = u->next;
     }
+
+    /*It's not dispatched until it's in the cull window, so the later tasks of the layer can still cull or merge it*/
+    if(layer->_tile_size) schedule_task_in_tiles(layer, t);
+    else schedule_task(layer, t);
+
+    /*Wake up the dispatcher which waits for the new tasks*/
+    lv_draw_dispatch_request();
     LV_PROFILER_END;
 }
 
 void lv_draw_dispatch(void)
 {
     LV_PROFILER_BEGIN;
-    bool render_running = false;
     lv_display_t * disp = lv_display_get_next(NULL);
     while(disp) {
-        lv_layer_t * layer = disp->layer_head;
-        while(layer) {
-            if(lv_draw_dispatch_layer(disp, layer))
-                render_running = true;
-            layer = layer->next;
-        }
-        if(!render_running) {
-            lv_draw_dispatch_request();
-        }
+        lv_draw_dispatch_display(disp);
         disp = lv_display_get_next(disp);
     }
     LV_PROFILER_END;
 }
 
+bool lv_draw_dispatch_display(lv_display_t * disp)
+{
+    LV_PROFILER_BEGIN;
+    bool render_running = false;
+    lv_layer_t * layer = disp->layer_head;
+    while(layer) {
+        if(lv_draw_dispatch_layer(disp, layer))
+            render_running = true;
+        layer = layer->next;
+    }
+    if(!render_running) {
+        lv_draw_dispatch_request();
+    }
+    LV_PROFILER_END;
+    return render_running;
+}
+
 bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
 {
     LV_PROFILER_BEGIN;
+    /*The draw threads might take tasks from this list by themselves*/
+    lv_mutex_lock(&_draw_info.task_list_mutex);
+
+    /*Let the draw units take the new tasks*/
+    queue_new_tasks(layer);
+
     /*Remove the finished tasks first*/
     lv_draw_task_t * t_prev = NULL;
     lv_draw_task_t * t = layer->draw_task_head;
@@ -182,18 +317,25 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
             if(t_prev) t_prev->next = t->next;      /*Remove by it by assigning the next task to the previous*/
             else layer->draw_task_head = t_next;    /*If it was the head, set the next as head*/
 
-            /*If it was layer drawing free the layer too*/
-            if(t->type == LV_DRAW_TASK_TYPE_LAYER) {
+            /*If it was layer drawing free the layer too. If it was split to tiles, only after the last tile.*/
+            lv_draw_dsc_base_t * base_dsc = t->draw_dsc;
+            if(t->type == LV_DRAW_TASK_TYPE_LAYER && base_dsc->_tile_copy_cnt == 0) {
                 lv_draw_image_dsc_t * draw_image_dsc = t->draw_dsc;
                 lv_layer_t * layer_drawn = (lv_layer_t *)draw_image_dsc->src;
 
-                if(layer_drawn->draw_buf) {
+                if(layer_drawn->cache_entry) {
+                    lv_draw_layer_cache_release(layer_drawn->cache_entry);
+                    layer_drawn->draw_buf = NULL;
+                }
+                else if(layer_drawn->draw_buf) {
                     int32_t h = lv_area_get_height(&layer_drawn->buf_area);
                     int32_t w = lv_area_get_width(&layer_drawn->buf_area);
                     uint32_t layer_size_byte = h * lv_draw_buf_width_to_stride(w, layer_drawn->color_format);
 
+                    lv_mutex_lock(&_draw_info.layer_mem_mutex);
                     _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(layer_size_byte);
                     LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
+                    lv_mutex_unlock(&_draw_info.layer_mem_mutex);
                     lv_draw_buf_destroy(layer_drawn->draw_buf);
                     layer_drawn->draw_buf = NULL;
                 }
@@ -213,14 +355,7 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
                     lv_free(layer_drawn);
                 }
             }
-            lv_draw_label_dsc_t * draw_label_dsc = lv_draw_task_get_label_dsc(t);
-            if(draw_label_dsc && draw_label_dsc->text_local) {
-                lv_free((void *)draw_label_dsc->text);
-                draw_label_dsc->text = NULL;
-            }
-
-            lv_free(t->draw_dsc);
-            lv_free(t);
+            free_task(t);
         }
         else {
             t_prev = t;
@@ -228,26 +363,43 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
         t = t_next;
     }
 
+    /*The grid is needed again only when new tasks are added*/
+    if(layer->draw_task_head == NULL && layer->_dep_grid) {
+        lv_free(layer->_dep_grid);
+        layer->_dep_grid = NULL;
+    }
+    /*The sequence numbers ran out. Number the remaining tasks again now that the finished ones are removed.*/
+    else if(layer->_dep_seq_next == DEP_SEQ_MAX) {
+        layer->_dep_grid_invalid = true;
+    }
+
     bool render_running = false;
 
     /*This layer is ready, enable blending its buffer*/
     if(layer->parent && layer->all_tasks_added && layer->draw_task_head == NULL) {
-        /*Find a draw task with TYPE_LAYER in the layer where the src is this layer*/
+        /*Find the draw tasks with TYPE_LAYER in the layer where the src is this layer.
+         *There is one for each tile if the task was split to tiles.*/
         lv_draw_task_t * t_src = layer->parent->draw_task_head;
         while(t_src) {
             if(t_src->type == LV_DRAW_TASK_TYPE_LAYER && t_src->state == LV_DRAW_TASK_STATE_WAITING) {
                 lv_draw_image_dsc_t * draw_dsc = t_src->draw_dsc;
                 if(draw_dsc->src == layer) {
                     t_src->state = LV_DRAW_TASK_STATE_QUEUED;
+#if LV_USE_DRAW_TRACE
+                    _lv_draw_trace_task_queued(t_src);
+#endif
                     lv_draw_dispatch_request();
-                    break;
+                    if(draw_dsc->base._tile_copy_cnt == 0) break;
                 }
             }
             t_src = t_src->next;
         }
+        lv_mutex_unlock(&_draw_info.task_list_mutex);
     }
     /*Assign draw tasks to the draw_units*/
     else {
+        lv_mutex_unlock(&_draw_info.task_list_mutex);
+
         /*Find a draw unit which is not busy and can take at least one task*/
         /*Let all draw units to pick draw tasks*/
         lv_draw_unit_t * u = _draw_info.unit_head;
@@ -281,31 +433,61 @@ void lv_draw_dispatch_request(void)
 #endif
 }
 
+void lv_draw_queue_layer_tasks(lv_layer_t * layer)
+{
+    lv_mutex_lock(&_draw_info.task_list_mutex);
+    queue_new_tasks(layer);
+    lv_mutex_unlock(&_draw_info.task_list_mutex);
+}
+
 lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_task_t * t_prev, uint8_t draw_unit_id)
+{
+    /*The render threads can change the list and the states of the tasks at any time*/
+    lv_mutex_lock(&_draw_info.task_list_mutex);
+    lv_draw_task_t * t = _lv_draw_get_next_available_task(layer, t_prev, draw_unit_id);
+    lv_mutex_unlock(&_draw_info.task_list_mutex);
+
+    return t;
+}
+
+lv_draw_task_t * _lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_task_t * t_prev, uint8_t draw_unit_id)
 {
     LV_PROFILER_BEGIN;
-    /*If the first task is screen sized, there cannot be independent areas*/
+    /*If the first task covers the whole layer, there cannot be independent areas*/
     if(layer->draw_task_head) {
-        int32_t hor_res = lv_display_get_horizontal_resolution(_lv_refr_get_disp_refreshing());
-        int32_t ver_res = lv_display_get_vertical_resolution(_lv_refr_get_disp_refreshing());
         lv_draw_task_t * t = layer->draw_task_head;
-        if(t->state != LV_DRAW_TASK_STATE_QUEUED &&
-           t->area.x1 <= 0 && t->area.x2 >= hor_res - 1 &&
-           t->area.y1 <= 0 && t->area.y2 >= ver_res - 1) {
+        if(t->state != LV_DRAW_TASK_STATE_QUEUED && _lv_area_is_in(&layer->buf_area, &t->area, 0)) {
             LV_PROFILER_END;
             return NULL;
         }
     }
 
-    lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
+    /*The grid is updated when the tasks are finished. It's rebuilt only in the rare cases when it couldn't be updated.*/
+    if(layer->_dep_grid && layer->_dep_grid_invalid) dep_grid_rebuild(layer);
+
+    /*Only the tasks after `t_prev` can be returned*/
+    bool search = t_prev == NULL;
+    lv_draw_task_t * t = layer->draw_task_head;
     while(t) {
         /*Find a queued and independent task*/
-        if(t->state == LV_DRAW_TASK_STATE_QUEUED &&
-           (t->preferred_draw_unit_id == LV_DRAW_UNIT_ID_ANY || t->preferred_draw_unit_id == draw_unit_id) &&
-           is_independent(layer, t)) {
-            LV_PROFILER_END;
-            return t;
+        if(search && t->state == LV_DRAW_TASK_STATE_QUEUED &&
+           (t->preferred_draw_unit_id == LV_DRAW_UNIT_ID_ANY || t->preferred_draw_unit_id == draw_unit_id)) {
+            if(dep_grid_is_independent(layer, t)) {
+                LV_PROFILER_END;
+                return t;
+            }
         }
+
+        if(layer->_dep_grid) {
+            /*All the later tasks wait for a not finalized task*/
+            if(t->_dep_seq >= layer->_dep_barrier) break;
+        }
+        else {
+            /*Without a grid (out of memory) only the first unfinished task is independent*/
+            if(t->state != LV_DRAW_TASK_STATE_READY) break;
+        }
+
+        if(t == t_prev) search = true;
         t = t->next;
     }
 
@@ -316,11 +498,11 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
 {
     if(t_check == NULL) return 0;
-    if(t_check->next == NULL) return 0;
 
     LV_PROFILER_BEGIN;
     uint32_t cnt = 0;
 
+    lv_mutex_lock(&_draw_info.task_list_mutex);
     lv_draw_task_t * t = t_check->next;
     while(t) {
         if((t->state == LV_DRAW_TASK_STATE_QUEUED || t->state == LV_DRAW_TASK_STATE_WAITING) &&
@@ -330,18 +512,42 @@ uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
 
         t = t->next;
     }
+    lv_mutex_unlock(&_draw_info.task_list_mutex);
     LV_PROFILER_END;
     return cnt;
 }
 
+void lv_draw_task_set_state(lv_draw_task_t * t, lv_draw_task_state_t state)
+{
+    lv_mutex_lock(&_draw_info.task_list_mutex);
+    _lv_draw_task_set_state(t, state);
+    lv_mutex_unlock(&_draw_info.task_list_mutex);
+}
+
+void _lv_draw_task_set_state(lv_draw_task_t * t, lv_draw_task_state_t state)
+{
+    t->state = state;
+    if(state == LV_DRAW_TASK_STATE_READY) {
+        lv_draw_dsc_base_t * base_dsc = t->draw_dsc;
+        dep_grid_remove_task(base_dsc->layer, t);
+    }
+}
+
 lv_layer_t * lv_draw_layer_create(lv_layer_t * parent_layer, lv_color_format_t color_format, const lv_area_t * area)
 {
-    lv_display_t * disp = _lv_refr_get_disp_refreshing();
+    /*The new layer is rendered for the display of its parent.
+     *Only the layers created by the user might have no display.*/
+    lv_display_t * disp = parent_layer ? parent_layer->disp : NULL;
+    if(disp == NULL) disp = lv_display_get_default();
+    LV_ASSERT_NULL(disp);
+    if(disp == NULL) return NULL;
+
     lv_layer_t * new_layer = lv_malloc_zeroed(sizeof(lv_layer_t));
     LV_ASSERT_MALLOC(new_layer);
     if(new_layer == NULL) return NULL;
 
     new_layer->parent = parent_layer;
+    new_layer->disp = disp;
     new_layer->_clip_area = *area;
     new_layer->buf_area = *area;
     new_layer->color_format = color_format;
@@ -370,15 +576,25 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
     int32_t h = lv_area_get_height(&layer->buf_area);
     uint32_t layer_size_byte = h * lv_draw_buf_width_to_stride(w, layer->color_format);
 
+    /*The draw threads allocate layers while the main thread adds and drops cached layers*/
+    lv_mutex_lock(&_draw_info.layer_mem_mutex);
+
+    /*Drop cached layers if needed. The layer is allocated anyway as it's needed to render the widget.*/
+    if(!_lv_draw_layer_cache_make_room(layer_size_byte)) {
+        LV_LOG_INFO("The layers use more memory than LV_DRAW_LAYER_MAX_MEMORY");
+    }
+
     layer->draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
 
     if(layer->draw_buf == NULL) {
+        lv_mutex_unlock(&_draw_info.layer_mem_mutex);
         LV_LOG_WARN("Allocating layer buffer failed. Try later");
         return NULL;
     }
 
     _draw_info.used_memory_for_layers_kb += get_layer_size_kb(layer_size_byte);
     LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB\n", _draw_info.used_memory_for_layers_kb);
+    lv_mutex_unlock(&_draw_info.layer_mem_mutex);
 
     if(lv_color_format_has_alpha(layer->color_format)) {
         lv_draw_buf_clear(layer->draw_buf, NULL);
@@ -397,28 +613,652 @@ void * lv_draw_layer_go_to_xy(lv_layer_t * layer, int32_t x, int32_t y)
  **********************/
 
 /**
- * Check if there are older draw task overlapping the area of `t_check`
- * @param layer      the draw ctx to search in
- * @param t_check       check this task if it overlaps with the older ones
- * @return              true: `t_check` is not overlapping with older tasks so it's independent
+ * Merge a finalized draw task into an earlier one if possible and add it to the dependency grid.
+ * If it's not merged it culls the earlier tasks which are not taken yet and it gets into the cull window.
+ * The tasks pushed out of the window are queued.
+ * @param layer     the layer of the draw task
+ * @param t         the finalized draw task. Might be freed if it's merged into an other task.
  */
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
+static void schedule_task(lv_layer_t * layer, lv_draw_task_t * t)
 {
-    LV_PROFILER_BEGIN;
-    lv_draw_task_t * t = layer->draw_task_head;
+    lv_draw_task_t * t_merged = merge_with_prev_task(layer, t);
 
-    /*If t_check is outside of the older tasks then it's independent*/
-    while(t && t != t_check) {
-        if(t->state != LV_DRAW_TASK_STATE_READY) {
-            lv_area_t a;
-            if(_lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
-                LV_PROFILER_END;
-                return false;
+    lv_mutex_lock(&_draw_info.task_list_mutex);
+    if(t_merged) {
+        dep_grid_add_task(layer, t_merged);
+    }
+    else {
+        dep_grid_add_task(layer, t);
+        cull_covered_tasks(layer, t);
+        if(is_new_task(t)) layer->_cull_window_cnt++;
+        queue_tasks_out_of_cull_window(layer);
+    }
+    lv_mutex_unlock(&_draw_info.task_list_mutex);
+}
+
+/**
+ * Split a finalized draw task to a task for each tile of the layer where it can draw.
+ * The tasks of different tiles never overlap, so the draw units can draw the tiles in parallel.
+ * The tasks share the draw descriptor (and the layer to draw for `LV_DRAW_TASK_TYPE_LAYER`),
+ * which is freed with the last of them.
+ * @param layer     the layer of the draw task with `_tile_size` set
+ * @param t         the finalized draw task. Might be freed if it's merged into an other task.
+ */
+static void schedule_task_in_tiles(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    /*The tasks added in LV_EVENT_DRAW_TASK_ADDED are already after it, so the copies can't be added after them*/
+    lv_area_t a;
+    if(t->next || !_lv_area_intersect(&a, &t->_real_area, &t->clip_area)) {
+        schedule_task(layer, t);
+        return;
+    }
+
+    int32_t tile_size = layer->_tile_size;
+    int32_t col1 = LV_MAX(a.x1 - layer->buf_area.x1, 0) / tile_size;
+    int32_t row1 = LV_MAX(a.y1 - layer->buf_area.y1, 0) / tile_size;
+    int32_t col2 = LV_MAX(a.x2 - layer->buf_area.x1, 0) / tile_size;
+    int32_t row2 = LV_MAX(a.y2 - layer->buf_area.y1, 0) / tile_size;
+    if(col1 == col2 && row1 == row2) {
+        schedule_task(layer, t);
+        return;
+    }
+
+    /*`t` might be merged and freed, so save what the copies need*/
+    lv_draw_task_t t_orig = *t;
+    lv_draw_dsc_base_t * base_dsc = t->draw_dsc;
+    base_dsc->_tile_copy_cnt = (col2 - col1 + 1) * (row2 - row1 + 1) - 1;
+
+    int32_t row;
+    int32_t col;
+    for(row = row1; row <= row2; row++) {
+        for(col = col1; col <= col2; col++) {
+            lv_area_t tile_area;
+            tile_area.x1 = layer->buf_area.x1 + col * tile_size;
+            tile_area.y1 = layer->buf_area.y1 + row * tile_size;
+            tile_area.x2 = tile_area.x1 + tile_size - 1;
+            tile_area.y2 = tile_area.y1 + tile_size - 1;
+
+            lv_draw_task_t * t_tile = t;
+            if(row != row1 || col != col1) {
+                t_tile = lv_draw_add_task(layer, &t_orig.area);
+                t_tile->type = t_orig.type;
+                t_tile->draw_dsc = t_orig.draw_dsc;
+                t_tile->_real_area = t_orig._real_area;
+                t_tile->preferred_draw_unit_id = t_orig.preferred_draw_unit_id;
+                t_tile->preference_score = t_orig.preference_score;
             }
+
+            /*The tile is in the bounding box of the drawn area, so it's on the clip area too*/
+            _lv_area_intersect(&t_tile->clip_area, &t_orig.clip_area, &tile_area);
+            set_grid_cells(layer, t_tile);
+            schedule_task(layer, t_tile);
         }
+    }
+}
+
+/**
+ * Let the draw units take all the tasks which were finalized since the layer was last dispatched.
+ * `task_list_mutex` needs to be locked.
+ * @param layer     pointer to a layer
+ */
+static void queue_new_tasks(lv_layer_t * layer)
+{
+    lv_draw_task_t * t;
+    for(t = layer->draw_task_head; t; t = t->next) {
+        if(!is_new_task(t)) continue;
+
+#if LV_USE_DRAW_TRACE
+        _lv_draw_trace_task_queued(t);
+#endif
+        t->state = LV_DRAW_TASK_STATE_QUEUED;
+    }
+
+    /*The finished tasks are removed after this so don't keep a pointer to them*/
+    layer->_cull_window_cnt = 0;
+    layer->_cull_window_prev = NULL;
+}
+
+/**
+ * Queue the oldest finalized tasks until only `LV_DRAW_CULL_WINDOW` tasks are kept back.
+ * This way the draw units can work while the later tasks are created, but the newest tasks
+ * can still be culled. `task_list_mutex` needs to be locked.
+ * @param layer     pointer to a layer
+ */
+static void queue_tasks_out_of_cull_window(lv_layer_t * layer)
+{
+    lv_draw_task_t * t_prev = layer->_cull_window_prev;
+    lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
+    while(t) {
+        /*Keep the order: the later tasks are queued after this task is finalized*/
+        if(!t->_dep_in_grid) break;
+
+        if(is_new_task(t)) {
+            if(layer->_cull_window_cnt <= LV_DRAW_CULL_WINDOW) break;
+#if LV_USE_DRAW_TRACE
+            _lv_draw_trace_task_queued(t);
+#endif
+            t->state = LV_DRAW_TASK_STATE_QUEUED;
+            layer->_cull_window_cnt--;
+        }
+
+        t_prev = t;
         t = t->next;
     }
+
+    layer->_cull_window_prev = t_prev;
+}
+
+/**
+ * Check if a draw task is finalized but not queued yet.
+ * Layer draw tasks are queued only when their layer is rendered.
+ * @param t     pointer to a draw task
+ * @return      true: the task is waiting to be queued
+ */
+static inline bool is_new_task(const lv_draw_task_t * t)
+{
+    return t->state == LV_DRAW_TASK_STATE_WAITING && t->_dep_in_grid && t->type != LV_DRAW_TASK_TYPE_LAYER;
+}
+
+/**
+ * Merge a fill or border draw task into an earlier task of the layer
+ * if they look the same and together they form a rectangle.
+ * E.g. the cells of a table or the buttons of a button matrix.
+ * The tasks between them shouldn't overlap with the new task, as it will be drawn earlier.
+ * @param layer     the layer of the draw task
+ * @param t         the new draw task, the tail of the layer's task list
+ * @return          the earlier task which was extended by `t` (and `t` was freed), or NULL if not merged
+ */
+static lv_draw_task_t * merge_with_prev_task(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    if(t->type != LV_DRAW_TASK_TYPE_FILL && t->type != LV_DRAW_TASK_TYPE_BORDER) return NULL;
+
+    lv_mutex_lock(&_draw_info.task_list_mutex);
+    if(t->next != NULL) {
+        lv_mutex_unlock(&_draw_info.task_list_mutex);
+        return NULL;
+    }
+
+    lv_draw_task_t * t_merge = NULL;
+    lv_draw_task_t * t_before = NULL;
+    lv_draw_task_t * t_act;
+    for(t_act = layer->draw_task_head; t_act != t; t_act = t_act->next) {
+        t_before = t_act;
+        if(t_merge && _lv_area_is_on(&t_act->_real_area, &t->_real_area)) t_merge = NULL;
+
+        /*Only the tasks which weren't taken by a draw unit can be changed*/
+        if(t_act->state != LV_DRAW_TASK_STATE_QUEUED && !is_new_task(t_act)) continue;
+
+        bool hor = false;
+        bool ver = false;
+        if(!is_mergeable_dsc(t_act, t, &hor, &ver)) continue;
+
+        const lv_area_t * a1 = &t_act->area;
+        const lv_area_t * a2 = &t->area;
+        if(hor && a1->y1 == a2->y1 && a1->y2 == a2->y2 && (a1->x2 + 1 == a2->x1 || a2->x2 + 1 == a1->x1)) t_merge = t_act;
+        if(ver && a1->x1 == a2->x1 && a1->x2 == a2->x2 && (a1->y2 + 1 == a2->y1 || a2->y2 + 1 == a1->y1)) t_merge = t_act;
+    }
+
+    if(t_merge) {
+        _lv_area_join(&t_merge->area, &t_merge->area, &t->area);
+        _lv_area_join(&t_merge->_real_area, &t_merge->_real_area, &t->_real_area);
+        set_grid_cells(layer, t_merge);
+        t_before->next = NULL;
+
+        /*`t` was the newest task so nothing else was waiting for it*/
+        if(layer->_dep_barrier == t->_dep_seq) layer->_dep_barrier = DEP_SEQ_NONE;
+    }
+    lv_mutex_unlock(&_draw_info.task_list_mutex);
+
+    if(t_merge == NULL) return NULL;
+
+    free_task(t);
+    return t_merge;
+}
+
+/**
+ * Check if two fill or border tasks draw the same on any area
+ * @param t1        pointer to a draw task
+ * @param t2        pointer to an other draw task
+ * @param hor       set to true if the tasks can be merged horizontally
+ * @param ver       set to true if the tasks can be merged vertically
+ * @return          true: the tasks can be merged in at least one direction
+ */
+static bool is_mergeable_dsc(const lv_draw_task_t * t1, const lv_draw_task_t * t2, bool * hor, bool * ver)
+{
+    if(t1->type != t2->type) return false;
+    if(t1->preferred_draw_unit_id != t2->preferred_draw_unit_id) return false;
+    if(!_lv_area_is_equal(&t1->clip_area, &t2->clip_area)) return false;
+
+    if(t1->type == LV_DRAW_TASK_TYPE_FILL) {
+        const lv_draw_fill_dsc_t * dsc1 = t1->draw_dsc;
+        const lv_draw_fill_dsc_t * dsc2 = t2->draw_dsc;
+        if(dsc1->radius != 0 || dsc2->radius != 0) return false;
+        if(dsc1->grad.dir != LV_GRAD_DIR_NONE || dsc2->grad.dir != LV_GRAD_DIR_NONE) return false;
+        if(dsc1->opa != dsc2->opa || !lv_color_eq(dsc1->color, dsc2->color)) return false;
+        *hor = true;
+        *ver = true;
+    }
+    else {
+        const lv_draw_border_dsc_t * dsc1 = t1->draw_dsc;
+        const lv_draw_border_dsc_t * dsc2 = t2->draw_dsc;
+        if(dsc1->radius != 0 || dsc2->radius != 0) return false;
+        if(dsc1->width != dsc2->width || dsc1->side != dsc2->side) return false;
+        if(dsc1->opa != dsc2->opa || !lv_color_eq(dsc1->color, dsc2->color)) return false;
+        /*E.g. the bottom borders of the cells in a row can be drawn as one border*/
+        *hor = (dsc1->side & (LV_BORDER_SIDE_LEFT | LV_BORDER_SIDE_RIGHT)) == 0;
+        *ver = (dsc1->side & (LV_BORDER_SIDE_TOP | LV_BORDER_SIDE_BOTTOM)) == 0;
+    }
+
+    return *hor || *ver;
+}
+
+/**
+ * Free a draw task and its draw descriptor
+ * @param t     pointer to a draw task which is already removed from its layer
+ */
+static void free_task(lv_draw_task_t * t)
+{
+    /*The tasks of the tiles share the descriptor, it's freed with the last of them*/
+    lv_draw_dsc_base_t * base_dsc = t->draw_dsc;
+    if(base_dsc->_tile_copy_cnt) {
+        base_dsc->_tile_copy_cnt--;
+    }
+    else {
+        lv_draw_label_dsc_t * draw_label_dsc = lv_draw_task_get_label_dsc(t);
+        if(draw_label_dsc && draw_label_dsc->text_local) {
+            lv_free((void *)draw_label_dsc->text);
+            draw_label_dsc->text = NULL;
+        }
+
+        lv_draw_dsc_free(t->draw_dsc);
+    }
+
+#if LV_DRAW_TASK_POOL_CNT
+    pool_free(&_draw_info.task_pool, t);
+#else
+    lv_free(t);
+#endif
+}
+
+/**
+ * Skip or clip the waiting draw tasks of a layer which are covered by an opaque new task.
+ * Only the tasks in the cull window (and the queued ones after it, which weren't taken by
+ * any draw units yet) are considered. `task_list_mutex` needs to be locked.
+ * @param layer     the layer of the draw task
+ * @param t         the new draw task
+ */
+static void cull_covered_tasks(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    lv_area_t cover;
+    if(!get_cover_area(t, &cover)) return;
+
+    lv_draw_task_t * t_prev = layer->_cull_window_prev ? layer->_cull_window_prev->next : layer->draw_task_head;
+    for(; t_prev && t_prev != t; t_prev = t_prev->next) {
+        bool in_window = is_new_task(t_prev);
+        if(t_prev->state != LV_DRAW_TASK_STATE_QUEUED && !in_window) continue;
+        /*Layers and masks affect more than their area*/
+        if(t_prev->type == LV_DRAW_TASK_TYPE_LAYER || t_prev->type == LV_DRAW_TASK_TYPE_MASK_RECTANGLE ||
+           t_prev->type == LV_DRAW_TASK_TYPE_MASK_BITMAP || t_prev->type == LV_DRAW_TASK_TYPE_VECTOR) continue;
+
+        lv_area_t a;
+        if(!_lv_area_intersect(&a, &t_prev->_real_area, &t_prev->clip_area)) continue;
+
+        if(_lv_area_is_in(&a, &cover, 0)) {
+            /*Nothing would be visible from it. It will be removed as any finished tasks.*/
+            t_prev->state = LV_DRAW_TASK_STATE_READY;
+            dep_grid_remove_task(layer, t_prev);
+            if(in_window) layer->_cull_window_cnt--;
+            continue;
+        }
+
+        /*If a whole side is covered draw only the rest*/
+        if(cover.x1 <= a.x1 && cover.x2 >= a.x2) {
+            if(cover.y1 <= a.y1 && cover.y2 >= a.y1) t_prev->clip_area.y1 = cover.y2 + 1;
+            else if(cover.y1 <= a.y2 && cover.y2 >= a.y2) t_prev->clip_area.y2 = cover.y1 - 1;
+        }
+        else if(cover.y1 <= a.y1 && cover.y2 >= a.y2) {
+            if(cover.x1 <= a.x1 && cover.x2 >= a.x1) t_prev->clip_area.x1 = cover.x2 + 1;
+            else if(cover.x1 <= a.x2 && cover.x2 >= a.x2) t_prev->clip_area.x2 = cover.x1 - 1;
+        }
+    }
+}
+
+/**
+ * Get the area where a draw task surely replaces the earlier content of the layer
+ * @param t             pointer to a finalized draw task
+ * @param cover_area    store the covered area here
+ * @return              true: the task covers `cover_area`; false: the task is not fully opaque anywhere
+ */
+static bool get_cover_area(const lv_draw_task_t * t, lv_area_t * cover_area)
+{
+    if(t->type == LV_DRAW_TASK_TYPE_FILL) {
+        const lv_draw_fill_dsc_t * dsc = t->draw_dsc;
+        if(dsc->opa < LV_OPA_MAX || dsc->radius != 0) return false;
+        if(dsc->grad.dir != LV_GRAD_DIR_NONE) {
+            uint32_t i;
+            for(i = 0; i < dsc->grad.stops_count; i++) {
+                if(dsc->grad.stops[i].opa < LV_OPA_MAX) return false;
+            }
+        }
+    }
+    else if(t->type == LV_DRAW_TASK_TYPE_IMAGE) {
+        const lv_draw_image_dsc_t * dsc = t->draw_dsc;
+        if(dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL) return false;
+        if(dsc->rotation != 0 || dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE ||
+           dsc->skew_x != 0 || dsc->skew_y != 0) return false;
+        if(dsc->sup || dsc->bitmap_mask_src) return false;
+
+        /*The image should fill its whole area with opaque pixels*/
+        lv_color_format_t cf = dsc->header.cf;
+        if(cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_RGB888 &&
+           cf != LV_COLOR_FORMAT_XRGB8888 && cf != LV_COLOR_FORMAT_L8) return false;
+        if(!dsc->tile && (lv_area_get_width(&t->area) != dsc->header.w ||
+                          lv_area_get_height(&t->area) != dsc->header.h)) return false;
+    }
+    else {
+        return false;
+    }
+
+    return _lv_area_intersect(cover_area, &t->area, &t->clip_area);
+}
+
+/**
+ * Save which cells of the layer's dependency grid are covered by the real area of a draw task.
+ * The real area is clamped to the grid so the cells of overlapping areas always overlap too.
+ * @param layer     the layer of the draw task
+ * @param t         the draw task whose cells should be set
+ */
+static void set_grid_cells(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    int32_t cell_w = (lv_area_get_width(&layer->buf_area) + DEP_GRID_SIZE - 1) / DEP_GRID_SIZE;
+    int32_t cell_h = (lv_area_get_height(&layer->buf_area) + DEP_GRID_SIZE - 1) / DEP_GRID_SIZE;
+    if(cell_w < 1) cell_w = 1;
+    if(cell_h < 1) cell_h = 1;
+
+    /*Use the tiles as cells so the tasks of different tiles never wait for each other*/
+    if(layer->_tile_size >= cell_w && layer->_tile_size >= cell_h) {
+        cell_w = layer->_tile_size;
+        cell_h = layer->_tile_size;
+    }
+
+    /*The task can't change pixels outside of its clip area (e.g. outside of the tile it belongs to)*/
+    lv_area_t a;
+    if(!_lv_area_intersect(&a, &t->_real_area, &t->clip_area)) a = t->_real_area;
+
+    int32_t x1 = (a.x1 - layer->buf_area.x1) / cell_w;
+    int32_t y1 = (a.y1 - layer->buf_area.y1) / cell_h;
+    int32_t x2 = (a.x2 - layer->buf_area.x1) / cell_w;
+    int32_t y2 = (a.y2 - layer->buf_area.y1) / cell_h;
+
+    t->_grid_x1 = (uint8_t)LV_CLAMP(0, x1, DEP_GRID_SIZE - 1);
+    t->_grid_y1 = (uint8_t)LV_CLAMP(0, y1, DEP_GRID_SIZE - 1);
+    t->_grid_x2 = (uint8_t)LV_CLAMP(0, x2, DEP_GRID_SIZE - 1);
+    t->_grid_y2 = (uint8_t)LV_CLAMP(0, y2, DEP_GRID_SIZE - 1);
+}
+
+/**
+ * Allocate the dependency grid of a layer when it gets its first draw task.
+ * It's freed when all the tasks of the layer are finished.
+ * @param layer     pointer to a layer
+ */
+static void dep_grid_init(lv_layer_t * layer)
+{
+    layer->_dep_grid = lv_malloc(DEP_GRID_SIZE * DEP_GRID_SIZE * sizeof(uint16_t));
+    if(layer->_dep_grid == NULL) {
+        LV_LOG_WARN("Couldn't allocate the dependency grid. The draw tasks will be drawn one by one.");
+    }
+
+    layer->_dep_seq_next = 0;
+    layer->_dep_barrier = DEP_SEQ_NONE;
+    /*If allocating failed earlier there might be tasks already so number them again*/
+    layer->_dep_grid_invalid = true;
+}
+
+/**
+ * Add a finalized draw task to the dependency grid: it will be the oldest task on the cells
+ * which have no older unfinished tasks. `task_list_mutex` needs to be locked.
+ * @param layer     the layer of the draw task
+ * @param t         the finalized draw task
+ */
+static void dep_grid_add_task(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    t->_dep_in_grid = 1;
+
+    if(layer->_dep_barrier == t->_dep_seq) {
+        /*If tasks were added after `t` (e.g. in LV_EVENT_DRAW_TASK_ADDED) one of them might be still not finalized*/
+        if(t->next) layer->_dep_grid_invalid = true;
+        else layer->_dep_barrier = DEP_SEQ_NONE;
+    }
+
+    /*The grid will be built from the task list anyway*/
+    if(layer->_dep_grid == NULL || layer->_dep_grid_invalid) return;
+
+    int32_t x;
+    int32_t y;
+    for(y = t->_grid_y1; y <= t->_grid_y2; y++) {
+        uint16_t * row = &layer->_dep_grid[y * DEP_GRID_SIZE];
+        for(x = t->_grid_x1; x <= t->_grid_x2; x++) {
+            if(row[x] > t->_dep_seq) row[x] = t->_dep_seq;
+        }
+    }
+}
+
+/**
+ * Remove a finished or culled draw task from the dependency grid: on the cells where it was the
+ * oldest unfinished task the next unfinished task becomes the oldest.
+ * Only the tasks after `t` are visited and only until all of its cells are set again.
+ * `task_list_mutex` needs to be locked.
+ * @param layer     the layer of the draw task
+ * @param t         the draw task which is READY now
+ */
+static void dep_grid_remove_task(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    /*The grid will be built from the task list anyway*/
+    if(layer->_dep_grid == NULL || layer->_dep_grid_invalid || !t->_dep_in_grid) return;
+
+    /*The tasks after the last sequence number share their cells so they can't be removed one by one*/
+    if(t->_dep_seq == DEP_SEQ_MAX) {
+        layer->_dep_grid_invalid = true;
+        return;
+    }
+
+    /*Clear the cells of the grid where `t` was the oldest*/
+    uint32_t cleared_cnt = 0;
+    int32_t x;
+    int32_t y;
+    for(y = t->_grid_y1; y <= t->_grid_y2; y++) {
+        uint16_t * row = &layer->_dep_grid[y * DEP_GRID_SIZE];
+        for(x = t->_grid_x1; x <= t->_grid_x2; x++) {
+            if(row[x] == t->_dep_seq) {
+                row[x] = DEP_SEQ_NONE;
+                cleared_cnt++;
+            }
+        }
+    }
+
+    /*The later tasks are visited from the oldest, so the first one on a cleared cell is the oldest there.
+     *The not finalized tasks will set their cells when they are added to the grid.*/
+    lv_draw_task_t * t_next;
+    for(t_next = t->next; t_next && cleared_cnt; t_next = t_next->next) {
+        if(t_next->state == LV_DRAW_TASK_STATE_READY || !t_next->_dep_in_grid) continue;
+
+        int32_t x1 = LV_MAX(t->_grid_x1, t_next->_grid_x1);
+        int32_t y1 = LV_MAX(t->_grid_y1, t_next->_grid_y1);
+        int32_t x2 = LV_MIN(t->_grid_x2, t_next->_grid_x2);
+        int32_t y2 = LV_MIN(t->_grid_y2, t_next->_grid_y2);
+        for(y = y1; y <= y2; y++) {
+            uint16_t * row = &layer->_dep_grid[y * DEP_GRID_SIZE];
+            for(x = x1; x <= x2; x++) {
+                if(row[x] == DEP_SEQ_NONE) {
+                    row[x] = t_next->_dep_seq;
+                    cleared_cnt--;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Number the tasks again and save the oldest unfinished task on each cell of the grid.
+ * Used when the grid couldn't be updated task by task. `task_list_mutex` needs to be locked.
+ * @param layer     pointer to a layer
+ */
+static void dep_grid_rebuild(lv_layer_t * layer)
+{
+    LV_PROFILER_BEGIN;
+    lv_memset(layer->_dep_grid, 0xFF, DEP_GRID_SIZE * DEP_GRID_SIZE * sizeof(uint16_t));
+    layer->_dep_barrier = DEP_SEQ_NONE;
+
+    uint16_t seq = 0;
+    lv_draw_task_t * t;
+    for(t = layer->draw_task_head; t; t = t->next) {
+        t->_dep_seq = seq;
+        if(seq < DEP_SEQ_MAX) seq++;
+
+        if(t->state == LV_DRAW_TASK_STATE_READY) continue;
+
+        /*The tasks after a not finalized task need to wait for it*/
+        if(!t->_dep_in_grid) {
+            if(layer->_dep_barrier == DEP_SEQ_NONE) layer->_dep_barrier = t->_dep_seq;
+            continue;
+        }
+
+        /*As the tasks are visited from the oldest, set only the empty cells*/
+        int32_t x;
+        int32_t y;
+        for(y = t->_grid_y1; y <= t->_grid_y2; y++) {
+            uint16_t * row = &layer->_dep_grid[y * DEP_GRID_SIZE];
+            for(x = t->_grid_x1; x <= t->_grid_x2; x++) {
+                if(row[x] == DEP_SEQ_NONE) row[x] = t->_dep_seq;
+            }
+        }
+    }
+
+    layer->_dep_seq_next = seq;
+    layer->_dep_grid_invalid = false;
     LV_PROFILER_END;
+}
+
+/**
+ * Check if a task is the oldest unfinished task on all of its cells.
+ * @param layer     the layer of the draw task
+ * @param t         pointer to a draw task
+ * @return          true: no earlier unfinished task overlaps with `t`
+ */
+static bool dep_grid_is_independent(const lv_layer_t * layer, const lv_draw_task_t * t)
+{
+    /*Handled when out of memory by taking only the first task*/
+    if(layer->_dep_grid == NULL) return true;
+
+    if(t->_dep_seq >= layer->_dep_barrier || t->_dep_seq == DEP_SEQ_MAX) return false;
+
+    int32_t x;
+    int32_t y;
+    for(y = t->_grid_y1; y <= t->_grid_y2; y++) {
+        const uint16_t * row = &layer->_dep_grid[y * DEP_GRID_SIZE];
+        for(x = t->_grid_x1; x <= t->_grid_x2; x++) {
+            if(row[x] != t->_dep_seq) return false;
+        }
+    }
 
     return true;
 }
+
+#if LV_DRAW_TASK_POOL_CNT
+
+static void pool_init(lv_draw_pool_t * pool, size_t block_size)
+{
+    lv_memzero(pool, sizeof(lv_draw_pool_t));
+    /*The released blocks store a pointer to the next free block so align them to a pointer's size*/
+    pool->block_size = LV_ALIGN_UP(block_size, sizeof(void *));
+    pool->block_cnt = LV_DRAW_TASK_POOL_CNT;
+}
+
+static void pool_deinit(lv_draw_pool_t * pool)
+{
+    LV_LOG_INFO("Draw pool with %" LV_PRIu32 " byte blocks: %" LV_PRIu32 " hits, %" LV_PRIu32 " misses",
+                pool->block_size, pool->hit_cnt, pool->miss_cnt);
+    lv_free(pool->buf);
+    lv_memzero(pool, sizeof(lv_draw_pool_t));
+}
+
+/**
+ * Get a block from a pool or allocate it with `lv_malloc` if
+ * it doesn't fit into a block or all blocks are in use
+ * @param pool      pointer to a pool
+ * @param size      the size to allocate in bytes
+ * @return          pointer to the allocated memory
+ */
+static void * pool_alloc(lv_draw_pool_t * pool, size_t size)
+{
+    if(size <= pool->block_size) {
+        if(pool->buf == NULL) {
+            pool->buf = lv_malloc(pool->block_size * pool->block_cnt);
+            LV_ASSERT_MALLOC(pool->buf);
+        }
+
+        void * p = NULL;
+        if(pool->free_head) {
+            p = pool->free_head;
+            pool->free_head = *(void **)p;
+        }
+        else if(pool->buf && pool->next_idx < pool->block_cnt) {
+            p = pool->buf + pool->next_idx * pool->block_size;
+            pool->next_idx++;
+        }
+
+        if(p) {
+            pool->used_cnt++;
+            pool->hit_cnt++;
+            return p;
+        }
+    }
+
+    /*Make the fallbacks visible in the profiler's trace*/
+    LV_PROFILER_BEGIN_TAG("lv_draw_pool_miss");
+    pool->miss_cnt++;
+    void * p = lv_malloc(size);
+    LV_PROFILER_END_TAG("lv_draw_pool_miss");
+    return p;
+}
+
+/**
+ * Give back a block to a pool or free it with `lv_free` if it was not allocated from the pool.
+ * When all blocks are released the pool is reset in bulk.
+ * @param pool      pointer to a pool
+ * @param p         pointer to the memory to release
+ */
+static void pool_free(lv_draw_pool_t * pool, void * p)
+{
+    uint8_t * p8 = p;
+    if(pool->buf == NULL || p8 < pool->buf || p8 >= pool->buf + pool->block_size * pool->block_cnt) {
+        lv_free(p);
+        return;
+    }
+
+    pool->used_cnt--;
+    if(pool->used_cnt == 0) {
+        pool->free_head = NULL;
+        pool->next_idx = 0;
+    }
+    else {
+        *(void **)p = pool->free_head;
+        pool->free_head = p;
+    }
+}
+
+/**
+ * Copy the usage information of a pool
+ * @param pool      pointer to a pool
+ * @param mon       store the information here
+ */
+static void pool_monitor(const lv_draw_pool_t * pool, lv_draw_pool_monitor_t * mon)
+{
+    mon->block_size = pool->block_size;
+    mon->block_cnt = pool->block_cnt;
+    mon->used_cnt = pool->used_cnt;
+    mon->hit_cnt = pool->hit_cnt;
+    mon->miss_cnt = pool->miss_cnt;
+}
+
+#endif /*LV_DRAW_TASK_POOL_CNT*/
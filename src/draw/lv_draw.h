@@ -48,7 +48,7 @@ typedef enum {
 } lv_draw_task_type_t;
 
 typedef enum {
-    LV_DRAW_TASK_STATE_WAITING,     /*Waiting for something to be finished. E.g. rendering a layer*/
+    LV_DRAW_TASK_STATE_WAITING,     /*Waiting for something to be finished. E.g. rendering a layer or finalizing the task*/
     LV_DRAW_TASK_STATE_QUEUED,
     LV_DRAW_TASK_STATE_IN_PROGRESS,
     LV_DRAW_TASK_STATE_READY,
@@ -96,6 +96,25 @@ struct _lv_draw_task_t {
      */
     uint8_t preference_score;
 
+    /**
+     * The columns and rows of the layer's dependency grid covered by `_real_area`.
+     * Set when the task is finalized and used to quickly find overlapping tasks.
+     */
+    uint8_t _grid_x1;
+    uint8_t _grid_y1;
+    uint8_t _grid_x2;
+    uint8_t _grid_y2;
+
+    /** Used internally. The position of the task in the layer's list to find the older tasks in the dependency grid*/
+    uint16_t _dep_seq;
+
+    /** Used internally. Set when the task is finalized and added to the dependency grid*/
+    uint8_t _dep_in_grid;
+
+#if LV_USE_DRAW_TRACE
+    uint32_t trace_queued_tick;     /**< Set when the task is queued*/
+    uint32_t trace_start_tick;      /**< Set when a draw unit starts to execute the task*/
+#endif
 };
 
 typedef struct {
@@ -168,10 +187,37 @@ struct _lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /**
+     * Used internally. The sequence number of the oldest unfinished task on each cell of the
+     * dependency grid. Allocated when the first task is added and freed when all tasks are finished.
+     * It's updated when tasks are added or finished.
+     */
+    uint16_t * _dep_grid;
+    uint16_t _dep_seq_next;     /**< Sequence number of the next new task*/
+    uint16_t _dep_barrier;      /**< The tasks from this sequence number wait for a not finalized task*/
+    bool _dep_grid_invalid;     /**< The grid needs to be rebuilt from the task list (e.g. it couldn't be updated task by task)*/
+
+    /** Used internally. Number of the finalized tasks which are kept back from the draw units to cull them*/
+    uint32_t _cull_window_cnt;
+
+    /** Used internally. The tasks until this one are not in the cull window anymore. NULL: check from the head*/
+    lv_draw_task_t * _cull_window_prev;
+
+    /** Used internally. Split the tasks covering more tiles of this size to a task per tile. 0: don't split*/
+    int32_t _tile_size;
+
     lv_layer_t * parent;
     lv_layer_t * next;
+
+    /** The display for which the layer is rendered. NULL if it's not rendered for a display (e.g. a canvas)*/
+    lv_display_t * disp;
+
     bool all_tasks_added;
     void * user_data;
+
+    /** If set `draw_buf` belongs to this entry of the layer cache.
+     * The entry is released instead of freeing the buffer when the layer is drawn.*/
+    lv_cache_entry_t * cache_entry;
 };
 
 typedef struct {
@@ -182,18 +228,53 @@ typedef struct {
     lv_layer_t * layer;
     size_t dsc_size;
     void * user_data;
+
+    /** Used internally. Number of the other draw tasks using this descriptor (the copies of a task split to tiles)*/
+    uint32_t _tile_copy_cnt;
 } lv_draw_dsc_base_t;
 
+typedef struct {
+    uint8_t * buf;          /**< Memory of all blocks, allocated on first use*/
+    void * free_head;       /**< Linked list of the released blocks*/
+    uint32_t block_size;    /**< Size of a block in bytes*/
+    uint32_t block_cnt;     /**< Number of blocks in `buf`*/
+    uint32_t next_idx;      /**< The blocks from this index haven't been used since the last reset*/
+    uint32_t used_cnt;      /**< Number of blocks in use*/
+    uint32_t hit_cnt;       /**< Number of allocations served from the pool*/
+    uint32_t miss_cnt;      /**< Number of allocations which needed `lv_malloc`*/
+} lv_draw_pool_t;
+
+/**
+ * Usage information of a draw task or draw descriptor pool
+ */
+typedef struct {
+    uint32_t block_size;    /**< Size of a block in bytes*/
+    uint32_t block_cnt;     /**< Number of blocks in the pool*/
+    uint32_t used_cnt;      /**< Number of blocks in use*/
+    uint32_t hit_cnt;       /**< Number of allocations served from the pool*/
+    uint32_t miss_cnt;      /**< Number of allocations which needed `lv_malloc`*/
+} lv_draw_pool_monitor_t;
+
 typedef struct {
     lv_draw_unit_t * unit_head;
     uint32_t used_memory_for_layers_kb;
+    lv_mutex_t layer_mem_mutex;     /**< Protects `used_memory_for_layers_kb` and the layer cache as layers are allocated by the draw threads too*/
+#if LV_DRAW_TASK_POOL_CNT
+    lv_draw_pool_t task_pool;
+    lv_draw_pool_t dsc_pool;
+#endif
 #if LV_USE_OS
     lv_thread_sync_t sync;
 #else
     int dispatch_req;
 #endif
-    lv_mutex_t circle_cache_mutex;
+    lv_mutex_t task_list_mutex;     /**< Protects the draw task lists when draw threads take tasks by themselves*/
+    uint32_t task_cnt;              /**< Number of created draw tasks. The difference of two readings is the number of tasks created meanwhile*/
     bool task_running;
+#if LV_USE_DRAW_LIST
+    lv_draw_list_t * rec_list;      /**< The draw list which records the tasks of `rec_layer`*/
+    lv_layer_t * rec_layer;
+#endif
 } lv_draw_global_info_t;
 
 /**********************
@@ -226,6 +307,29 @@ void * lv_draw_create_unit(size_t size);
  */
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords);
 
+/**
+ * Allocate memory for the draw descriptor of a draw task.
+ * If `LV_DRAW_TASK_POOL_CNT > 0` it's taken from a pool, else `lv_malloc` is used.
+ * The descriptor is freed automatically when its draw task is finished.
+ * @param size      size of the descriptor in bytes
+ * @return          pointer to the allocated memory
+ */
+void * lv_draw_dsc_alloc(size_t size);
+
+/**
+ * Free a draw descriptor allocated by `lv_draw_dsc_alloc` which was not added to a draw task.
+ * @param dsc       pointer to a draw descriptor
+ */
+void lv_draw_dsc_free(void * dsc);
+
+/**
+ * Give information about the pools of the draw tasks and draw descriptors.
+ * If `LV_DRAW_TASK_POOL_CNT == 0` all fields are zero.
+ * @param task_mon      the usage of the draw task pool will be stored here (can be NULL)
+ * @param dsc_mon       the usage of the draw descriptor pool will be stored here (can be NULL)
+ */
+void lv_draw_pool_monitor(lv_draw_pool_monitor_t * task_mon, lv_draw_pool_monitor_t * dsc_mon);
+
 /**
  * Needs to be called when a draw task is created and configured.
  * It will send an event about the new draw task to the widget
@@ -240,6 +344,14 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t);
  */
 void lv_draw_dispatch(void);
 
+/**
+ * Try dispatching only the draw tasks of a display to draw units.
+ * The displays can be rendered independently as each has its own layers with their own draw tasks.
+ * @param disp      pointer to a display
+ * @return          at least one draw task is being rendered (maybe it was taken earlier)
+ */
+bool lv_draw_dispatch_display(lv_display_t * disp);
+
 /**
  * Used internally to try dispatching draw tasks of a specific layer
  * @param disp      pointer to a display on which the dispatching was requested
@@ -260,15 +372,34 @@ void lv_draw_dispatch_wait_for_request(void);
  */
 void lv_draw_dispatch_request(void);
 
+/**
+ * Cull the draw tasks of a layer covered by the later tasks and let the draw units take the new tasks.
+ * The finalized draw tasks are not queued until then, so that the later tasks can still cull them.
+ * It's called by `lv_draw_dispatch_layer` too, so needs to be called only to queue the tasks without dispatching.
+ * @param layer             pointer to a layer
+ */
+void lv_draw_queue_layer_tasks(lv_layer_t * layer);
+
 /**
  * Find and available draw task
  * @param layer             the draw ctx to search in
  * @param t_prev            continue searching from this task
  * @param draw_unit_id      check the task where `preferred_draw_unit_id` equals this value or `LV_DRAW_UNIT_ID_ANY`
  * @return                  tan available draw task or NULL if there is no any
+ * @note                    the task list is locked while searching, so it can be called from any draw unit
  */
 lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_task_t * t_prev, uint8_t draw_unit_id);
 
+/**
+ * Used internally. The same as `lv_draw_get_next_available_task` but the caller
+ * needs to hold the lock of the task lists.
+ * @param layer             the draw ctx to search in
+ * @param t_prev            continue searching from this task
+ * @param draw_unit_id      check the task where `preferred_draw_unit_id` equals this value or `LV_DRAW_UNIT_ID_ANY`
+ * @return                  tan available draw task or NULL if there is no any
+ */
+lv_draw_task_t * _lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_task_t * t_prev, uint8_t draw_unit_id);
+
 /**
  * Tell how many draw task are waiting to be drawn on the area of `t_check`.
  * It can be used to determine if a GPU shall combine many draw tasks in to one or not.
@@ -280,7 +411,24 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check);
 
 /**
- * Create a new layer on a parent layer
+ * Set the state of a draw task. The draw units should use it instead of writing `state` directly
+ * as the other draw units might read the task list at the same time.
+ * @param t         pointer to a draw task
+ * @param state     the new state, e.g. `LV_DRAW_TASK_STATE_IN_PROGRESS` or `LV_DRAW_TASK_STATE_READY`
+ */
+void lv_draw_task_set_state(lv_draw_task_t * t, lv_draw_task_state_t state);
+
+/**
+ * Used internally. The same as `lv_draw_task_set_state` but the caller
+ * needs to hold the lock of the task lists.
+ * @param t         pointer to a draw task
+ * @param state     the new state
+ */
+void _lv_draw_task_set_state(lv_draw_task_t * t, lv_draw_task_state_t state);
+
+/**
+ * Create a new layer on a parent layer.
+ * The layer is added to the layer list of the parent layer's display (or the default display if it has no display).
  * @param parent_layer      the parent layer to which the layer will be merged when it's rendered
  * @param color_format      the color format of the layer
  * @param area              the areas of the layer (absolute coordinates)
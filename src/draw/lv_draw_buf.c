@@ -197,6 +197,23 @@ void lv_draw_buf_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
     uint32_t src_stride = src->header.stride;
     uint32_t line_bytes = (line_width * lv_color_format_get_bpp(dest->header.cf) + 7) >> 3;
 
+    /*Moving an area inside a buffer: copy the lines from the bottom if they are moved down*/
+    if(dest == src) {
+        int32_t line_step = dest_stride;
+        if(dest_bufc > src_bufc) {
+            dest_bufc += (end_y - start_y) * dest_stride;
+            src_bufc += (end_y - start_y) * src_stride;
+            line_step = -line_step;
+        }
+
+        for(; start_y <= end_y; start_y++) {
+            lv_memmove(dest_bufc, src_bufc, line_bytes);
+            dest_bufc += line_step;
+            src_bufc += line_step;
+        }
+        return;
+    }
+
     for(; start_y <= end_y; start_y++) {
         lv_memcpy(dest_bufc, src_bufc, line_bytes);
         dest_bufc += dest_stride;
@@ -0,0 +1,199 @@
+/**
+ * @file lv_draw_layer_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_layer_cache.h"
+#include "../misc/lv_assert.h"
+#include "../core/lv_global.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define layer_cache_p (LV_GLOBAL_DEFAULT()->layer_cache)
+#define _draw_info LV_GLOBAL_DEFAULT()->draw_info
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_cache_compare_res_t layer_cache_compare_cb(const lv_draw_layer_cache_data_t * lhs,
+                                                     const lv_draw_layer_cache_data_t * rhs);
+static void layer_cache_free_cb(lv_draw_layer_cache_data_t * entry, void * user_data);
+static inline uint32_t get_layer_size_kb(uint32_t size_byte);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_draw_layer_cache_init(uint32_t size)
+{
+    if(layer_cache_p != NULL) {
+        return LV_RESULT_OK;
+    }
+
+    layer_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(lv_draw_layer_cache_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) layer_cache_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) layer_cache_free_cb,
+    });
+    return layer_cache_p != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lv_draw_layer_cache_deinit(void)
+{
+    if(layer_cache_p == NULL) return;
+
+    lv_mutex_lock(&_draw_info.layer_mem_mutex);
+    lv_cache_destroy(layer_cache_p, NULL);
+    layer_cache_p = NULL;
+    lv_mutex_unlock(&_draw_info.layer_mem_mutex);
+}
+
+void lv_draw_layer_cache_resize(uint32_t new_size, bool evict_now)
+{
+    lv_mutex_lock(&_draw_info.layer_mem_mutex);
+    lv_cache_set_max_size(layer_cache_p, new_size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(layer_cache_p, new_size, NULL);
+    }
+    lv_mutex_unlock(&_draw_info.layer_mem_mutex);
+}
+
+bool lv_draw_layer_cache_is_enabled(void)
+{
+    return layer_cache_p && lv_cache_is_enabled(layer_cache_p);
+}
+
+lv_cache_entry_t * lv_draw_layer_cache_acquire(const void * owner)
+{
+    lv_draw_layer_cache_data_t search_key;
+    search_key.owner = owner;
+
+    return lv_cache_acquire(layer_cache_p, &search_key, NULL);
+}
+
+lv_cache_entry_t * lv_draw_layer_cache_add(const void * owner, lv_draw_buf_t * draw_buf, const lv_area_t * area)
+{
+    lv_draw_layer_cache_data_t search_key;
+    search_key.slot.size = draw_buf->data_size;
+    search_key.owner = owner;
+
+    /*Don't even try to add layers which would never fit*/
+    if(search_key.slot.size > lv_cache_get_max_size(layer_cache_p, NULL)) return NULL;
+
+    /*The draw threads might allocate layers meanwhile*/
+    lv_mutex_lock(&_draw_info.layer_mem_mutex);
+
+    /*There might be an outdated entry which is still used*/
+    lv_cache_drop(layer_cache_p, &search_key, NULL);
+
+    /*Don't keep a layer which would take the memory from the not cached layers*/
+    lv_cache_entry_t * entry = NULL;
+    if(_lv_draw_layer_cache_make_room(search_key.slot.size)) {
+        entry = lv_cache_add(layer_cache_p, &search_key, NULL);
+    }
+
+    if(entry) {
+        lv_draw_layer_cache_data_t * data = lv_cache_entry_get_data(entry);
+        data->draw_buf = draw_buf;
+        data->area = *area;
+
+        /*The cached layers use the memory of the layers too*/
+        _draw_info.used_memory_for_layers_kb += get_layer_size_kb(draw_buf->data_size);
+    }
+
+    lv_mutex_unlock(&_draw_info.layer_mem_mutex);
+
+    return entry;
+}
+
+void lv_draw_layer_cache_release(lv_cache_entry_t * entry)
+{
+    /*The layer is freed here if it was dropped while in use*/
+    lv_mutex_lock(&_draw_info.layer_mem_mutex);
+    lv_cache_release(layer_cache_p, entry, NULL);
+    lv_mutex_unlock(&_draw_info.layer_mem_mutex);
+}
+
+bool lv_draw_layer_cache_make_room(uint32_t size_byte)
+{
+    lv_mutex_lock(&_draw_info.layer_mem_mutex);
+    bool res = _lv_draw_layer_cache_make_room(size_byte);
+    lv_mutex_unlock(&_draw_info.layer_mem_mutex);
+    return res;
+}
+
+bool _lv_draw_layer_cache_make_room(uint32_t size_byte)
+{
+#if LV_DRAW_LAYER_MAX_MEMORY
+    uint32_t size_kb = get_layer_size_kb(size_byte);
+    while(_draw_info.used_memory_for_layers_kb + size_kb > LV_DRAW_LAYER_MAX_MEMORY / 1024) {
+        /*The layers in use can't be dropped*/
+        if(layer_cache_p == NULL || !lv_cache_evict_one(layer_cache_p, NULL)) return false;
+    }
+#else
+    LV_UNUSED(size_byte);
+#endif
+
+    return true;
+}
+
+void lv_draw_layer_cache_drop(const void * owner)
+{
+    if(layer_cache_p == NULL) return;
+
+    lv_mutex_lock(&_draw_info.layer_mem_mutex);
+    if(owner == NULL) {
+        lv_cache_drop_all(layer_cache_p, NULL);
+    }
+    else {
+        lv_draw_layer_cache_data_t search_key;
+        search_key.owner = owner;
+        lv_cache_drop(layer_cache_p, &search_key, NULL);
+    }
+    lv_mutex_unlock(&_draw_info.layer_mem_mutex);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_cache_compare_res_t layer_cache_compare_cb(const lv_draw_layer_cache_data_t * lhs,
+                                                     const lv_draw_layer_cache_data_t * rhs)
+{
+    if(lhs->owner != rhs->owner) {
+        return lhs->owner > rhs->owner ? 1 : -1;
+    }
+
+    return 0;
+}
+
+/*Called with the lock of the layer memory held*/
+static void layer_cache_free_cb(lv_draw_layer_cache_data_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    _draw_info.used_memory_for_layers_kb -= get_layer_size_kb(entry->draw_buf->data_size);
+    lv_draw_buf_destroy(entry->draw_buf);
+}
+
+static inline uint32_t get_layer_size_kb(uint32_t size_byte)
+{
+    return size_byte < 1024 ? 1 : size_byte >> 10;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file lv_draw_layer_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_LAYER_CACHE_H
+#define LV_DRAW_LAYER_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_buf.h"
+#include "../misc/cache/lv_cache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The rendered content of a layer kept in the layer cache*/
+typedef struct {
+    lv_cache_slot_size_t slot;
+    const void * owner;         /**< The key: typically the widget which was rendered to the layer*/
+    lv_draw_buf_t * draw_buf;   /**< The rendered layer*/
+    lv_area_t area;             /**< The absolute coordinates of `draw_buf` when it was rendered*/
+} lv_draw_layer_cache_data_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the layer cache.
+ * @param size      size of the cache in bytes. 0: the cache is disabled
+ * @return          LV_RESULT_OK: initialization succeeded, LV_RESULT_INVALID: failed.
+ */
+lv_result_t lv_draw_layer_cache_init(uint32_t size);
+
+/**
+ * Drop all the cached layers and free the cache
+ */
+void lv_draw_layer_cache_deinit(void);
+
+/**
+ * Resize the layer cache.
+ * If set to 0, the cache will be disabled.
+ * @param new_size  new size of the cache in bytes.
+ * @param evict_now true: evict the layers should be removed by the eviction policy, false: wait for the next cache cleanup.
+ */
+void lv_draw_layer_cache_resize(uint32_t new_size, bool evict_now);
+
+/**
+ * Return true if the layer cache is enabled.
+ * @return          true: enabled, false: disabled.
+ */
+bool lv_draw_layer_cache_is_enabled(void);
+
+/**
+ * Find the cached layer of an owner.
+ * @param owner     the owner of the layer
+ * @return          the acquired cache entry or NULL if not found. Release it with `lv_draw_layer_cache_release()`.
+ */
+lv_cache_entry_t * lv_draw_layer_cache_acquire(const void * owner);
+
+/**
+ * Add a layer to the cache. The cache takes the ownership of the draw buffer.
+ * @param owner     the owner of the layer
+ * @param draw_buf  the buffer of the layer. It will be destroyed when the layer is dropped from the cache.
+ * @param area      the absolute coordinates of the draw buffer
+ * @return          the acquired cache entry or NULL if the layer couldn't be added (e.g. it's too large).
+ *                  Release it with `lv_draw_layer_cache_release()`.
+ */
+lv_cache_entry_t * lv_draw_layer_cache_add(const void * owner, lv_draw_buf_t * draw_buf, const lv_area_t * area);
+
+/**
+ * Release a cache entry acquired by `lv_draw_layer_cache_acquire()` or `lv_draw_layer_cache_add()`
+ * @param entry     the cache entry
+ */
+void lv_draw_layer_cache_release(lv_cache_entry_t * entry);
+
+/**
+ * Drop the least recently used cached layers until a new layer fits into `LV_DRAW_LAYER_MAX_MEMORY`.
+ * @param size_byte the size of the new layer in bytes
+ * @return          true: the new layer fits; false: it doesn't fit even without the unused cached layers
+ */
+bool lv_draw_layer_cache_make_room(uint32_t size_byte);
+
+/**
+ * Used internally. The same as `lv_draw_layer_cache_make_room` but the caller
+ * needs to hold the lock of the layer memory.
+ * @param size_byte the size of the new layer in bytes
+ * @return          true: the new layer fits; false: it doesn't fit even without the unused cached layers
+ */
+bool _lv_draw_layer_cache_make_room(uint32_t size_byte);
+
+/**
+ * Drop the cached layer of an owner as its content is outdated.
+ * If the layer is still used, it's freed when it's released.
+ * @param owner     the owner of the layer. NULL to drop all layers.
+ */
+void lv_draw_layer_cache_drop(const void * owner);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_LAYER_CACHE_H*/
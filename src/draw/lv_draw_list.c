@@ -0,0 +1,230 @@
+/**
+ * @file lv_draw_list.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_list.h"
+#if LV_USE_DRAW_LIST
+
+#include "lv_draw_rect.h"
+#include "lv_draw_label.h"
+#include "lv_draw_image.h"
+#include "lv_draw_line.h"
+#include "lv_draw_arc.h"
+#include "lv_draw_triangle.h"
+#include "../core/lv_global.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define _draw_info LV_GLOBAL_DEFAULT()->draw_info
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static size_t get_dsc_size(lv_draw_task_type_t type);
+static void * copy_dsc(lv_draw_task_type_t type, const void * dsc, bool use_draw_pool);
+static void free_items(lv_draw_list_t * list);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_draw_list_t * lv_draw_list_create(void)
+{
+    lv_draw_list_t * list = lv_malloc_zeroed(sizeof(lv_draw_list_t));
+    LV_ASSERT_MALLOC(list);
+    return list;
+}
+
+void lv_draw_list_delete(lv_draw_list_t * list)
+{
+    if(list == NULL) return;
+
+    if(_draw_info.rec_list == list) _draw_info.rec_list = NULL;
+    free_items(list);
+    lv_free(list->items);
+    lv_free(list);
+}
+
+void lv_draw_list_invalidate(lv_draw_list_t * list)
+{
+    list->generation++;
+}
+
+bool lv_draw_list_is_valid(const lv_draw_list_t * list, const lv_area_t * coords)
+{
+    return list->recorded && list->replayable && list->rec_generation == list->generation &&
+           _lv_area_is_equal(&list->coords, coords);
+}
+
+void lv_draw_list_record_start(lv_draw_list_t * list, lv_layer_t * layer, const lv_area_t * coords)
+{
+    free_items(list);
+    list->coords = *coords;
+    list->rec_generation = list->generation;
+    list->recorded = 0;
+    list->replayable = 1;
+
+    _draw_info.rec_list = list;
+    _draw_info.rec_layer = layer;
+}
+
+void lv_draw_list_record_finish(lv_draw_list_t * list)
+{
+    if(_draw_info.rec_list != list) return;
+
+    _draw_info.rec_list = NULL;
+    _draw_info.rec_layer = NULL;
+    list->recorded = 1;
+
+    /*Don't keep the memory of the tasks which can't be replayed anyway*/
+    if(!list->replayable) free_items(list);
+}
+
+void lv_draw_list_replay(const lv_draw_list_t * list, lv_layer_t * layer)
+{
+    LV_PROFILER_BEGIN;
+    uint32_t i;
+    for(i = 0; i < list->item_cnt; i++) {
+        const lv_draw_list_item_t * item = &list->items[i];
+
+        /*Widgets can narrow the clip area while drawing (e.g. the text area of labels)*/
+        lv_area_t clip_area = item->clip_area;
+        lv_area_move(&clip_area, list->coords.x1, list->coords.y1);
+        if(!_lv_area_intersect(&clip_area, &clip_area, &layer->_clip_area)) continue;
+
+        lv_draw_task_t * t = lv_draw_add_task(layer, &item->area);
+        t->_real_area = item->real_area;
+        t->clip_area = clip_area;
+        t->type = item->type;
+        t->draw_dsc = copy_dsc(item->type, item->draw_dsc, true);
+        lv_draw_finalize_task_creation(layer, t);
+    }
+    LV_PROFILER_END;
+}
+
+void _lv_draw_list_record_task(lv_layer_t * layer, const lv_draw_task_t * t)
+{
+    lv_draw_list_t * list = _draw_info.rec_list;
+    if(list == NULL || !list->replayable) return;
+
+    /*Tasks added to other layers (e.g. to a layer created while drawing) can't be
+     *replayed without their layer, and the rest can't be copied safely*/
+    if(layer != _draw_info.rec_layer || get_dsc_size(t->type) == 0) {
+        list->replayable = 0;
+        return;
+    }
+
+    if(list->item_cnt == list->item_capacity) {
+        uint32_t new_capacity = list->item_capacity ? list->item_capacity * 2 : 4;
+        lv_draw_list_item_t * new_items = lv_realloc(list->items, new_capacity * sizeof(lv_draw_list_item_t));
+        LV_ASSERT_MALLOC(new_items);
+        if(new_items == NULL) {
+            list->replayable = 0;
+            return;
+        }
+        list->items = new_items;
+        list->item_capacity = new_capacity;
+    }
+
+    lv_draw_list_item_t * item = &list->items[list->item_cnt];
+    item->type = t->type;
+    item->area = t->area;
+    item->real_area = t->_real_area;
+    item->clip_area = t->clip_area;
+    lv_area_move(&item->clip_area, -list->coords.x1, -list->coords.y1);
+    item->draw_dsc = copy_dsc(t->type, t->draw_dsc, false);
+    list->item_cnt++;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the size of the descriptor of the draw tasks which can be recorded
+ * @param type      type of a draw task
+ * @return          size of the draw descriptor or 0 if the type can't be recorded
+ */
+static size_t get_dsc_size(lv_draw_task_type_t type)
+{
+    switch(type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            return sizeof(lv_draw_fill_dsc_t);
+        case LV_DRAW_TASK_TYPE_BORDER:
+            return sizeof(lv_draw_border_dsc_t);
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            return sizeof(lv_draw_box_shadow_dsc_t);
+        case LV_DRAW_TASK_TYPE_LABEL:
+            return sizeof(lv_draw_label_dsc_t);
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            return sizeof(lv_draw_image_dsc_t);
+        case LV_DRAW_TASK_TYPE_LINE:
+            return sizeof(lv_draw_line_dsc_t);
+        case LV_DRAW_TASK_TYPE_ARC:
+            return sizeof(lv_draw_arc_dsc_t);
+        case LV_DRAW_TASK_TYPE_TRIANGLE:
+            return sizeof(lv_draw_triangle_dsc_t);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Duplicate a draw descriptor. Local label texts are duplicated too.
+ * @param type          type of the draw task of the descriptor
+ * @param dsc           the descriptor to copy
+ * @param use_draw_pool true: allocate the copy as the descriptor of a new draw task
+ * @return              the copy of the descriptor
+ */
+static void * copy_dsc(lv_draw_task_type_t type, const void * dsc, bool use_draw_pool)
+{
+    size_t size = get_dsc_size(type);
+    void * new_dsc = use_draw_pool ? lv_draw_dsc_alloc(size) : lv_malloc(size);
+    LV_ASSERT_MALLOC(new_dsc);
+    lv_memcpy(new_dsc, dsc, size);
+
+    if(type == LV_DRAW_TASK_TYPE_LABEL) {
+        lv_draw_label_dsc_t * label_dsc = new_dsc;
+        if(label_dsc->text_local) label_dsc->text = lv_strdup(label_dsc->text);
+    }
+
+    return new_dsc;
+}
+
+/**
+ * Free the recorded draw tasks but keep the array of the items
+ * @param list      pointer to a draw list
+ */
+static void free_items(lv_draw_list_t * list)
+{
+    uint32_t i;
+    for(i = 0; i < list->item_cnt; i++) {
+        lv_draw_list_item_t * item = &list->items[i];
+        if(item->type == LV_DRAW_TASK_TYPE_LABEL) {
+            lv_draw_label_dsc_t * label_dsc = item->draw_dsc;
+            if(label_dsc->text_local) lv_free((void *)label_dsc->text);
+        }
+        lv_free(item->draw_dsc);
+    }
+    list->item_cnt = 0;
+}
+
+#endif /*LV_USE_DRAW_LIST*/
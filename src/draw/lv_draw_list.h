@@ -0,0 +1,119 @@
+/**
+ * @file lv_draw_list.h
+ *
+ */
+
+#ifndef LV_DRAW_LIST_H
+#define LV_DRAW_LIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw.h"
+
+#if LV_USE_DRAW_LIST
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A recorded draw task*/
+typedef struct {
+    lv_draw_task_type_t type;
+    lv_area_t area;
+    lv_area_t real_area;
+    lv_area_t clip_area;        /**< Clip area of the task relative to `coords` of the list*/
+    void * draw_dsc;
+} lv_draw_list_item_t;
+
+/** The draw tasks recorded while a widget's main part was drawn*/
+struct _lv_draw_list_t {
+    lv_draw_list_item_t * items;
+    uint32_t item_cnt;
+    uint32_t item_capacity;
+
+    lv_area_t coords;           /**< Coordinates of the widget when the tasks were recorded*/
+    uint32_t generation;        /**< Incremented when the widget changes*/
+    uint32_t rec_generation;    /**< `generation` when the tasks were recorded*/
+    uint32_t recorded : 1;      /**< 1: the recording was finished*/
+    uint32_t replayable : 1;    /**< 0: the recording contained unsupported draw tasks*/
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create an empty draw list
+ * @return      the new draw list
+ */
+lv_draw_list_t * lv_draw_list_create(void);
+
+/**
+ * Free the recorded draw tasks and the draw list itself
+ * @param list  pointer to a draw list
+ */
+void lv_draw_list_delete(lv_draw_list_t * list);
+
+/**
+ * Mark the recorded draw tasks as outdated. They won't be replayed until the next recording.
+ * @param list  pointer to a draw list
+ */
+void lv_draw_list_invalidate(lv_draw_list_t * list);
+
+/**
+ * Check if the draw list can be replayed instead of drawing again
+ * @param list      pointer to a draw list
+ * @param coords    the current coordinates of the drawn widget
+ * @return          true: the recorded tasks are up to date
+ */
+bool lv_draw_list_is_valid(const lv_draw_list_t * list, const lv_area_t * coords);
+
+/**
+ * Start recording the draw tasks added to a layer. The previous recording is discarded.
+ * @param list      pointer to a draw list
+ * @param layer     the layer whose tasks should be recorded
+ * @param coords    the current coordinates of the drawn widget
+ */
+void lv_draw_list_record_start(lv_draw_list_t * list, lv_layer_t * layer, const lv_area_t * coords);
+
+/**
+ * Stop the recording started by `lv_draw_list_record_start`
+ * @param list      pointer to the draw list being recorded
+ */
+void lv_draw_list_record_finish(lv_draw_list_t * list);
+
+/**
+ * Add the recorded draw tasks to a layer again
+ * @param list      pointer to a valid draw list
+ * @param layer     the layer to add the tasks to. The recorded clip areas are limited to its current clip area.
+ */
+void lv_draw_list_replay(const lv_draw_list_t * list, lv_layer_t * layer);
+
+/**
+ * Save a copy of a draw task if its layer is being recorded.
+ * Called by `lv_draw_finalize_task_creation`.
+ * @param layer     the layer of the draw task
+ * @param t         the new draw task
+ */
+void _lv_draw_list_record_task(lv_layer_t * layer, const lv_draw_task_t * t);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_LIST*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_LIST_H*/
@@ -0,0 +1,325 @@
+/**
+ * @file lv_draw_trace.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_trace.h"
+#if LV_USE_DRAW_TRACE
+
+#include "../core/lv_global.h"
+#include "../stdlib/lv_sprintf.h"
+#include "../stdlib/lv_string.h"
+#include "../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define trace_ctx LV_GLOBAL_DEFAULT()->draw_trace_context
+#define _draw_info LV_GLOBAL_DEFAULT()->draw_info
+
+#define TASK_TYPE_CNT   (LV_DRAW_TASK_TYPE_VECTOR + 1)
+#define STR_MAX_LEN     192
+#define TICK_PER_SEC_MAX 1000000
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** An executed draw task*/
+typedef struct {
+    uint32_t queued_tick;
+    uint32_t start_tick;
+    uint32_t end_tick;
+    uint32_t area_px;
+    uint8_t type;
+    uint8_t unit_idx;
+} lv_draw_trace_record_t;
+
+typedef struct _lv_draw_trace_ctx_t {
+    lv_draw_trace_record_t records[LV_DRAW_TRACE_RECORD_CNT];
+    uint32_t record_next;           /**< Index of the next record to write*/
+    uint32_t record_cnt;            /**< Number of valid records*/
+    lv_draw_trace_stat_t stats[TASK_TYPE_CNT];
+    uint32_t (*tick_get_cb)(void);
+    uint32_t tick_per_sec;
+    bool enable;
+    lv_mutex_t mutex;               /**< The draw units can finish the draw tasks in parallel*/
+} lv_draw_trace_ctx_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static uint32_t tick_to_us(uint32_t tick);
+static uint32_t get_unit_idx(lv_draw_unit_t * u);
+static const char * get_type_name(lv_draw_task_type_t type);
+static void default_flush_cb(const char * buf, void * user_data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_trace_init(void)
+{
+    if(trace_ctx) return;
+
+    trace_ctx = lv_malloc_zeroed(sizeof(lv_draw_trace_ctx_t));
+    LV_ASSERT_MALLOC(trace_ctx);
+    if(trace_ctx == NULL) return;
+
+    lv_mutex_init(&trace_ctx->mutex);
+    trace_ctx->tick_get_cb = lv_tick_get;
+    trace_ctx->tick_per_sec = 1000;
+    trace_ctx->enable = true;
+}
+
+void lv_draw_trace_deinit(void)
+{
+    if(trace_ctx == NULL) return;
+
+    lv_mutex_delete(&trace_ctx->mutex);
+    lv_free(trace_ctx);
+    trace_ctx = NULL;
+}
+
+void lv_draw_trace_set_enable(bool en)
+{
+    if(trace_ctx == NULL) return;
+
+    trace_ctx->enable = en;
+}
+
+void lv_draw_trace_set_tick_cb(uint32_t (*tick_get_cb)(void), uint32_t tick_per_sec)
+{
+    LV_ASSERT_NULL(tick_get_cb);
+    if(trace_ctx == NULL) return;
+
+    if(tick_per_sec == 0 || tick_per_sec > TICK_PER_SEC_MAX) {
+        LV_LOG_WARN("tick_per_sec range must be between 1~%d", TICK_PER_SEC_MAX);
+        return;
+    }
+
+    /*The old and new ticks can't be compared*/
+    lv_draw_trace_reset();
+
+    lv_mutex_lock(&trace_ctx->mutex);
+    trace_ctx->tick_get_cb = tick_get_cb;
+    trace_ctx->tick_per_sec = tick_per_sec;
+    lv_mutex_unlock(&trace_ctx->mutex);
+}
+
+void lv_draw_trace_reset(void)
+{
+    if(trace_ctx == NULL) return;
+
+    lv_mutex_lock(&trace_ctx->mutex);
+    trace_ctx->record_next = 0;
+    trace_ctx->record_cnt = 0;
+    lv_memzero(trace_ctx->stats, sizeof(trace_ctx->stats));
+    lv_mutex_unlock(&trace_ctx->mutex);
+}
+
+const lv_draw_trace_stat_t * lv_draw_trace_get_stat(lv_draw_task_type_t type)
+{
+    LV_ASSERT_NULL(trace_ctx);
+    LV_ASSERT(type < TASK_TYPE_CNT);
+
+    return &trace_ctx->stats[type];
+}
+
+void lv_draw_trace_dump_stat(void)
+{
+    if(trace_ctx == NULL) return;
+
+    lv_mutex_lock(&trace_ctx->mutex);
+    LV_LOG("type       count      pixels  wait avg [us]  exec avg [us]  exec max [us]\n");
+    uint32_t i;
+    for(i = 0; i < TASK_TYPE_CNT; i++) {
+        lv_draw_trace_stat_t * stat = &trace_ctx->stats[i];
+        if(stat->task_cnt == 0) continue;
+
+        LV_LOG("%-10s %5" LV_PRIu32 " %11" LV_PRIu32 " %14" LV_PRIu32 " %14" LV_PRIu32 " %14" LV_PRIu32 "\n",
+               get_type_name(i), stat->task_cnt, (uint32_t)stat->area_px_sum,
+               (uint32_t)(stat->wait_time_sum / stat->task_cnt),
+               (uint32_t)(stat->exec_time_sum / stat->task_cnt),
+               stat->exec_time_max);
+    }
+    lv_mutex_unlock(&trace_ctx->mutex);
+}
+
+void lv_draw_trace_dump_chrome(lv_draw_trace_flush_cb_t flush_cb, void * user_data)
+{
+    if(trace_ctx == NULL) return;
+    if(flush_cb == NULL) flush_cb = default_flush_cb;
+
+    lv_mutex_lock(&trace_ctx->mutex);
+
+    char buf[STR_MAX_LEN];
+    flush_cb("{\"traceEvents\":[\n", user_data);
+
+    /*Name the track of each draw unit*/
+    uint32_t unit_cnt = get_unit_idx(NULL);
+    uint32_t i;
+    for(i = 0; i < unit_cnt; i++) {
+        lv_snprintf(buf, sizeof(buf),
+                    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" LV_PRIu32
+                    ",\"args\":{\"name\":\"draw unit %" LV_PRIu32 "\"}},\n", i, i);
+        flush_cb(buf, user_data);
+    }
+
+    /*Start with the oldest record*/
+    uint32_t idx = (trace_ctx->record_next + LV_DRAW_TRACE_RECORD_CNT - trace_ctx->record_cnt) % LV_DRAW_TRACE_RECORD_CNT;
+    for(i = 0; i < trace_ctx->record_cnt; i++) {
+        lv_draw_trace_record_t * r = &trace_ctx->records[idx];
+        lv_snprintf(buf, sizeof(buf),
+                    "{\"name\":\"%s\",\"cat\":\"draw\",\"ph\":\"X\",\"pid\":1,\"tid\":%" LV_PRIu32
+                    ",\"ts\":%" LV_PRIu32 ",\"dur\":%" LV_PRIu32
+                    ",\"args\":{\"area_px\":%" LV_PRIu32 ",\"wait_us\":%" LV_PRIu32 "}}%s\n",
+                    get_type_name(r->type), (uint32_t)r->unit_idx,
+                    tick_to_us(r->start_tick), tick_to_us(r->end_tick - r->start_tick),
+                    r->area_px, tick_to_us(r->start_tick - r->queued_tick),
+                    i + 1 < trace_ctx->record_cnt ? "," : "");
+        flush_cb(buf, user_data);
+        idx = (idx + 1) % LV_DRAW_TRACE_RECORD_CNT;
+    }
+
+    /*Avoid a trailing comma if there are only metadata events*/
+    if(trace_ctx->record_cnt == 0) {
+        flush_cb("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"LVGL\"}}\n", user_data);
+    }
+
+    flush_cb("]}\n", user_data);
+    lv_mutex_unlock(&trace_ctx->mutex);
+}
+
+void _lv_draw_trace_task_queued(lv_draw_task_t * t)
+{
+    if(trace_ctx == NULL || !trace_ctx->enable) return;
+
+    t->trace_queued_tick = trace_ctx->tick_get_cb();
+}
+
+void _lv_draw_trace_task_start(lv_draw_unit_t * u, lv_draw_task_t * t)
+{
+    LV_UNUSED(u);
+    if(trace_ctx == NULL || !trace_ctx->enable) return;
+
+    t->trace_start_tick = trace_ctx->tick_get_cb();
+}
+
+void _lv_draw_trace_task_finish(lv_draw_unit_t * u, lv_draw_task_t * t)
+{
+    if(trace_ctx == NULL || !trace_ctx->enable) return;
+
+    uint32_t end_tick = trace_ctx->tick_get_cb();
+
+    lv_area_t draw_area;
+    uint32_t area_px = 0;
+    if(_lv_area_intersect(&draw_area, &t->_real_area, &t->clip_area)) area_px = lv_area_get_size(&draw_area);
+
+    /*If tracing was enabled in the meantime the task might have no queued time*/
+    uint32_t queued_tick = t->trace_queued_tick ? t->trace_queued_tick : t->trace_start_tick;
+    uint32_t wait_us = tick_to_us(t->trace_start_tick - queued_tick);
+    uint32_t exec_us = tick_to_us(end_tick - t->trace_start_tick);
+
+    uint32_t bin = 0;
+    while(bin < LV_DRAW_TRACE_HIST_BIN_CNT - 1 && exec_us >= ((uint32_t)1 << bin)) bin++;
+
+    uint32_t unit_idx = get_unit_idx(u);
+
+    lv_mutex_lock(&trace_ctx->mutex);
+    lv_draw_trace_stat_t * stat = &trace_ctx->stats[t->type];
+    stat->task_cnt++;
+    stat->area_px_sum += area_px;
+    stat->wait_time_sum += wait_us;
+    stat->exec_time_sum += exec_us;
+    if(exec_us > stat->exec_time_max) stat->exec_time_max = exec_us;
+    stat->exec_time_hist[bin]++;
+
+    lv_draw_trace_record_t * r = &trace_ctx->records[trace_ctx->record_next];
+    r->queued_tick = queued_tick;
+    r->start_tick = t->trace_start_tick;
+    r->end_tick = end_tick;
+    r->area_px = area_px;
+    r->type = t->type;
+    r->unit_idx = unit_idx;
+    trace_ctx->record_next = (trace_ctx->record_next + 1) % LV_DRAW_TRACE_RECORD_CNT;
+    if(trace_ctx->record_cnt < LV_DRAW_TRACE_RECORD_CNT) trace_ctx->record_cnt++;
+    lv_mutex_unlock(&trace_ctx->mutex);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t tick_to_us(uint32_t tick)
+{
+    return tick * (TICK_PER_SEC_MAX / trace_ctx->tick_per_sec);
+}
+
+/**
+ * Get the index of a draw unit in the list of draw units
+ * @param u     pointer to a draw unit or NULL to get the number of draw units
+ * @return      the index of the draw unit
+ */
+static uint32_t get_unit_idx(lv_draw_unit_t * u)
+{
+    uint32_t idx = 0;
+    lv_draw_unit_t * u_act = _draw_info.unit_head;
+    while(u_act && u_act != u) {
+        u_act = u_act->next;
+        idx++;
+    }
+
+    return idx;
+}
+
+static const char * get_type_name(lv_draw_task_type_t type)
+{
+    switch(type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            return "FILL";
+        case LV_DRAW_TASK_TYPE_BORDER:
+            return "BORDER";
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            return "BOX_SHADOW";
+        case LV_DRAW_TASK_TYPE_LABEL:
+            return "LABEL";
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            return "IMAGE";
+        case LV_DRAW_TASK_TYPE_LAYER:
+            return "LAYER";
+        case LV_DRAW_TASK_TYPE_LINE:
+            return "LINE";
+        case LV_DRAW_TASK_TYPE_ARC:
+            return "ARC";
+        case LV_DRAW_TASK_TYPE_TRIANGLE:
+            return "TRIANGLE";
+        case LV_DRAW_TASK_TYPE_MASK_RECTANGLE:
+            return "MASK_RECTANGLE";
+        case LV_DRAW_TASK_TYPE_MASK_BITMAP:
+            return "MASK_BITMAP";
+        case LV_DRAW_TASK_TYPE_VECTOR:
+            return "VECTOR";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+static void default_flush_cb(const char * buf, void * user_data)
+{
+    LV_UNUSED(user_data);
+    LV_LOG("%s", buf);
+}
+
+#endif /*LV_USE_DRAW_TRACE*/
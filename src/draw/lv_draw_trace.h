@@ -0,0 +1,131 @@
+/**
+ * @file lv_draw_trace.h
+ *
+ */
+
+#ifndef LV_DRAW_TRACE_H
+#define LV_DRAW_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw.h"
+
+#if LV_USE_DRAW_TRACE
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Number of the bins of the execution time histograms*/
+#define LV_DRAW_TRACE_HIST_BIN_CNT   20
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Aggregated statistics of a draw task type. The times are in microseconds.*/
+typedef struct {
+    uint32_t task_cnt;          /**< Number of executed draw tasks*/
+    uint64_t area_px_sum;       /**< Number of pixels covered by the draw tasks*/
+    uint64_t wait_time_sum;     /**< Time spent by the draw tasks in the queue before a draw unit has taken them*/
+    uint64_t exec_time_sum;     /**< Time spent with executing the draw tasks*/
+    uint32_t exec_time_max;     /**< Longest execution time*/
+
+    /** Histogram of the execution times.
+     * Bin 0: < 1 us, bin i: [2^(i-1), 2^i) us. The last bin also counts the longer times.*/
+    uint32_t exec_time_hist[LV_DRAW_TRACE_HIST_BIN_CNT];
+} lv_draw_trace_stat_t;
+
+/** Called with the consecutive parts of the dumped Chrome trace*/
+typedef void (*lv_draw_trace_flush_cb_t)(const char * buf, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Allocate the buffer for the traced draw tasks and enable tracing.
+ * Called by `lv_draw_init()`.
+ */
+void lv_draw_trace_init(void);
+
+/**
+ * Free the buffer of the traced draw tasks
+ */
+void lv_draw_trace_deinit(void);
+
+/**
+ * Enable or disable tracing the draw tasks
+ * @param en        true: enable; false: disable
+ */
+void lv_draw_trace_set_enable(bool en);
+
+/**
+ * Set a more precise time source than the default `lv_tick_get()`
+ * @param tick_get_cb   returns the current tick count
+ * @param tick_per_sec  number of ticks in a second. Max. 1000000
+ */
+void lv_draw_trace_set_tick_cb(uint32_t (*tick_get_cb)(void), uint32_t tick_per_sec);
+
+/**
+ * Clear the statistics and the traced draw tasks
+ */
+void lv_draw_trace_reset(void);
+
+/**
+ * Get the statistics of a draw task type since the last reset
+ * @param type      a draw task type
+ * @return          pointer to the statistics
+ */
+const lv_draw_trace_stat_t * lv_draw_trace_get_stat(lv_draw_task_type_t type);
+
+/**
+ * Print the statistics of all draw task types with `LV_LOG`
+ */
+void lv_draw_trace_dump_stat(void);
+
+/**
+ * Dump the last `LV_DRAW_TRACE_RECORD_CNT` draw tasks in Chrome's JSON trace event format.
+ * Each draw unit has its own track. The result can be opened in `chrome://tracing` or Perfetto.
+ * @param flush_cb  called with the consecutive parts of the JSON text. NULL: print with `LV_LOG`
+ * @param user_data passed to `flush_cb`
+ */
+void lv_draw_trace_dump_chrome(lv_draw_trace_flush_cb_t flush_cb, void * user_data);
+
+/**
+ * Save the time when a draw task was queued. Called by the draw pipeline.
+ * @param t         pointer to a draw task which has just become `LV_DRAW_TASK_STATE_QUEUED`
+ */
+void _lv_draw_trace_task_queued(lv_draw_task_t * t);
+
+/**
+ * Save the time when a draw unit started to execute a draw task.
+ * Draw units should call it right before drawing.
+ * @param u         pointer to the draw unit
+ * @param t         pointer to the draw task
+ */
+void _lv_draw_trace_task_start(lv_draw_unit_t * u, lv_draw_task_t * t);
+
+/**
+ * Record a draw task which has been executed. Draw units should call it right after drawing.
+ * @param u         pointer to the draw unit
+ * @param t         pointer to the draw task
+ */
+void _lv_draw_trace_task_finish(lv_draw_unit_t * u, lv_draw_task_t * t);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_TRACE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_TRACE_H*/
@@ -322,7 +322,7 @@ static int32_t _pxp_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     if(buf == NULL)
         return -1;
 
-    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    lv_draw_task_set_state(t, LV_DRAW_TASK_STATE_IN_PROGRESS);
     draw_pxp_unit->base_unit.target_layer = layer;
     draw_pxp_unit->base_unit.clip_area = &t->clip_area;
     draw_pxp_unit->task_act = t;
@@ -334,7 +334,7 @@ static int32_t _pxp_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
 #else
     _pxp_execute_drawing(draw_pxp_unit);
 
-    draw_pxp_unit->task_act->state = LV_DRAW_TASK_STATE_READY;
+    lv_draw_task_set_state(draw_pxp_unit->task_act, LV_DRAW_TASK_STATE_READY);
     draw_pxp_unit->task_act = NULL;
 
     /* The draw unit is free now. Request a new dispatching as it can get a new task. */
@@ -467,7 +467,7 @@ static void _pxp_render_thread_cb(void * ptr)
         _pxp_execute_drawing(u);
 
         /* Signal the ready state to dispatcher. */
-        u->task_act->state = LV_DRAW_TASK_STATE_READY;
+        lv_draw_task_set_state(u->task_act, LV_DRAW_TASK_STATE_READY);
 
         /* Cleanup. */
         u->task_act = NULL;
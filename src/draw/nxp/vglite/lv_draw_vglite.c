@@ -291,7 +291,7 @@ static int32_t _vglite_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     if(buf == NULL)
         return -1;
 
-    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    lv_draw_task_set_state(t, LV_DRAW_TASK_STATE_IN_PROGRESS);
     draw_vglite_unit->base_unit.target_layer = layer;
     draw_vglite_unit->base_unit.clip_area = &t->clip_area;
     draw_vglite_unit->task_act = t;
@@ -303,7 +303,7 @@ static int32_t _vglite_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
 #else
     _vglite_execute_drawing(draw_vglite_unit);
 
-    draw_vglite_unit->task_act->state = LV_DRAW_TASK_STATE_READY;
+    lv_draw_task_set_state(draw_vglite_unit->task_act, LV_DRAW_TASK_STATE_READY);
     draw_vglite_unit->task_act = NULL;
 
     /* The draw unit is free now. Request a new dispatching as it can get a new task. */
@@ -462,7 +462,7 @@ static inline void _vglite_signal_task_ready(lv_draw_task_t * task_act)
                 lv_draw_task_t * task = _draw_task_buf[i % VGLITE_TASK_BUF_SIZE].task;
 
                 /* Signal the ready state to dispatcher. */
-                task->state = LV_DRAW_TASK_STATE_READY;
+                lv_draw_task_set_state(task, LV_DRAW_TASK_STATE_READY);
                 _head = (_head + 1) % VGLITE_TASK_BUF_SIZE;
                 /* No need to cleanup the tasks in buffer as we advance with the _head. */
             }
@@ -527,7 +527,7 @@ static void _vglite_render_thread_cb(void * ptr)
         _vglite_signal_task_ready((void *)u->task_act);
 #else
         /* Signal the ready state to dispatcher. */
-        u->task_act->state = LV_DRAW_TASK_STATE_READY;
+        lv_draw_task_set_state(u->task_act, LV_DRAW_TASK_STATE_READY);
 #endif
         /* Cleanup. */
         u->task_act = NULL;
@@ -407,7 +407,7 @@ static int32_t lv_draw_dave2d_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t *
     *p_new_list_entry = t;
 #endif
 
-    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    lv_draw_task_set_state(t, LV_DRAW_TASK_STATE_IN_PROGRESS);
     draw_dave2d_unit->base_unit.target_layer = layer;
     draw_dave2d_unit->base_unit.clip_area = &t->clip_area;
     draw_dave2d_unit->task_act = t;
@@ -418,7 +418,7 @@ static int32_t lv_draw_dave2d_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t *
 #else
     execute_drawing(draw_dave2d_unit);
 #if  (D2_RENDER_EACH_OPERATION)
-    draw_dave2d_unit->task_act->state = LV_DRAW_TASK_STATE_READY;
+    lv_draw_task_set_state(draw_dave2d_unit->task_act, LV_DRAW_TASK_STATE_READY);
 #endif
     draw_dave2d_unit->task_act = NULL;
 
@@ -445,7 +445,7 @@ static void _dave2d_render_thread_cb(void * ptr)
 
         /*Cleanup*/
 #if  (D2_RENDER_EACH_OPERATION)
-        u->task_act->state = LV_DRAW_TASK_STATE_READY;
+        lv_draw_task_set_state(u->task_act, LV_DRAW_TASK_STATE_READY);
 #endif
         u->task_act = NULL;
 
@@ -619,7 +619,7 @@ void dave2d_execute_dlist_and_flush(void)
     while(false == _lv_ll_is_empty(&_ll_Dave2D_Tasks)) {
         p_list_entry = _lv_ll_get_tail(&_ll_Dave2D_Tasks);
         p_list_entry1 = *p_list_entry;
-        p_list_entry1->state = LV_DRAW_TASK_STATE_READY;
+        lv_draw_task_set_state(p_list_entry1, LV_DRAW_TASK_STATE_READY);
         _lv_ll_remove(&_ll_Dave2D_Tasks, p_list_entry);
         lv_free(p_list_entry);
     }
@@ -129,7 +129,7 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_SDL);
     if(t == NULL) return -1;
 
-    lv_display_t * disp = _lv_refr_get_disp_refreshing();
+    lv_display_t * disp = layer->disp;
     SDL_Texture * texture = layer_get_texture(layer);
     if(layer != disp->layer_head && texture == NULL) {
         void * buf = lv_draw_layer_alloc_buf(layer);
@@ -142,14 +142,14 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
                                              SDL_TEXTUREACCESS_TARGET, w, h);
     }
 
-    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    lv_draw_task_set_state(t, LV_DRAW_TASK_STATE_IN_PROGRESS);
     draw_sdl_unit->base_unit.target_layer = layer;
     draw_sdl_unit->base_unit.clip_area = &t->clip_area;
     draw_sdl_unit->task_act = t;
 
     execute_drawing(draw_sdl_unit);
 
-    draw_sdl_unit->task_act->state = LV_DRAW_TASK_STATE_READY;
+    lv_draw_task_set_state(draw_sdl_unit->task_act, LV_DRAW_TASK_STATE_READY);
     draw_sdl_unit->task_act = NULL;
 
     /*The draw unit is free now. Request a new dispatching as it can get a new task*/
@@ -183,7 +183,8 @@ static bool draw_to_texture(lv_draw_sdl_unit_t * u, cache_data_t * data)
     dest_layer._clip_area = task->area;
     lv_memzero(sdl_render_buf, lv_area_get_size(&dest_layer.buf_area) * 4 + 100);
 
-    lv_display_t * disp = _lv_refr_get_disp_refreshing();
+    lv_display_t * disp = u->base_unit.target_layer->disp;
+    dest_layer.disp = disp;
 
     SDL_Texture * texture = NULL;
     switch(task->type) {
@@ -306,7 +307,7 @@ static bool draw_to_texture(lv_draw_sdl_unit_t * u, cache_data_t * data)
 
 static void blend_texture_layer(lv_draw_sdl_unit_t * u)
 {
-    lv_display_t * disp = _lv_refr_get_disp_refreshing();
+    lv_display_t * disp = u->base_unit.target_layer->disp;
     SDL_Renderer * renderer = lv_sdl_window_get_renderer(disp);
 
     SDL_Rect clip_rect;
@@ -361,7 +362,7 @@ static void draw_from_cached_texture(lv_draw_sdl_unit_t * u)
 
     cache_data_t * data_cached = lv_cache_entry_get_data(entry_cached);
     SDL_Texture * texture = data_cached->texture;
-    lv_display_t * disp = _lv_refr_get_disp_refreshing();
+    lv_display_t * disp = u->base_unit.target_layer->disp;
     SDL_Renderer * renderer = lv_sdl_window_get_renderer(disp);
 
     lv_layer_t * dest_layer = u->base_unit.target_layer;
@@ -0,0 +1,633 @@
+/**
+ * @file lv_blend_avx2.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_avx2.h"
+#if LV_USE_DRAW_SW && LV_DRAW_SW_AVX2_AVAILABLE
+
+#include <immintrin.h>
+#include "../../../../misc/lv_color.h"
+#include "../../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of pixels processed at once*/
+#define PX_CNT  8
+
+/*Compile the functions for AVX2 even if it's not enabled globally*/
+#if defined(__GNUC__) || defined(__clang__)
+    #define AVX2_FUNC   __attribute__((target("avx2")))
+#else
+    #define AVX2_FUNC
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    DEST_RGB565,
+    DEST_XRGB8888,
+    DEST_ARGB8888,
+} dest_type_t;
+
+/**
+ * The parameters of a blend shared by the fill and image blend kernels.
+ * If `src` is NULL `color` is blended.
+ */
+typedef struct {
+    dest_type_t dest_type;
+    void * dest;
+    int32_t dest_stride;
+    int32_t w;
+    int32_t h;
+    const uint32_t * src;
+    int32_t src_stride;
+    uint32_t color32;
+    uint16_t color16;
+    const lv_opa_t * mask;
+    int32_t mask_stride;
+    lv_opa_t opa;
+} blend_params_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void blend(const blend_params_t * p);
+static void blend_row(const blend_params_t * p, void * dest, const uint32_t * src, const lv_opa_t * mask);
+static void blend_px(const blend_params_t * p, void * dest, const uint32_t * src, const lv_opa_t * mask);
+static void fill(const blend_params_t * p);
+static inline __m256i get_alpha(const blend_params_t * p, __m256i fg, const lv_opa_t * mask);
+static inline __m256i mix_channels(__m256i fg, __m256i bg, __m256i mix);
+static inline __m256i select_px(__m256i a, __m256i b, __m256i sel);
+static inline __m256i mix_16_16(__m256i fg, __m256i bg, __m256i mix);
+static inline __m256i mix_32_16(__m256i fg, __m256i bg, __m256i mix);
+static void mix_32_32_px(uint32_t * fg, const uint32_t * bg);
+static inline void get_neighbors(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, __m256i x,
+                                 int32_t px_size, int32_t stride, __m256i * ofs, __m256i * ofs_hor, __m256i * ofs_ver,
+                                 __m256i * xs_fract, __m256i * ys_fract);
+static inline __m256i mix_neighbor_32(__m256i c, __m256i n, __m256i fract);
+static inline __m256i mix_opa(__m256i fg, __m256i bg, __m256i mix);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_draw_sw_blend_color_to_rgb565_avx2(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_params_t p = {
+        .dest_type = DEST_RGB565,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .color16 = lv_color_to_u16(dsc->color),
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    if(p.mask == NULL && p.opa >= LV_OPA_MAX) fill(&p);
+    else blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_color_to_rgb888_avx2(_lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_params_t p = {
+        .dest_type = DEST_XRGB8888,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .color32 = lv_color_to_u32(dsc->color),
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    if(p.mask == NULL && p.opa >= LV_OPA_MAX) fill(&p);
+    else blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_color_to_argb8888_avx2(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_params_t p = {
+        .dest_type = DEST_ARGB8888,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .color32 = lv_color_to_u32(dsc->color),
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    if(p.mask == NULL && p.opa >= LV_OPA_MAX) fill(&p);
+    else blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb565_avx2(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_params_t p = {
+        .dest_type = DEST_RGB565,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .src = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb888_avx2(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_params_t p = {
+        .dest_type = DEST_XRGB8888,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .src = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_argb8888_to_argb8888_avx2(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_params_t p = {
+        .dest_type = DEST_ARGB8888,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .src = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    blend(&p);
+    return LV_RESULT_OK;
+}
+
+AVX2_FUNC int32_t lv_draw_sw_transform_argb8888_avx2(const uint8_t * src, int32_t src_stride, int32_t xs_ups,
+                                                     int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                                     int32_t x_start, int32_t x_end, uint32_t * dest_buf)
+{
+    __m256i xv = _mm256_add_epi32(_mm256_set1_epi32(x_start), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    int32_t x;
+    for(x = x_start; x <= x_end - PX_CNT; x += PX_CNT) {
+        __m256i ofs, ofs_hor, ofs_ver, xs_fract, ys_fract;
+        get_neighbors(xs_ups, ys_ups, xs_step, ys_step, xv, 4, src_stride, &ofs, &ofs_hor, &ofs_ver, &xs_fract, &ys_fract);
+
+        __m256i c = _mm256_i32gather_epi32((const int *)src, ofs, 1);
+        __m256i hor = _mm256_i32gather_epi32((const int *)src, ofs_hor, 1);
+        __m256i ver = _mm256_i32gather_epi32((const int *)src, ofs_ver, 1);
+
+        __m256i res = mix_neighbor_32(c, ver, ys_fract);
+        res = mix_neighbor_32(res, hor, xs_fract);
+        _mm256_storeu_si256((__m256i *)(dest_buf + x), res);
+
+        xv = _mm256_add_epi32(xv, _mm256_set1_epi32(PX_CNT));
+    }
+
+    return x;
+}
+
+AVX2_FUNC int32_t lv_draw_sw_transform_rgb565a8_avx2(const uint8_t * src, int32_t src_stride,
+                                                     const lv_opa_t * src_alpha, int32_t xs_ups, int32_t ys_ups,
+                                                     int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end,
+                                                     uint16_t * cbuf, uint8_t * abuf)
+{
+    int32_t alpha_stride = src_stride / 2;
+    __m256i u16_mask = _mm256_set1_epi32(0xFFFF);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i xv = _mm256_add_epi32(_mm256_set1_epi32(x_start), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    int32_t x;
+    for(x = x_start; x <= x_end - PX_CNT; x += PX_CNT) {
+        __m256i ofs, ofs_hor, ofs_ver, xs_fract, ys_fract;
+        get_neighbors(xs_ups, ys_ups, xs_step, ys_step, xv, 2, src_stride, &ofs, &ofs_hor, &ofs_ver, &xs_fract, &ys_fract);
+
+        /*The 4 byte loads don't leave the image as the pixels are not in the last column or row*/
+        __m256i c = _mm256_and_si256(_mm256_i32gather_epi32((const int *)src, ofs, 1), u16_mask);
+        __m256i hor = _mm256_and_si256(_mm256_i32gather_epi32((const int *)src, ofs_hor, 1), u16_mask);
+        __m256i ver = _mm256_and_si256(_mm256_i32gather_epi32((const int *)src, ofs_ver, 1), u16_mask);
+
+        /*The fractions are used in 0..254 range*/
+        xs_fract = _mm256_slli_epi32(xs_fract, 1);
+        ys_fract = _mm256_slli_epi32(ys_fract, 1);
+        __m256i v = mix_16_16(ver, c, ys_fract);
+        __m256i h = mix_16_16(hor, c, xs_fract);
+        __m256i res = mix_16_16(h, v, _mm256_set1_epi32(LV_OPA_50));
+
+        __m256i res_a;
+        if(src_alpha) {
+            get_neighbors(xs_ups, ys_ups, xs_step, ys_step, xv, 1, alpha_stride, &ofs, &ofs_hor, &ofs_ver,
+                          &xs_fract, &ys_fract);
+
+            /*Load the 4 bytes ending with the opacity. The RGB565 map is before the alpha map so it's safe.*/
+            const int * base = (const int *)(src_alpha - 3);
+            __m256i a = _mm256_srli_epi32(_mm256_i32gather_epi32(base, ofs, 1), 24);
+            __m256i a_hor = _mm256_srli_epi32(_mm256_i32gather_epi32(base, ofs_hor, 1), 24);
+            __m256i a_ver = _mm256_srli_epi32(_mm256_i32gather_epi32(base, ofs_ver, 1), 24);
+
+            a_ver = mix_opa(a_ver, a, _mm256_slli_epi32(ys_fract, 1));
+            a_hor = mix_opa(a_hor, a, _mm256_slli_epi32(xs_fract, 1));
+            res_a = _mm256_srli_epi32(_mm256_add_epi32(a_ver, a_hor), 1);
+
+            /*The color is not mixed if the pixel is transparent*/
+            res = select_px(res, c, _mm256_cmpeq_epi32(res_a, zero));
+        }
+        else {
+            res_a = _mm256_set1_epi32(0xFF);
+        }
+
+        /*Pack the 128 bit lanes separately and collect the results into the lower lane*/
+        res = _mm256_permute4x64_epi64(_mm256_packus_epi32(res, res), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128((__m128i *)(cbuf + x), _mm256_castsi256_si128(res));
+
+        res_a = _mm256_packus_epi32(res_a, res_a);
+        res_a = _mm256_packus_epi16(res_a, res_a);
+        int32_t a32[2] = {_mm256_cvtsi256_si32(res_a), _mm256_extract_epi32(res_a, 4)};
+        lv_memcpy(abuf + x, a32, sizeof(a32));
+
+        xv = _mm256_add_epi32(xv, _mm256_set1_epi32(PX_CNT));
+    }
+
+    return x;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void blend(const blend_params_t * p)
+{
+    uint8_t * dest = p->dest;
+    const uint8_t * src = (const uint8_t *)p->src;
+    const lv_opa_t * mask = p->mask;
+    int32_t y;
+    for(y = 0; y < p->h; y++) {
+        blend_row(p, dest, (const uint32_t *)src, mask);
+        dest += p->dest_stride;
+        if(src) src += p->src_stride;
+        if(mask) mask += p->mask_stride;
+    }
+}
+
+static void blend_row(const blend_params_t * p, void * dest, const uint32_t * src, const lv_opa_t * mask)
+{
+    uint32_t dest_px_size = p->dest_type == DEST_RGB565 ? 2 : 4;
+    uint8_t * dest_u8 = dest;
+    int32_t x;
+    for(x = 0; x <= p->w - PX_CNT; x += PX_CNT) {
+        blend_px(p, dest_u8 + x * dest_px_size, src ? src + x : NULL, mask ? mask + x : NULL);
+    }
+
+    /*Blend the remaining pixels in a temporary buffer to use the same kernel*/
+    int32_t rem = p->w - x;
+    if(rem > 0) {
+        uint32_t dest_tmp[PX_CNT] = {0};
+        uint32_t src_tmp[PX_CNT] = {0};
+        lv_opa_t mask_tmp[PX_CNT] = {0};
+        lv_memcpy(dest_tmp, dest_u8 + x * dest_px_size, rem * dest_px_size);
+        if(src) lv_memcpy(src_tmp, src + x, rem * sizeof(uint32_t));
+        if(mask) lv_memcpy(mask_tmp, mask + x, rem);
+        blend_px(p, dest_tmp, src ? src_tmp : NULL, mask ? mask_tmp : NULL);
+        lv_memcpy(dest_u8 + x * dest_px_size, dest_tmp, rem * dest_px_size);
+    }
+}
+
+/**
+ * Blend `PX_CNT` pixels
+ */
+AVX2_FUNC static void blend_px(const blend_params_t * p, void * dest, const uint32_t * src, const lv_opa_t * mask)
+{
+    __m256i fg = src ? _mm256_loadu_si256((const __m256i *)src) : _mm256_set1_epi32((int32_t)p->color32);
+    __m256i a = get_alpha(p, fg, mask);
+    __m256i zero = _mm256_setzero_si256();
+
+    if(p->dest_type == DEST_RGB565) {
+        __m256i bg = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)dest));
+        __m256i res;
+        if(src) res = mix_32_16(fg, bg, a);
+        else res = mix_16_16(_mm256_set1_epi32(p->color16), bg, a);
+
+        /*Pack the 128 bit lanes separately and collect the results into the lower lane*/
+        res = _mm256_permute4x64_epi64(_mm256_packus_epi32(res, res), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128((__m128i *)dest, _mm256_castsi256_si128(res));
+    }
+    else if(p->dest_type == DEST_XRGB8888) {
+        /*Keep the X channel of the destination*/
+        __m256i bg = _mm256_loadu_si256((const __m256i *)dest);
+        __m256i rgb_mask = _mm256_set1_epi32(0x00FFFFFF);
+        __m256i x_ch = _mm256_andnot_si256(rgb_mask, bg);
+        __m256i res = _mm256_or_si256(_mm256_and_si256(mix_channels(fg, bg, a), rgb_mask), x_ch);
+        __m256i cover = _mm256_or_si256(_mm256_and_si256(fg, rgb_mask), x_ch);
+        res = select_px(res, cover, _mm256_cmpgt_epi32(a, _mm256_set1_epi32(LV_OPA_MAX - 1)));
+        res = select_px(res, bg, _mm256_cmpeq_epi32(a, zero));
+        _mm256_storeu_si256((__m256i *)dest, res);
+    }
+    else {
+        __m256i bg = _mm256_loadu_si256((const __m256i *)dest);
+        __m256i bg_a = _mm256_srli_epi32(bg, 24);
+        fg = _mm256_or_si256(_mm256_and_si256(fg, _mm256_set1_epi32(0x00FFFFFF)), _mm256_slli_epi32(a, 24));
+
+        /*Opaque or transparent pixels are simple. Mixing with an opaque background is simple too.*/
+        __m256i use_fg = _mm256_or_si256(_mm256_cmpgt_epi32(a, _mm256_set1_epi32(LV_OPA_MAX - 1)),
+                                         _mm256_cmpgt_epi32(_mm256_set1_epi32(LV_OPA_MIN + 1), bg_a));
+        __m256i use_bg = _mm256_andnot_si256(use_fg, _mm256_cmpgt_epi32(_mm256_set1_epi32(LV_OPA_MIN + 1), a));
+        __m256i simple = _mm256_or_si256(_mm256_or_si256(use_fg, use_bg),
+                                         _mm256_cmpeq_epi32(bg_a, _mm256_set1_epi32(0xFF)));
+
+        if(_mm256_movemask_epi8(simple) == -1) {
+            __m256i res = _mm256_or_si256(mix_channels(fg, bg, a), _mm256_set1_epi32((int32_t)0xFF000000));
+            res = select_px(res, fg, use_fg);
+            res = select_px(res, bg, use_bg);
+            _mm256_storeu_si256((__m256i *)dest, res);
+        }
+        else {
+            /*Both colors are semi-transparent: needs division so calculate by pixel*/
+            uint32_t fg_px[PX_CNT];
+            _mm256_storeu_si256((__m256i *)fg_px, fg);
+            uint32_t * dest_u32 = dest;
+            uint32_t i;
+            for(i = 0; i < PX_CNT; i++) {
+                mix_32_32_px(&fg_px[i], &dest_u32[i]);
+                dest_u32[i] = fg_px[i];
+            }
+        }
+    }
+}
+
+AVX2_FUNC static void fill(const blend_params_t * p)
+{
+    uint8_t * dest = p->dest;
+    int32_t x;
+    int32_t y;
+    if(p->dest_type == DEST_RGB565) {
+        __m256i c = _mm256_set1_epi16((int16_t)p->color16);
+        for(y = 0; y < p->h; y++) {
+            uint16_t * dest_u16 = (uint16_t *)dest;
+            for(x = 0; x <= p->w - 16; x += 16) {
+                _mm256_storeu_si256((__m256i *)&dest_u16[x], c);
+            }
+            for(; x < p->w; x++) {
+                dest_u16[x] = p->color16;
+            }
+            dest += p->dest_stride;
+        }
+    }
+    else {
+        __m256i c = _mm256_set1_epi32((int32_t)p->color32);
+        for(y = 0; y < p->h; y++) {
+            uint32_t * dest_u32 = (uint32_t *)dest;
+            for(x = 0; x <= p->w - 8; x += 8) {
+                _mm256_storeu_si256((__m256i *)&dest_u32[x], c);
+            }
+            for(; x < p->w; x++) {
+                dest_u32[x] = p->color32;
+            }
+            dest += p->dest_stride;
+        }
+    }
+}
+
+/**
+ * Get the opacity of the pixels the same way as the C implementation does
+ * @param p     the blend parameters
+ * @param fg    the foreground pixels. Only the alpha channel of the images are used
+ * @param mask  pointer to the mask values of the pixels or NULL if there is no mask
+ * @return      the opacities in 32 bit lanes
+ */
+AVX2_FUNC static inline __m256i get_alpha(const blend_params_t * p, __m256i fg, const lv_opa_t * mask)
+{
+    __m256i opa = _mm256_set1_epi32(p->opa);
+    __m256i m = opa;
+    if(mask) m = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)mask));
+
+    if(p->src) {
+        __m256i a = _mm256_srli_epi32(fg, 24);
+        if(mask && p->opa < LV_OPA_MAX) {
+            return _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_mullo_epi32(a, m), opa), 16);
+        }
+        else if(mask) return _mm256_srli_epi32(_mm256_mullo_epi32(a, m), 8);
+        else if(p->opa < LV_OPA_MAX) return _mm256_srli_epi32(_mm256_mullo_epi32(a, opa), 8);
+        else return a;
+    }
+    else {
+        if(mask && p->opa < LV_OPA_MAX) return _mm256_srli_epi32(_mm256_mullo_epi32(m, opa), 8);
+        else return m;
+    }
+}
+
+/**
+ * Mix all the channels of ARGB8888 pixels as `lv_color_mix32()`
+ */
+AVX2_FUNC static inline __m256i mix_channels(__m256i fg, __m256i bg, __m256i mix)
+{
+    /*The unpacking and packing work in the 128 bit lanes so the order of the pixels is kept*/
+    __m256i zero = _mm256_setzero_si256();
+    __m256i mix2 = _mm256_or_si256(mix, _mm256_slli_epi32(mix, 16));
+    __m256i mix_lo = _mm256_unpacklo_epi32(mix2, mix2);
+    __m256i mix_hi = _mm256_unpackhi_epi32(mix2, mix2);
+    __m256i ff = _mm256_set1_epi16(0xFF);
+
+    __m256i res_lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(fg, zero), mix_lo),
+                                      _mm256_mullo_epi16(_mm256_unpacklo_epi8(bg, zero), _mm256_sub_epi16(ff, mix_lo)));
+    __m256i res_hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(fg, zero), mix_hi),
+                                      _mm256_mullo_epi16(_mm256_unpackhi_epi8(bg, zero), _mm256_sub_epi16(ff, mix_hi)));
+
+    return _mm256_packus_epi16(_mm256_srli_epi16(res_lo, 8), _mm256_srli_epi16(res_hi, 8));
+}
+
+/**
+ * Return `b` where `sel` is all 1 and `a` elsewhere
+ */
+AVX2_FUNC static inline __m256i select_px(__m256i a, __m256i b, __m256i sel)
+{
+    return _mm256_blendv_epi8(a, b, sel);
+}
+
+/**
+ * Mix RGB565 colors in 32 bit lanes as `lv_color_16_16_mix()`
+ */
+AVX2_FUNC static inline __m256i mix_16_16(__m256i fg, __m256i bg, __m256i mix)
+{
+    /*0x7E0F81F = 0b00000111111000001111100000011111*/
+    __m256i m = _mm256_set1_epi32(0x7E0F81F);
+    fg = _mm256_and_si256(_mm256_or_si256(fg, _mm256_slli_epi32(fg, 16)), m);
+    bg = _mm256_and_si256(_mm256_or_si256(bg, _mm256_slli_epi32(bg, 16)), m);
+    mix = _mm256_srli_epi32(_mm256_add_epi32(mix, _mm256_set1_epi32(4)), 3);
+
+    __m256i res = _mm256_mullo_epi32(_mm256_sub_epi32(fg, bg), mix);
+    res = _mm256_and_si256(_mm256_add_epi32(_mm256_srli_epi32(res, 5), bg), m);
+    return _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi32(res, 16), res), _mm256_set1_epi32(0xFFFF));
+}
+
+/**
+ * Mix ARGB8888 colors to RGB565 colors in 32 bit lanes as `lv_color_24_16_mix()`
+ */
+AVX2_FUNC static inline __m256i mix_32_16(__m256i fg, __m256i bg, __m256i mix)
+{
+    __m256i mask5 = _mm256_set1_epi32(0x1F);
+    __m256i mask6 = _mm256_set1_epi32(0x3F);
+    __m256i fg_r = _mm256_and_si256(_mm256_srli_epi32(fg, 19), mask5);
+    __m256i fg_g = _mm256_and_si256(_mm256_srli_epi32(fg, 10), mask6);
+    __m256i fg_b = _mm256_and_si256(_mm256_srli_epi32(fg, 3), mask5);
+    __m256i bg_r = _mm256_and_si256(_mm256_srli_epi32(bg, 11), mask5);
+    __m256i bg_g = _mm256_and_si256(_mm256_srli_epi32(bg, 5), mask6);
+    __m256i bg_b = _mm256_and_si256(bg, mask5);
+    __m256i mix_inv = _mm256_sub_epi32(_mm256_set1_epi32(255), mix);
+
+    __m256i r = _mm256_add_epi32(_mm256_mullo_epi32(fg_r, mix), _mm256_mullo_epi32(bg_r, mix_inv));
+    __m256i g = _mm256_add_epi32(_mm256_mullo_epi32(fg_g, mix), _mm256_mullo_epi32(bg_g, mix_inv));
+    __m256i b = _mm256_add_epi32(_mm256_mullo_epi32(fg_b, mix), _mm256_mullo_epi32(bg_b, mix_inv));
+    __m256i res = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi32(r, 3), _mm256_set1_epi32(0xF800)),
+                                  _mm256_and_si256(_mm256_srli_epi32(g, 3), _mm256_set1_epi32(0x07E0)));
+    res = _mm256_or_si256(res, _mm256_srli_epi32(b, 8));
+
+    __m256i cover = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(fg_r, 11), _mm256_slli_epi32(fg_g, 5)), fg_b);
+    res = select_px(res, cover, _mm256_cmpeq_epi32(mix, _mm256_set1_epi32(255)));
+    res = select_px(res, bg, _mm256_cmpeq_epi32(mix, _mm256_setzero_si256()));
+    return res;
+}
+
+/**
+ * Mix ARGB8888 colors with alpha as `lv_color_32_32_mix()` of the C implementation
+ * @param fg    the foreground color. The result is written here.
+ * @param bg    the background color
+ */
+static void mix_32_32_px(uint32_t * fg, const uint32_t * bg)
+{
+    lv_color32_t fg_c;
+    lv_color32_t bg_c;
+    lv_memcpy(&fg_c, fg, sizeof(fg_c));
+    lv_memcpy(&bg_c, bg, sizeof(bg_c));
+
+    lv_color32_t res;
+    if(fg_c.alpha >= LV_OPA_MAX || bg_c.alpha <= LV_OPA_MIN) {
+        res = fg_c;
+    }
+    else if(fg_c.alpha <= LV_OPA_MIN) {
+        res = bg_c;
+    }
+    else if(bg_c.alpha == 255) {
+        res = lv_color_mix32(fg_c, bg_c);
+    }
+    else {
+        lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - fg_c.alpha, 255 - bg_c.alpha);
+        fg_c.alpha = (uint32_t)((uint32_t)fg_c.alpha * 255) / res_alpha;
+        res = lv_color_mix32(fg_c, bg_c);
+        res.alpha = res_alpha;
+    }
+
+    lv_memcpy(fg, &res, sizeof(res));
+}
+
+/**
+ * Get the source pixels and their neighbors used by the transformation as the C implementation does
+ * @param xs_ups        upscaled source X coordinate of the first pixel of the row
+ * @param ys_ups        upscaled source Y coordinate of the first pixel of the row
+ * @param xs_step       upscaled X step between the pixels
+ * @param ys_step       upscaled Y step between the pixels
+ * @param x             indices of the pixels in the row
+ * @param px_size       size of a source pixel in bytes
+ * @param stride        stride of the source image in bytes
+ * @param ofs           store the offset of the pixels in the source here
+ * @param ofs_hor       store the offset of the horizontal neighbors here
+ * @param ofs_ver       store the offset of the vertical neighbors here
+ * @param xs_fract      store the weight of the horizontal neighbors here (0..0x7F)
+ * @param ys_fract      store the weight of the vertical neighbors here (0..0x7F)
+ */
+AVX2_FUNC static inline void get_neighbors(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                           __m256i x, int32_t px_size, int32_t stride, __m256i * ofs,
+                                           __m256i * ofs_hor, __m256i * ofs_ver, __m256i * xs_fract, __m256i * ys_fract)
+{
+    __m256i xs = _mm256_add_epi32(_mm256_set1_epi32(xs_ups),
+                                  _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(xs_step), x), 8));
+    __m256i ys = _mm256_add_epi32(_mm256_set1_epi32(ys_ups),
+                                  _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(ys_step), x), 8));
+    __m256i ff = _mm256_set1_epi32(0xFF);
+    __m256i half = _mm256_set1_epi32(0x80);
+    __m256i xf = _mm256_and_si256(xs, ff);
+    __m256i yf = _mm256_and_si256(ys, ff);
+    __m256i x_prev = _mm256_cmpgt_epi32(half, xf);
+    __m256i y_prev = _mm256_cmpgt_epi32(half, yf);
+
+    *ofs = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(ys, 8), _mm256_set1_epi32(stride)),
+                            _mm256_mullo_epi32(_mm256_srai_epi32(xs, 8), _mm256_set1_epi32(px_size)));
+    *ofs_hor = _mm256_add_epi32(*ofs, select_px(_mm256_set1_epi32(px_size), _mm256_set1_epi32(-px_size), x_prev));
+    *ofs_ver = _mm256_add_epi32(*ofs, select_px(_mm256_set1_epi32(stride), _mm256_set1_epi32(-stride), y_prev));
+    *xs_fract = select_px(_mm256_sub_epi32(xf, half), _mm256_sub_epi32(_mm256_set1_epi32(0x7F), xf), x_prev);
+    *ys_fract = select_px(_mm256_sub_epi32(yf, half), _mm256_sub_epi32(_mm256_set1_epi32(0x7F), yf), y_prev);
+}
+
+/**
+ * Mix a neighbor into ARGB8888 pixels as the interior pixels of `transform_argb8888()`
+ * @param c         the pixels
+ * @param n         the neighbors
+ * @param fract     weight of the neighbors in 32 bit lanes (0..0x7F)
+ * @return          the mixed pixels
+ */
+AVX2_FUNC static inline __m256i mix_neighbor_32(__m256i c, __m256i n, __m256i fract)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i res = mix_channels(n, c, fract);
+
+    /*Same pixels are not mixed. If the neighbor is transparent or the weight is small only the alpha is mixed.*/
+    __m256i same = _mm256_cmpeq_epi32(c, n);
+    __m256i keep_rgb = _mm256_or_si256(_mm256_or_si256(same, _mm256_cmpeq_epi32(_mm256_srli_epi32(n, 24), zero)),
+                                       _mm256_cmpgt_epi32(_mm256_set1_epi32(LV_OPA_MIN + 1), fract));
+    __m256i keep = _mm256_or_si256(_mm256_and_si256(keep_rgb, _mm256_set1_epi32(0x00FFFFFF)),
+                                   _mm256_and_si256(same, _mm256_set1_epi32((int32_t)0xFF000000)));
+    return select_px(res, c, keep);
+}
+
+/**
+ * Mix opacities in 32 bit lanes as the alpha channel of `transform_rgb565a8()`.
+ * The result is the same if `fg == bg` so it's not checked.
+ */
+AVX2_FUNC static inline __m256i mix_opa(__m256i fg, __m256i bg, __m256i mix)
+{
+    __m256i mix_inv = _mm256_sub_epi32(_mm256_set1_epi32(0x100), mix);
+    return _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(fg, mix), _mm256_mullo_epi32(bg, mix_inv)), 8);
+}
+
+#endif /*LV_USE_DRAW_SW && LV_DRAW_SW_AVX2_AVAILABLE*/
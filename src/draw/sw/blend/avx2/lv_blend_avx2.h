@@ -0,0 +1,271 @@
+/**
+ * @file lv_blend_avx2.h
+ *
+ */
+
+#ifndef LV_BLEND_AVX2_H
+#define LV_BLEND_AVX2_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../lv_conf_internal.h"
+
+/* detect whether the compiler can generate AVX2 code. The functions are compiled for AVX2 even if it's not enabled
+ * for the whole project so the CPU running the AVX2 functions must support it.*/
+#if defined(__AVX2__) || defined(_M_X64) || defined(_M_AMD64) || \
+    ((defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)))
+#define LV_DRAW_SW_AVX2_AVAILABLE   1
+#else
+#define LV_DRAW_SW_AVX2_AVAILABLE   0
+#endif
+
+#if LV_USE_DRAW_SW && LV_DRAW_SW_AVX2_AVAILABLE
+
+#ifdef LV_DRAW_SW_AVX2_CUSTOM_INCLUDE
+#include LV_DRAW_SW_AVX2_CUSTOM_INCLUDE
+#endif
+
+#include "../lv_draw_sw_blend.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The kernels check `opa` and `mask_buf` so all the variants of a blend can use the same function*/
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) \
+    lv_draw_sw_blend_color_to_rgb565_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    lv_draw_sw_blend_color_to_rgb565_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) \
+    lv_draw_sw_blend_color_to_rgb565_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) \
+    lv_draw_sw_blend_color_to_rgb565_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc)  \
+    lv_draw_sw_blend_argb8888_to_rgb565_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    lv_draw_sw_blend_argb8888_to_rgb565_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    lv_draw_sw_blend_argb8888_to_rgb565_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    lv_draw_sw_blend_argb8888_to_rgb565_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888(dsc, dst_px_size) \
+    lv_draw_sw_blend_color_to_rgb888_avx2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA(dsc, dst_px_size) \
+    lv_draw_sw_blend_color_to_rgb888_avx2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK(dsc, dst_px_size) \
+    lv_draw_sw_blend_color_to_rgb888_avx2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA(dsc, dst_px_size) \
+    lv_draw_sw_blend_color_to_rgb888_avx2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888(dsc, dst_px_size)  \
+    lv_draw_sw_blend_argb8888_to_rgb888_avx2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA(dsc, dst_px_size)  \
+    lv_draw_sw_blend_argb8888_to_rgb888_avx2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK(dsc, dst_px_size)  \
+    lv_draw_sw_blend_argb8888_to_rgb888_avx2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA(dsc, dst_px_size)  \
+    lv_draw_sw_blend_argb8888_to_rgb888_avx2(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888(dsc) \
+    lv_draw_sw_blend_color_to_argb8888_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA(dsc) \
+    lv_draw_sw_blend_color_to_argb8888_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK(dsc) \
+    lv_draw_sw_blend_color_to_argb8888_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA(dsc) \
+    lv_draw_sw_blend_color_to_argb8888_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888(dsc)  \
+    lv_draw_sw_blend_argb8888_to_argb8888_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc)  \
+    lv_draw_sw_blend_argb8888_to_argb8888_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc)  \
+    lv_draw_sw_blend_argb8888_to_argb8888_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc)  \
+    lv_draw_sw_blend_argb8888_to_argb8888_avx2(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888
+#define LV_DRAW_SW_TRANSFORM_ARGB8888(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_buf) \
+    lv_draw_sw_transform_argb8888_avx2(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_buf)
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_RGB565A8
+#define LV_DRAW_SW_TRANSFORM_RGB565A8(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, cbuf, abuf) \
+    lv_draw_sw_transform_rgb565a8_avx2(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, cbuf, abuf)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Fill an RGB565 buffer with a color using AVX2.
+ * The result is the same as the result of `lv_draw_sw_blend_color_to_rgb565()`.
+ * @param dsc       pointer to a fill descriptor
+ * @return          LV_RESULT_OK: the area is filled
+ */
+lv_result_t lv_draw_sw_blend_color_to_rgb565_avx2(_lv_draw_sw_blend_fill_dsc_t * dsc);
+
+/**
+ * Fill an XRGB8888 buffer with a color using AVX2.
+ * @param dsc           pointer to a fill descriptor
+ * @param dest_px_size  size of the destination pixels in bytes
+ * @return              LV_RESULT_OK: the area is filled;
+ *                      LV_RESULT_INVALID: not supported (RGB888), use the C implementation
+ */
+lv_result_t lv_draw_sw_blend_color_to_rgb888_avx2(_lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size);
+
+/**
+ * Fill an ARGB8888 buffer with a color using AVX2.
+ * @param dsc       pointer to a fill descriptor
+ * @return          LV_RESULT_OK: the area is filled
+ */
+lv_result_t lv_draw_sw_blend_color_to_argb8888_avx2(_lv_draw_sw_blend_fill_dsc_t * dsc);
+
+/**
+ * Blend an ARGB8888 image to an RGB565 buffer with normal blend mode using AVX2.
+ * @param dsc       pointer to an image blend descriptor
+ * @return          LV_RESULT_OK: the image is blended
+ */
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb565_avx2(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+/**
+ * Blend an ARGB8888 image to an XRGB8888 buffer with normal blend mode using AVX2.
+ * @param dsc           pointer to an image blend descriptor
+ * @param dest_px_size  size of the destination pixels in bytes
+ * @return              LV_RESULT_OK: the image is blended;
+ *                      LV_RESULT_INVALID: not supported (RGB888), use the C implementation
+ */
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb888_avx2(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size);
+
+/**
+ * Blend an ARGB8888 image to an ARGB8888 buffer with normal blend mode using AVX2.
+ * @param dsc       pointer to an image blend descriptor
+ * @return          LV_RESULT_OK: the image is blended
+ */
+lv_result_t lv_draw_sw_blend_argb8888_to_argb8888_avx2(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+/**
+ * Transform anti-aliased ARGB8888 pixels using AVX2.
+ * The pixels and their neighbors need to be in the image.
+ * @param src           the source image
+ * @param src_stride    stride of the source image in bytes
+ * @param xs_ups        upscaled source X coordinate of the first pixel of the row
+ * @param ys_ups        upscaled source Y coordinate of the first pixel of the row
+ * @param xs_step       upscaled X step between the pixels
+ * @param ys_step       upscaled Y step between the pixels
+ * @param x_start       the first pixel to transform
+ * @param x_end         the pixel after the last pixel to transform
+ * @param dest_buf      the destination row
+ * @return              the first pixel which is not transformed
+ */
+int32_t lv_draw_sw_transform_argb8888_avx2(const uint8_t * src, int32_t src_stride, int32_t xs_ups, int32_t ys_ups,
+                                           int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end,
+                                           uint32_t * dest_buf);
+
+/**
+ * Transform anti-aliased RGB565 or RGB565A8 pixels using AVX2.
+ * The pixels and their neighbors need to be in the image.
+ * @param src           the source image
+ * @param src_stride    stride of the source image in bytes
+ * @param src_alpha     the alpha map of the source or NULL for RGB565
+ * @param xs_ups        upscaled source X coordinate of the first pixel of the row
+ * @param ys_ups        upscaled source Y coordinate of the first pixel of the row
+ * @param xs_step       upscaled X step between the pixels
+ * @param ys_step       upscaled Y step between the pixels
+ * @param x_start       the first pixel to transform
+ * @param x_end         the pixel after the last pixel to transform
+ * @param cbuf          the destination row of the colors
+ * @param abuf          the destination row of the opacities
+ * @return              the first pixel which is not transformed
+ */
+int32_t lv_draw_sw_transform_rgb565a8_avx2(const uint8_t * src, int32_t src_stride, const lv_opa_t * src_alpha,
+                                           int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                           int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf);
+
+#endif /*LV_USE_DRAW_SW && LV_DRAW_SW_AVX2_AVAILABLE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_AVX2_H*/
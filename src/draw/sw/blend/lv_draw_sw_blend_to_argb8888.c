@@ -20,6 +20,12 @@
     #include "neon/lv_blend_neon.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
     #include "helium/lv_blend_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2
+    #include "sse2/lv_blend_sse2.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+    #include "avx2/lv_blend_avx2.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+    #include "x86/lv_blend_x86.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
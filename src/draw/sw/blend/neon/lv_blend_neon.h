@@ -23,6 +23,14 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+
+/* The transformation kernels are written with intrinsics, so they need a compiler with NEON enabled */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE    1
+#else
+#define LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE    0
+#endif
+
 #if !defined(__ASSEMBLY__)
 
 #ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565
@@ -265,6 +273,20 @@ extern "C" {
     _lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_neon(dsc)
 #endif
 
+#if LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE
+
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888
+#define LV_DRAW_SW_TRANSFORM_ARGB8888(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_buf) \
+    lv_draw_sw_transform_argb8888_neon(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_buf)
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_RGB565A8
+#define LV_DRAW_SW_TRANSFORM_RGB565A8(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, cbuf, abuf) \
+    lv_draw_sw_transform_rgb565a8_neon(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, cbuf, abuf)
+#endif
+
+#endif /*LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -1282,6 +1304,48 @@ static inline lv_result_t _lv_argb8888_blend_normal_to_argb8888_mix_mask_opa_neo
     return LV_RESULT_OK;
 }
 
+#if LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE
+
+/**
+ * Transform anti-aliased ARGB8888 pixels using NEON.
+ * The pixels and their neighbors need to be in the image.
+ * @param src           the source image
+ * @param src_stride    stride of the source image in bytes
+ * @param xs_ups        upscaled source X coordinate of the first pixel of the row
+ * @param ys_ups        upscaled source Y coordinate of the first pixel of the row
+ * @param xs_step       upscaled X step between the pixels
+ * @param ys_step       upscaled Y step between the pixels
+ * @param x_start       the first pixel to transform
+ * @param x_end         the pixel after the last pixel to transform
+ * @param dest_buf      the destination row
+ * @return              the first pixel which is not transformed
+ */
+int32_t lv_draw_sw_transform_argb8888_neon(const uint8_t * src, int32_t src_stride, int32_t xs_ups, int32_t ys_ups,
+                                           int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end,
+                                           uint32_t * dest_buf);
+
+/**
+ * Transform anti-aliased RGB565 or RGB565A8 pixels using NEON.
+ * The pixels and their neighbors need to be in the image.
+ * @param src           the source image
+ * @param src_stride    stride of the source image in bytes
+ * @param src_alpha     the alpha map of the source or NULL for RGB565
+ * @param xs_ups        upscaled source X coordinate of the first pixel of the row
+ * @param ys_ups        upscaled source Y coordinate of the first pixel of the row
+ * @param xs_step       upscaled X step between the pixels
+ * @param ys_step       upscaled Y step between the pixels
+ * @param x_start       the first pixel to transform
+ * @param x_end         the pixel after the last pixel to transform
+ * @param cbuf          the destination row of the colors
+ * @param abuf          the destination row of the opacities
+ * @return              the first pixel which is not transformed
+ */
+int32_t lv_draw_sw_transform_rgb565a8_neon(const uint8_t * src, int32_t src_stride, const lv_opa_t * src_alpha,
+                                           int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                           int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf);
+
+#endif /*LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE*/
+
 #endif /* !defined(__ASSEMBLY__) */
 
 /**********************
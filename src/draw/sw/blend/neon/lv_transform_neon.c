@@ -0,0 +1,266 @@
+/**
+ * @file lv_transform_neon.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_draw_sw_blend.h"
+#if LV_USE_DRAW_SW
+
+#include "lv_blend_neon.h"
+#if LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE
+
+#include <arm_neon.h>
+#include "../../../../misc/lv_color.h"
+#include "../../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of pixels processed at once*/
+#define PX_CNT  4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline void get_neighbors(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, int32_t x,
+                                 int32_t px_size, int32_t stride, int32_t * ofs, int32_t * ofs_hor, int32_t * ofs_ver,
+                                 uint32_t * xs_fract, uint32_t * ys_fract);
+static inline uint32x4_t mix_channels(uint32x4_t fg, uint32x4_t bg, uint32x4_t mix);
+static inline uint32x4_t mix_neighbor_32(uint32x4_t c, uint32x4_t n, uint32x4_t fract);
+static inline uint32x4_t mix_16_16(uint32x4_t fg, uint32x4_t bg, uint32x4_t mix);
+static inline uint32x4_t mix_opa(uint32x4_t fg, uint32x4_t bg, uint32x4_t mix);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int32_t lv_draw_sw_transform_argb8888_neon(const uint8_t * src, int32_t src_stride, int32_t xs_ups, int32_t ys_ups,
+                                           int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end,
+                                           uint32_t * dest_buf)
+{
+    int32_t x;
+    for(x = x_start; x <= x_end - PX_CNT; x += PX_CNT) {
+        uint32_t c[PX_CNT];
+        uint32_t hor[PX_CNT];
+        uint32_t ver[PX_CNT];
+        uint32_t xs_fract[PX_CNT];
+        uint32_t ys_fract[PX_CNT];
+        uint32_t i;
+        for(i = 0; i < PX_CNT; i++) {
+            int32_t ofs, ofs_hor, ofs_ver;
+            get_neighbors(xs_ups, ys_ups, xs_step, ys_step, x + i, 4, src_stride, &ofs, &ofs_hor, &ofs_ver,
+                          &xs_fract[i], &ys_fract[i]);
+            c[i] = *(const uint32_t *)(src + ofs);
+            hor[i] = *(const uint32_t *)(src + ofs_hor);
+            ver[i] = *(const uint32_t *)(src + ofs_ver);
+        }
+
+        uint32x4_t res = mix_neighbor_32(vld1q_u32(c), vld1q_u32(ver), vld1q_u32(ys_fract));
+        res = mix_neighbor_32(res, vld1q_u32(hor), vld1q_u32(xs_fract));
+        vst1q_u32(dest_buf + x, res);
+    }
+
+    return x;
+}
+
+int32_t lv_draw_sw_transform_rgb565a8_neon(const uint8_t * src, int32_t src_stride, const lv_opa_t * src_alpha,
+                                           int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                           int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf)
+{
+    int32_t alpha_stride = src_stride / 2;
+
+    int32_t x;
+    for(x = x_start; x <= x_end - PX_CNT; x += PX_CNT) {
+        uint32_t c[PX_CNT];
+        uint32_t hor[PX_CNT];
+        uint32_t ver[PX_CNT];
+        uint32_t a[PX_CNT];
+        uint32_t a_hor[PX_CNT];
+        uint32_t a_ver[PX_CNT];
+        uint32_t xs_fract[PX_CNT];
+        uint32_t ys_fract[PX_CNT];
+        uint32_t i;
+        for(i = 0; i < PX_CNT; i++) {
+            int32_t ofs, ofs_hor, ofs_ver;
+            get_neighbors(xs_ups, ys_ups, xs_step, ys_step, x + i, 2, src_stride, &ofs, &ofs_hor, &ofs_ver,
+                          &xs_fract[i], &ys_fract[i]);
+            c[i] = *(const uint16_t *)(src + ofs);
+            hor[i] = *(const uint16_t *)(src + ofs_hor);
+            ver[i] = *(const uint16_t *)(src + ofs_ver);
+            if(src_alpha) {
+                /*The alpha map has 1 byte pixels and half stride*/
+                get_neighbors(xs_ups, ys_ups, xs_step, ys_step, x + i, 1, alpha_stride, &ofs, &ofs_hor, &ofs_ver,
+                              &xs_fract[i], &ys_fract[i]);
+                a[i] = src_alpha[ofs];
+                a_hor[i] = src_alpha[ofs_hor];
+                a_ver[i] = src_alpha[ofs_ver];
+            }
+        }
+
+        /*The fractions are used in 0..254 range*/
+        uint32x4_t xf = vshlq_n_u32(vld1q_u32(xs_fract), 1);
+        uint32x4_t yf = vshlq_n_u32(vld1q_u32(ys_fract), 1);
+        uint32x4_t c_v = vld1q_u32(c);
+        uint32x4_t v = mix_16_16(vld1q_u32(ver), c_v, yf);
+        uint32x4_t h = mix_16_16(vld1q_u32(hor), c_v, xf);
+        uint32x4_t res = mix_16_16(h, v, vdupq_n_u32(LV_OPA_50));
+
+        uint32x4_t res_a;
+        if(src_alpha) {
+            uint32x4_t a_v = vld1q_u32(a);
+            uint32x4_t a_ver_v = mix_opa(vld1q_u32(a_ver), a_v, yf);
+            uint32x4_t a_hor_v = mix_opa(vld1q_u32(a_hor), a_v, xf);
+            res_a = vshrq_n_u32(vaddq_u32(a_ver_v, a_hor_v), 1);
+
+            /*The color is not mixed if the pixel is transparent*/
+            res = vbslq_u32(vceqq_u32(res_a, vdupq_n_u32(0)), c_v, res);
+        }
+        else {
+            res_a = vdupq_n_u32(0xFF);
+        }
+
+        vst1_u16(cbuf + x, vmovn_u32(res));
+        uint16x4_t res_a16 = vmovn_u32(res_a);
+        uint8x8_t res_a8 = vmovn_u16(vcombine_u16(res_a16, res_a16));
+        uint32_t a32 = vget_lane_u32(vreinterpret_u32_u8(res_a8), 0);
+        lv_memcpy(abuf + x, &a32, sizeof(a32));
+    }
+
+    return x;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the source pixel and its neighbors used by the transformation as the C implementation does
+ * @param xs_ups        upscaled source X coordinate of the first pixel of the row
+ * @param ys_ups        upscaled source Y coordinate of the first pixel of the row
+ * @param xs_step       upscaled X step between the pixels
+ * @param ys_step       upscaled Y step between the pixels
+ * @param x             index of the pixel in the row
+ * @param px_size       size of a source pixel in bytes
+ * @param stride        stride of the source image in bytes
+ * @param ofs           store the offset of the pixel in the source here
+ * @param ofs_hor       store the offset of the horizontal neighbor here
+ * @param ofs_ver       store the offset of the vertical neighbor here
+ * @param xs_fract      store the weight of the horizontal neighbor here (0..0x7F)
+ * @param ys_fract      store the weight of the vertical neighbor here (0..0x7F)
+ */
+static inline void get_neighbors(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, int32_t x,
+                                 int32_t px_size, int32_t stride, int32_t * ofs, int32_t * ofs_hor, int32_t * ofs_ver,
+                                 uint32_t * xs_fract, uint32_t * ys_fract)
+{
+    int32_t xs = xs_ups + ((xs_step * x) >> 8);
+    int32_t ys = ys_ups + ((ys_step * x) >> 8);
+    int32_t xf = xs & 0xFF;
+    int32_t yf = ys & 0xFF;
+
+    *ofs = (ys >> 8) * stride + (xs >> 8) * px_size;
+    if(xf < 0x80) {
+        *ofs_hor = *ofs - px_size;
+        *xs_fract = 0x7F - xf;
+    }
+    else {
+        *ofs_hor = *ofs + px_size;
+        *xs_fract = xf - 0x80;
+    }
+    if(yf < 0x80) {
+        *ofs_ver = *ofs - stride;
+        *ys_fract = 0x7F - yf;
+    }
+    else {
+        *ofs_ver = *ofs + stride;
+        *ys_fract = yf - 0x80;
+    }
+}
+
+/**
+ * Mix all the channels of ARGB8888 pixels as `lv_color_mix32()`
+ * @param fg        the foreground pixels
+ * @param bg        the background pixels
+ * @param mix       weight of the foreground in 32 bit lanes (0..255)
+ * @return          the mixed pixels
+ */
+static inline uint32x4_t mix_channels(uint32x4_t fg, uint32x4_t bg, uint32x4_t mix)
+{
+    /*Copy the weight to all the bytes of its pixel*/
+    uint8x16_t mix8 = vreinterpretq_u8_u32(vmulq_n_u32(mix, 0x01010101));
+    uint8x16_t mix8_inv = vsubq_u8(vdupq_n_u8(0xFF), mix8);
+    uint8x16_t fg8 = vreinterpretq_u8_u32(fg);
+    uint8x16_t bg8 = vreinterpretq_u8_u32(bg);
+
+    uint16x8_t res_lo = vmull_u8(vget_low_u8(fg8), vget_low_u8(mix8));
+    res_lo = vmlal_u8(res_lo, vget_low_u8(bg8), vget_low_u8(mix8_inv));
+    uint16x8_t res_hi = vmull_u8(vget_high_u8(fg8), vget_high_u8(mix8));
+    res_hi = vmlal_u8(res_hi, vget_high_u8(bg8), vget_high_u8(mix8_inv));
+
+    return vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(res_lo, 8), vshrn_n_u16(res_hi, 8)));
+}
+
+/**
+ * Mix a neighbor into ARGB8888 pixels as the interior pixels of `transform_argb8888()`
+ * @param c         the pixels
+ * @param n         the neighbors
+ * @param fract     weight of the neighbors in 32 bit lanes (0..0x7F)
+ * @return          the mixed pixels
+ */
+static inline uint32x4_t mix_neighbor_32(uint32x4_t c, uint32x4_t n, uint32x4_t fract)
+{
+    uint32x4_t res = mix_channels(n, c, fract);
+
+    /*Same pixels are not mixed. If the neighbor is transparent or the weight is small only the alpha is mixed.*/
+    uint32x4_t same = vceqq_u32(c, n);
+    uint32x4_t keep_rgb = vorrq_u32(vorrq_u32(same, vceqq_u32(vshrq_n_u32(n, 24), vdupq_n_u32(0))),
+                                    vcltq_u32(fract, vdupq_n_u32(LV_OPA_MIN + 1)));
+    uint32x4_t keep = vorrq_u32(vandq_u32(keep_rgb, vdupq_n_u32(0x00FFFFFF)),
+                                vandq_u32(same, vdupq_n_u32(0xFF000000)));
+    return vbslq_u32(keep, c, res);
+}
+
+/**
+ * Mix RGB565 colors in 32 bit lanes as `lv_color_16_16_mix()` (`mix` is never 255 here)
+ */
+static inline uint32x4_t mix_16_16(uint32x4_t fg, uint32x4_t bg, uint32x4_t mix)
+{
+    /*0x7E0F81F = 0b00000111111000001111100000011111*/
+    uint32x4_t rb_g = vdupq_n_u32(0x7E0F81F);
+    uint32x4_t fg_x = vandq_u32(vorrq_u32(fg, vshlq_n_u32(fg, 16)), rb_g);
+    uint32x4_t bg_x = vandq_u32(vorrq_u32(bg, vshlq_n_u32(bg, 16)), rb_g);
+    uint32x4_t mix5 = vshrq_n_u32(vaddq_u32(mix, vdupq_n_u32(4)), 3);
+    uint32x4_t res = vshrq_n_u32(vmulq_u32(vsubq_u32(fg_x, bg_x), mix5), 5);
+    res = vandq_u32(vaddq_u32(res, bg_x), rb_g);
+    return vandq_u32(vorrq_u32(res, vshrq_n_u32(res, 16)), vdupq_n_u32(0xFFFF));
+}
+
+/**
+ * Mix opacities in 32 bit lanes as the alpha channel of `transform_rgb565a8()`.
+ * The result is the same if `fg == bg` so it's not checked.
+ */
+static inline uint32x4_t mix_opa(uint32x4_t fg, uint32x4_t bg, uint32x4_t mix)
+{
+    uint32x4_t mix_inv = vsubq_u32(vdupq_n_u32(0x100), mix);
+    return vshrq_n_u32(vmlaq_u32(vmulq_u32(fg, mix), bg, mix_inv), 8);
+}
+
+#endif /*LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE*/
+
+#endif /*LV_USE_DRAW_SW*/
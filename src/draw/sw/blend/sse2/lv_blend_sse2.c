@@ -0,0 +1,607 @@
+/**
+ * @file lv_blend_sse2.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_sse2.h"
+#if LV_USE_DRAW_SW && LV_DRAW_SW_SSE2_AVAILABLE
+
+#include <emmintrin.h>
+#include "../../../../misc/lv_color.h"
+#include "../../../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of pixels processed at once*/
+#define PX_CNT  4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    DEST_RGB565,
+    DEST_XRGB8888,
+    DEST_ARGB8888,
+} dest_type_t;
+
+/**
+ * The parameters of a blend shared by the fill and image blend kernels.
+ * If `src` is NULL `color` is blended.
+ */
+typedef struct {
+    dest_type_t dest_type;
+    void * dest;
+    int32_t dest_stride;
+    int32_t w;
+    int32_t h;
+    const uint32_t * src;
+    int32_t src_stride;
+    uint32_t color32;
+    uint16_t color16;
+    const lv_opa_t * mask;
+    int32_t mask_stride;
+    lv_opa_t opa;
+} blend_params_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void blend(const blend_params_t * p);
+static void blend_row(const blend_params_t * p, void * dest, const uint32_t * src, const lv_opa_t * mask);
+static void blend_px(const blend_params_t * p, void * dest, const uint32_t * src, const lv_opa_t * mask);
+static void fill(const blend_params_t * p);
+static inline __m128i get_alpha(const blend_params_t * p, __m128i fg, const lv_opa_t * mask);
+static inline __m128i mix_channels(__m128i fg, __m128i bg, __m128i mix);
+static inline __m128i mullo_epi32(__m128i a, __m128i b);
+static inline __m128i select_px(__m128i a, __m128i b, __m128i sel);
+static inline __m128i mix_32_16(__m128i fg, __m128i bg, __m128i mix);
+static void mix_32_32_px(uint32_t * fg, const uint32_t * bg);
+static inline void get_neighbors(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, int32_t x,
+                                 int32_t px_size, int32_t stride, int32_t * ofs, int32_t * ofs_hor, int32_t * ofs_ver,
+                                 int32_t * xs_fract, int32_t * ys_fract);
+static inline __m128i mix_16_16(__m128i fg, __m128i bg, __m128i mix);
+static inline __m128i mix_opa(__m128i fg, __m128i bg, __m128i mix);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_draw_sw_blend_color_to_rgb565_sse2(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_params_t p = {
+        .dest_type = DEST_RGB565,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .color16 = lv_color_to_u16(dsc->color),
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    if(p.mask == NULL && p.opa >= LV_OPA_MAX) fill(&p);
+    else blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_color_to_rgb888_sse2(_lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_params_t p = {
+        .dest_type = DEST_XRGB8888,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .color32 = lv_color_to_u32(dsc->color),
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    if(p.mask == NULL && p.opa >= LV_OPA_MAX) fill(&p);
+    else blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_color_to_argb8888_sse2(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    blend_params_t p = {
+        .dest_type = DEST_ARGB8888,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .color32 = lv_color_to_u32(dsc->color),
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    if(p.mask == NULL && p.opa >= LV_OPA_MAX) fill(&p);
+    else blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb565_sse2(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_params_t p = {
+        .dest_type = DEST_RGB565,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .src = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb888_sse2(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(dest_px_size != 4) return LV_RESULT_INVALID;
+
+    blend_params_t p = {
+        .dest_type = DEST_XRGB8888,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .src = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    blend(&p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_draw_sw_blend_argb8888_to_argb8888_sse2(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    blend_params_t p = {
+        .dest_type = DEST_ARGB8888,
+        .dest = dsc->dest_buf,
+        .dest_stride = dsc->dest_stride,
+        .w = dsc->dest_w,
+        .h = dsc->dest_h,
+        .src = dsc->src_buf,
+        .src_stride = dsc->src_stride,
+        .mask = dsc->mask_buf,
+        .mask_stride = dsc->mask_stride,
+        .opa = dsc->opa
+    };
+
+    blend(&p);
+    return LV_RESULT_OK;
+}
+
+int32_t lv_draw_sw_transform_rgb565a8_sse2(const uint8_t * src, int32_t src_stride, const lv_opa_t * src_alpha,
+                                           int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                           int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf)
+{
+    int32_t alpha_stride = src_stride / 2;
+    __m128i zero = _mm_setzero_si128();
+
+    int32_t x;
+    for(x = x_start; x <= x_end - PX_CNT; x += PX_CNT) {
+        int32_t c[PX_CNT];
+        int32_t hor[PX_CNT];
+        int32_t ver[PX_CNT];
+        int32_t a[PX_CNT];
+        int32_t a_hor[PX_CNT];
+        int32_t a_ver[PX_CNT];
+        int32_t xs_fract[PX_CNT];
+        int32_t ys_fract[PX_CNT];
+        uint32_t i;
+        for(i = 0; i < PX_CNT; i++) {
+            int32_t ofs, ofs_hor, ofs_ver;
+            get_neighbors(xs_ups, ys_ups, xs_step, ys_step, x + i, 2, src_stride, &ofs, &ofs_hor, &ofs_ver,
+                          &xs_fract[i], &ys_fract[i]);
+            c[i] = *(const uint16_t *)(src + ofs);
+            hor[i] = *(const uint16_t *)(src + ofs_hor);
+            ver[i] = *(const uint16_t *)(src + ofs_ver);
+            if(src_alpha) {
+                /*The alpha map has 1 byte pixels and half stride*/
+                get_neighbors(xs_ups, ys_ups, xs_step, ys_step, x + i, 1, alpha_stride, &ofs, &ofs_hor, &ofs_ver,
+                              &xs_fract[i], &ys_fract[i]);
+                a[i] = src_alpha[ofs];
+                a_hor[i] = src_alpha[ofs_hor];
+                a_ver[i] = src_alpha[ofs_ver];
+            }
+        }
+
+        /*The fractions are used in 0..254 range*/
+        __m128i xf = _mm_slli_epi32(_mm_loadu_si128((const __m128i *)xs_fract), 1);
+        __m128i yf = _mm_slli_epi32(_mm_loadu_si128((const __m128i *)ys_fract), 1);
+        __m128i c_v = _mm_loadu_si128((const __m128i *)c);
+        __m128i v = mix_16_16(_mm_loadu_si128((const __m128i *)ver), c_v, yf);
+        __m128i h = mix_16_16(_mm_loadu_si128((const __m128i *)hor), c_v, xf);
+        __m128i res = mix_16_16(h, v, _mm_set1_epi32(LV_OPA_50));
+
+        __m128i res_a;
+        if(src_alpha) {
+            __m128i a_v = _mm_loadu_si128((const __m128i *)a);
+            __m128i a_ver_v = mix_opa(_mm_loadu_si128((const __m128i *)a_ver), a_v, yf);
+            __m128i a_hor_v = mix_opa(_mm_loadu_si128((const __m128i *)a_hor), a_v, xf);
+            res_a = _mm_srli_epi32(_mm_add_epi32(a_ver_v, a_hor_v), 1);
+
+            /*The color is not mixed if the pixel is transparent*/
+            res = select_px(res, c_v, _mm_cmpeq_epi32(res_a, zero));
+        }
+        else {
+            res_a = _mm_set1_epi32(0xFF);
+        }
+
+        /*Sign extend to avoid the saturation of the packing*/
+        res = _mm_srai_epi32(_mm_slli_epi32(res, 16), 16);
+        _mm_storel_epi64((__m128i *)(cbuf + x), _mm_packs_epi32(res, res));
+        res_a = _mm_packs_epi32(res_a, res_a);
+        int32_t a32 = _mm_cvtsi128_si32(_mm_packus_epi16(res_a, res_a));
+        lv_memcpy(abuf + x, &a32, sizeof(a32));
+    }
+
+    return x;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void blend(const blend_params_t * p)
+{
+    uint8_t * dest = p->dest;
+    const uint8_t * src = (const uint8_t *)p->src;
+    const lv_opa_t * mask = p->mask;
+    int32_t y;
+    for(y = 0; y < p->h; y++) {
+        blend_row(p, dest, (const uint32_t *)src, mask);
+        dest += p->dest_stride;
+        if(src) src += p->src_stride;
+        if(mask) mask += p->mask_stride;
+    }
+}
+
+static void blend_row(const blend_params_t * p, void * dest, const uint32_t * src, const lv_opa_t * mask)
+{
+    uint32_t dest_px_size = p->dest_type == DEST_RGB565 ? 2 : 4;
+    uint8_t * dest_u8 = dest;
+    int32_t x;
+    for(x = 0; x <= p->w - PX_CNT; x += PX_CNT) {
+        blend_px(p, dest_u8 + x * dest_px_size, src ? src + x : NULL, mask ? mask + x : NULL);
+    }
+
+    /*Blend the remaining pixels in a temporary buffer to use the same kernel*/
+    int32_t rem = p->w - x;
+    if(rem > 0) {
+        uint32_t dest_tmp[PX_CNT] = {0};
+        uint32_t src_tmp[PX_CNT] = {0};
+        lv_opa_t mask_tmp[PX_CNT] = {0};
+        lv_memcpy(dest_tmp, dest_u8 + x * dest_px_size, rem * dest_px_size);
+        if(src) lv_memcpy(src_tmp, src + x, rem * sizeof(uint32_t));
+        if(mask) lv_memcpy(mask_tmp, mask + x, rem);
+        blend_px(p, dest_tmp, src ? src_tmp : NULL, mask ? mask_tmp : NULL);
+        lv_memcpy(dest_u8 + x * dest_px_size, dest_tmp, rem * dest_px_size);
+    }
+}
+
+/**
+ * Blend `PX_CNT` pixels
+ */
+static void blend_px(const blend_params_t * p, void * dest, const uint32_t * src, const lv_opa_t * mask)
+{
+    __m128i fg = src ? _mm_loadu_si128((const __m128i *)src) : _mm_set1_epi32((int32_t)p->color32);
+    __m128i a = get_alpha(p, fg, mask);
+    __m128i zero = _mm_setzero_si128();
+
+    if(p->dest_type == DEST_RGB565) {
+        __m128i bg = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)dest), zero);
+        __m128i res;
+        if(src) res = mix_32_16(fg, bg, a);
+        else res = mix_16_16(_mm_set1_epi32(p->color16), bg, a);
+
+        /*Sign extend to avoid the saturation of the packing*/
+        res = _mm_srai_epi32(_mm_slli_epi32(res, 16), 16);
+        _mm_storel_epi64((__m128i *)dest, _mm_packs_epi32(res, res));
+    }
+    else if(p->dest_type == DEST_XRGB8888) {
+        /*Keep the X channel of the destination*/
+        __m128i bg = _mm_loadu_si128((const __m128i *)dest);
+        __m128i rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+        __m128i x_ch = _mm_andnot_si128(rgb_mask, bg);
+        __m128i res = _mm_or_si128(_mm_and_si128(mix_channels(fg, bg, a), rgb_mask), x_ch);
+        __m128i cover = _mm_or_si128(_mm_and_si128(fg, rgb_mask), x_ch);
+        res = select_px(res, cover, _mm_cmpgt_epi32(a, _mm_set1_epi32(LV_OPA_MAX - 1)));
+        res = select_px(res, bg, _mm_cmpeq_epi32(a, zero));
+        _mm_storeu_si128((__m128i *)dest, res);
+    }
+    else {
+        __m128i bg = _mm_loadu_si128((const __m128i *)dest);
+        __m128i bg_a = _mm_srli_epi32(bg, 24);
+        fg = _mm_or_si128(_mm_and_si128(fg, _mm_set1_epi32(0x00FFFFFF)), _mm_slli_epi32(a, 24));
+
+        /*Opaque or transparent pixels are simple. Mixing with an opaque background is simple too.*/
+        __m128i use_fg = _mm_or_si128(_mm_cmpgt_epi32(a, _mm_set1_epi32(LV_OPA_MAX - 1)),
+                                      _mm_cmplt_epi32(bg_a, _mm_set1_epi32(LV_OPA_MIN + 1)));
+        __m128i use_bg = _mm_andnot_si128(use_fg, _mm_cmplt_epi32(a, _mm_set1_epi32(LV_OPA_MIN + 1)));
+        __m128i simple = _mm_or_si128(_mm_or_si128(use_fg, use_bg), _mm_cmpeq_epi32(bg_a, _mm_set1_epi32(0xFF)));
+
+        if(_mm_movemask_epi8(simple) == 0xFFFF) {
+            __m128i res = _mm_or_si128(mix_channels(fg, bg, a), _mm_set1_epi32((int32_t)0xFF000000));
+            res = select_px(res, fg, use_fg);
+            res = select_px(res, bg, use_bg);
+            _mm_storeu_si128((__m128i *)dest, res);
+        }
+        else {
+            /*Both colors are semi-transparent: needs division so calculate by pixel*/
+            uint32_t fg_px[PX_CNT];
+            _mm_storeu_si128((__m128i *)fg_px, fg);
+            uint32_t * dest_u32 = dest;
+            uint32_t i;
+            for(i = 0; i < PX_CNT; i++) {
+                mix_32_32_px(&fg_px[i], &dest_u32[i]);
+                dest_u32[i] = fg_px[i];
+            }
+        }
+    }
+}
+
+static void fill(const blend_params_t * p)
+{
+    uint8_t * dest = p->dest;
+    int32_t x;
+    int32_t y;
+    if(p->dest_type == DEST_RGB565) {
+        __m128i c = _mm_set1_epi16((int16_t)p->color16);
+        for(y = 0; y < p->h; y++) {
+            uint16_t * dest_u16 = (uint16_t *)dest;
+            for(x = 0; x <= p->w - 8; x += 8) {
+                _mm_storeu_si128((__m128i *)&dest_u16[x], c);
+            }
+            for(; x < p->w; x++) {
+                dest_u16[x] = p->color16;
+            }
+            dest += p->dest_stride;
+        }
+    }
+    else {
+        __m128i c = _mm_set1_epi32((int32_t)p->color32);
+        for(y = 0; y < p->h; y++) {
+            uint32_t * dest_u32 = (uint32_t *)dest;
+            for(x = 0; x <= p->w - 4; x += 4) {
+                _mm_storeu_si128((__m128i *)&dest_u32[x], c);
+            }
+            for(; x < p->w; x++) {
+                dest_u32[x] = p->color32;
+            }
+            dest += p->dest_stride;
+        }
+    }
+}
+
+/**
+ * Get the opacity of the pixels the same way as the C implementation does
+ * @param p     the blend parameters
+ * @param fg    the foreground pixels. Only the alpha channel of the images are used
+ * @param mask  pointer to the mask values of the pixels or NULL if there is no mask
+ * @return      the opacities in 32 bit lanes
+ */
+static inline __m128i get_alpha(const blend_params_t * p, __m128i fg, const lv_opa_t * mask)
+{
+    __m128i opa = _mm_set1_epi32(p->opa);
+    __m128i m = opa;
+    if(mask) {
+        int32_t m32;
+        lv_memcpy(&m32, mask, sizeof(m32));
+        __m128i zero = _mm_setzero_si128();
+        m = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(m32), zero), zero);
+    }
+
+    /*The operands and the products fit into the lower 16 bit of the lanes*/
+    if(p->src) {
+        __m128i a = _mm_srli_epi32(fg, 24);
+        if(mask && p->opa < LV_OPA_MAX) {
+            /*LV_OPA_MIX3: the upper 16 bit of the second product is the result*/
+            return _mm_mulhi_epu16(_mm_mullo_epi16(a, m), opa);
+        }
+        else if(mask) return _mm_srli_epi32(_mm_mullo_epi16(a, m), 8);
+        else if(p->opa < LV_OPA_MAX) return _mm_srli_epi32(_mm_mullo_epi16(a, opa), 8);
+        else return a;
+    }
+    else {
+        if(mask && p->opa < LV_OPA_MAX) return _mm_srli_epi32(_mm_mullo_epi16(m, opa), 8);
+        else return m;
+    }
+}
+
+/**
+ * Mix all the channels of ARGB8888 pixels as `lv_color_mix32()`
+ */
+static inline __m128i mix_channels(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i mix2 = _mm_or_si128(mix, _mm_slli_epi32(mix, 16));
+    __m128i mix_lo = _mm_unpacklo_epi32(mix2, mix2);
+    __m128i mix_hi = _mm_unpackhi_epi32(mix2, mix2);
+    __m128i ff = _mm_set1_epi16(0xFF);
+
+    __m128i res_lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fg, zero), mix_lo),
+                                   _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), _mm_sub_epi16(ff, mix_lo)));
+    __m128i res_hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fg, zero), mix_hi),
+                                   _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), _mm_sub_epi16(ff, mix_hi)));
+
+    return _mm_packus_epi16(_mm_srli_epi16(res_lo, 8), _mm_srli_epi16(res_hi, 8));
+}
+
+/**
+ * Multiply 32 bit integers and keep the lower 32 bit of the results (`_mm_mullo_epi32` is SSE4.1)
+ */
+static inline __m128i mullo_epi32(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**
+ * Return `b` where `sel` is all 1 and `a` elsewhere
+ */
+static inline __m128i select_px(__m128i a, __m128i b, __m128i sel)
+{
+    return _mm_or_si128(_mm_and_si128(sel, b), _mm_andnot_si128(sel, a));
+}
+
+/**
+ * Mix ARGB8888 colors to RGB565 colors in 32 bit lanes as `lv_color_24_16_mix()`
+ */
+static inline __m128i mix_32_16(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i mask5 = _mm_set1_epi32(0x1F);
+    __m128i mask6 = _mm_set1_epi32(0x3F);
+    __m128i fg_r = _mm_and_si128(_mm_srli_epi32(fg, 19), mask5);
+    __m128i fg_g = _mm_and_si128(_mm_srli_epi32(fg, 10), mask6);
+    __m128i fg_b = _mm_and_si128(_mm_srli_epi32(fg, 3), mask5);
+    __m128i bg_r = _mm_and_si128(_mm_srli_epi32(bg, 11), mask5);
+    __m128i bg_g = _mm_and_si128(_mm_srli_epi32(bg, 5), mask6);
+    __m128i bg_b = _mm_and_si128(bg, mask5);
+    __m128i mix_inv = _mm_sub_epi32(_mm_set1_epi32(255), mix);
+
+    /*The operands and the products fit into the lower 16 bit of the lanes*/
+    __m128i r = _mm_add_epi32(_mm_mullo_epi16(fg_r, mix), _mm_mullo_epi16(bg_r, mix_inv));
+    __m128i g = _mm_add_epi32(_mm_mullo_epi16(fg_g, mix), _mm_mullo_epi16(bg_g, mix_inv));
+    __m128i b = _mm_add_epi32(_mm_mullo_epi16(fg_b, mix), _mm_mullo_epi16(bg_b, mix_inv));
+    __m128i res = _mm_or_si128(_mm_and_si128(_mm_slli_epi32(r, 3), _mm_set1_epi32(0xF800)),
+                               _mm_and_si128(_mm_srli_epi32(g, 3), _mm_set1_epi32(0x07E0)));
+    res = _mm_or_si128(res, _mm_srli_epi32(b, 8));
+
+    __m128i cover = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(fg_r, 11), _mm_slli_epi32(fg_g, 5)), fg_b);
+    res = select_px(res, cover, _mm_cmpeq_epi32(mix, _mm_set1_epi32(255)));
+    res = select_px(res, bg, _mm_cmpeq_epi32(mix, _mm_setzero_si128()));
+    return res;
+}
+
+/**
+ * Mix ARGB8888 colors with alpha as `lv_color_32_32_mix()` of the C implementation
+ * @param fg    the foreground color. The result is written here.
+ * @param bg    the background color
+ */
+static void mix_32_32_px(uint32_t * fg, const uint32_t * bg)
+{
+    lv_color32_t fg_c;
+    lv_color32_t bg_c;
+    lv_memcpy(&fg_c, fg, sizeof(fg_c));
+    lv_memcpy(&bg_c, bg, sizeof(bg_c));
+
+    lv_color32_t res;
+    if(fg_c.alpha >= LV_OPA_MAX || bg_c.alpha <= LV_OPA_MIN) {
+        res = fg_c;
+    }
+    else if(fg_c.alpha <= LV_OPA_MIN) {
+        res = bg_c;
+    }
+    else if(bg_c.alpha == 255) {
+        res = lv_color_mix32(fg_c, bg_c);
+    }
+    else {
+        lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - fg_c.alpha, 255 - bg_c.alpha);
+        fg_c.alpha = (uint32_t)((uint32_t)fg_c.alpha * 255) / res_alpha;
+        res = lv_color_mix32(fg_c, bg_c);
+        res.alpha = res_alpha;
+    }
+
+    lv_memcpy(fg, &res, sizeof(res));
+}
+
+/**
+ * Get the source pixel and its neighbors used by the transformation as the C implementation does
+ * @param xs_ups        upscaled source X coordinate of the first pixel of the row
+ * @param ys_ups        upscaled source Y coordinate of the first pixel of the row
+ * @param xs_step       upscaled X step between the pixels
+ * @param ys_step       upscaled Y step between the pixels
+ * @param x             index of the pixel in the row
+ * @param px_size       size of a source pixel in bytes
+ * @param stride        stride of the source image in bytes
+ * @param ofs           store the offset of the pixel in the source here
+ * @param ofs_hor       store the offset of the horizontal neighbor here
+ * @param ofs_ver       store the offset of the vertical neighbor here
+ * @param xs_fract      store the weight of the horizontal neighbor here (0..0x7F)
+ * @param ys_fract      store the weight of the vertical neighbor here (0..0x7F)
+ */
+static inline void get_neighbors(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, int32_t x,
+                                 int32_t px_size, int32_t stride, int32_t * ofs, int32_t * ofs_hor, int32_t * ofs_ver,
+                                 int32_t * xs_fract, int32_t * ys_fract)
+{
+    int32_t xs = xs_ups + ((xs_step * x) >> 8);
+    int32_t ys = ys_ups + ((ys_step * x) >> 8);
+    int32_t xf = xs & 0xFF;
+    int32_t yf = ys & 0xFF;
+
+    *ofs = (ys >> 8) * stride + (xs >> 8) * px_size;
+    if(xf < 0x80) {
+        *ofs_hor = *ofs - px_size;
+        *xs_fract = 0x7F - xf;
+    }
+    else {
+        *ofs_hor = *ofs + px_size;
+        *xs_fract = xf - 0x80;
+    }
+    if(yf < 0x80) {
+        *ofs_ver = *ofs - stride;
+        *ys_fract = 0x7F - yf;
+    }
+    else {
+        *ofs_ver = *ofs + stride;
+        *ys_fract = yf - 0x80;
+    }
+}
+
+/**
+ * Mix RGB565 colors in 32 bit lanes as `lv_color_16_16_mix()` (`mix` is never 255 here)
+ */
+static inline __m128i mix_16_16(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i rb_g = _mm_set1_epi32(0x7E0F81F);
+    __m128i fg_x = _mm_and_si128(_mm_or_si128(fg, _mm_slli_epi32(fg, 16)), rb_g);
+    __m128i bg_x = _mm_and_si128(_mm_or_si128(bg, _mm_slli_epi32(bg, 16)), rb_g);
+    __m128i mix5 = _mm_srli_epi32(_mm_add_epi32(mix, _mm_set1_epi32(4)), 3);
+    __m128i res = _mm_srli_epi32(mullo_epi32(_mm_sub_epi32(fg_x, bg_x), mix5), 5);
+    res = _mm_and_si128(_mm_add_epi32(res, bg_x), rb_g);
+    return _mm_and_si128(_mm_or_si128(res, _mm_srli_epi32(res, 16)), _mm_set1_epi32(0xFFFF));
+}
+
+/**
+ * Mix opacities in 32 bit lanes as the alpha channel of `transform_rgb565a8()`.
+ * The result is the same if `fg == bg` so it's not checked.
+ */
+static inline __m128i mix_opa(__m128i fg, __m128i bg, __m128i mix)
+{
+    /*The operands fit into the lower 16 bit of the lanes and the sum of the products into 32 bit*/
+    __m128i mix_inv = _mm_sub_epi32(_mm_set1_epi32(0x100), mix);
+    return _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(fg, mix), _mm_madd_epi16(bg, mix_inv)), 8);
+}
+
+#endif /*LV_USE_DRAW_SW && LV_DRAW_SW_SSE2_AVAILABLE*/
@@ -0,0 +1,203 @@
+/**
+ * @file lv_blend_x86.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_x86.h"
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+
+#include "../sse2/lv_blend_sse2.h"
+#include "../avx2/lv_blend_avx2.h"
+#include "../../../../core/lv_global.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool cpu_has_avx2(void);
+static const lv_draw_sw_blend_x86_kernels_t * get_kernels(lv_draw_sw_x86_level_t level);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#define kernels LV_GLOBAL_DEFAULT()->sw_blend_x86_kernels
+
+#if LV_DRAW_SW_SSE2_AVAILABLE
+static const lv_draw_sw_blend_x86_kernels_t kernels_sse2 = {
+    .color_to_rgb565 = lv_draw_sw_blend_color_to_rgb565_sse2,
+    .color_to_rgb888 = lv_draw_sw_blend_color_to_rgb888_sse2,
+    .color_to_argb8888 = lv_draw_sw_blend_color_to_argb8888_sse2,
+    .argb8888_to_rgb565 = lv_draw_sw_blend_argb8888_to_rgb565_sse2,
+    .argb8888_to_rgb888 = lv_draw_sw_blend_argb8888_to_rgb888_sse2,
+    .argb8888_to_argb8888 = lv_draw_sw_blend_argb8888_to_argb8888_sse2,
+    .transform_argb8888 = NULL,     /*Faster in C*/
+    .transform_rgb565a8 = lv_draw_sw_transform_rgb565a8_sse2,
+};
+#endif
+
+#if LV_DRAW_SW_AVX2_AVAILABLE
+static const lv_draw_sw_blend_x86_kernels_t kernels_avx2 = {
+    .color_to_rgb565 = lv_draw_sw_blend_color_to_rgb565_avx2,
+    .color_to_rgb888 = lv_draw_sw_blend_color_to_rgb888_avx2,
+    .color_to_argb8888 = lv_draw_sw_blend_color_to_argb8888_avx2,
+    .argb8888_to_rgb565 = lv_draw_sw_blend_argb8888_to_rgb565_avx2,
+    .argb8888_to_rgb888 = lv_draw_sw_blend_argb8888_to_rgb888_avx2,
+    .argb8888_to_argb8888 = lv_draw_sw_blend_argb8888_to_argb8888_avx2,
+    .transform_argb8888 = lv_draw_sw_transform_argb8888_avx2,
+    .transform_rgb565a8 = lv_draw_sw_transform_rgb565a8_avx2,
+};
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_blend_x86_init(void)
+{
+    lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_AVX2);
+    LV_LOG_INFO("x86 blend level: %d", (int)lv_draw_sw_blend_x86_get_level());
+}
+
+lv_draw_sw_x86_level_t lv_draw_sw_blend_x86_get_supported_level(void)
+{
+    if(LV_DRAW_SW_AVX2_AVAILABLE && cpu_has_avx2()) return LV_DRAW_SW_X86_LEVEL_AVX2;
+    /*SSE2 is compiled only if the target CPU of the build has it*/
+    if(LV_DRAW_SW_SSE2_AVAILABLE) return LV_DRAW_SW_X86_LEVEL_SSE2;
+    return LV_DRAW_SW_X86_LEVEL_NONE;
+}
+
+void lv_draw_sw_blend_x86_set_level(lv_draw_sw_x86_level_t level)
+{
+    lv_draw_sw_x86_level_t supported = lv_draw_sw_blend_x86_get_supported_level();
+    if(level > supported) level = supported;
+
+    /*AVX2 can be supported without SSE2 compiled in (e.g. i386 builds)*/
+    if(level == LV_DRAW_SW_X86_LEVEL_SSE2 && !LV_DRAW_SW_SSE2_AVAILABLE) level = LV_DRAW_SW_X86_LEVEL_NONE;
+
+    kernels = get_kernels(level);
+}
+
+lv_draw_sw_x86_level_t lv_draw_sw_blend_x86_get_level(void)
+{
+    if(kernels == NULL) return LV_DRAW_SW_X86_LEVEL_NONE;
+#if LV_DRAW_SW_AVX2_AVAILABLE
+    if(kernels == &kernels_avx2) return LV_DRAW_SW_X86_LEVEL_AVX2;
+#endif
+    return LV_DRAW_SW_X86_LEVEL_SSE2;
+}
+
+lv_result_t lv_draw_sw_blend_color_to_rgb565_x86(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+    return kernels->color_to_rgb565(dsc);
+}
+
+lv_result_t lv_draw_sw_blend_color_to_rgb888_x86(_lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+    return kernels->color_to_rgb888(dsc, dest_px_size);
+}
+
+lv_result_t lv_draw_sw_blend_color_to_argb8888_x86(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+    return kernels->color_to_argb8888(dsc);
+}
+
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb565_x86(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+    return kernels->argb8888_to_rgb565(dsc);
+}
+
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb888_x86(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+    return kernels->argb8888_to_rgb888(dsc, dest_px_size);
+}
+
+lv_result_t lv_draw_sw_blend_argb8888_to_argb8888_x86(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(kernels == NULL) return LV_RESULT_INVALID;
+    return kernels->argb8888_to_argb8888(dsc);
+}
+
+int32_t lv_draw_sw_transform_argb8888_x86(const uint8_t * src, int32_t src_stride, int32_t xs_ups, int32_t ys_ups,
+                                          int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end,
+                                          uint32_t * dest_buf)
+{
+    if(kernels == NULL || kernels->transform_argb8888 == NULL) return x_start;
+    return kernels->transform_argb8888(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_buf);
+}
+
+int32_t lv_draw_sw_transform_rgb565a8_x86(const uint8_t * src, int32_t src_stride, const lv_opa_t * src_alpha,
+                                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                          int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf)
+{
+    if(kernels == NULL || kernels->transform_rgb565a8 == NULL) return x_start;
+    return kernels->transform_rgb565a8(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end,
+                                       cbuf, abuf);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool cpu_has_avx2(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] < 7) return false;
+
+    /*The OS also needs to save the AVX registers (OSXSAVE and the YMM state in XCR0)*/
+    __cpuid(info, 1);
+    if((info[2] & (1 << 27)) == 0) return false;
+    if((_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+static const lv_draw_sw_blend_x86_kernels_t * get_kernels(lv_draw_sw_x86_level_t level)
+{
+    switch(level) {
+#if LV_DRAW_SW_AVX2_AVAILABLE
+        case LV_DRAW_SW_X86_LEVEL_AVX2:
+            return &kernels_avx2;
+#endif
+#if LV_DRAW_SW_SSE2_AVAILABLE
+        case LV_DRAW_SW_X86_LEVEL_SSE2:
+            return &kernels_sse2;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE*/
@@ -0,0 +1,258 @@
+/**
+ * @file lv_blend_x86.h
+ *
+ */
+
+#ifndef LV_BLEND_X86_H
+#define LV_BLEND_X86_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../../lv_conf_internal.h"
+
+/* detect whether the x86 kernels can be compiled */
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86)
+#define LV_DRAW_SW_X86_AVAILABLE    1
+#else
+#define LV_DRAW_SW_X86_AVAILABLE    0
+#endif
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+
+#ifdef LV_DRAW_SW_X86_CUSTOM_INCLUDE
+#include LV_DRAW_SW_X86_CUSTOM_INCLUDE
+#endif
+
+#include "../lv_draw_sw_blend.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*The kernels check `opa` and `mask_buf` so all the variants of a blend can use the same function*/
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) \
+    lv_draw_sw_blend_color_to_rgb565_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc) \
+    lv_draw_sw_blend_color_to_rgb565_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc) \
+    lv_draw_sw_blend_color_to_rgb565_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) \
+    lv_draw_sw_blend_color_to_rgb565_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565(dsc)  \
+    lv_draw_sw_blend_argb8888_to_rgb565_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  \
+    lv_draw_sw_blend_argb8888_to_rgb565_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)  \
+    lv_draw_sw_blend_argb8888_to_rgb565_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc)  \
+    lv_draw_sw_blend_argb8888_to_rgb565_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888(dsc, dst_px_size) \
+    lv_draw_sw_blend_color_to_rgb888_x86(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_OPA(dsc, dst_px_size) \
+    lv_draw_sw_blend_color_to_rgb888_x86(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_WITH_MASK(dsc, dst_px_size) \
+    lv_draw_sw_blend_color_to_rgb888_x86(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB888_MIX_MASK_OPA(dsc, dst_px_size) \
+    lv_draw_sw_blend_color_to_rgb888_x86(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888(dsc, dst_px_size)  \
+    lv_draw_sw_blend_argb8888_to_rgb888_x86(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_OPA(dsc, dst_px_size)  \
+    lv_draw_sw_blend_argb8888_to_rgb888_x86(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_WITH_MASK(dsc, dst_px_size)  \
+    lv_draw_sw_blend_argb8888_to_rgb888_x86(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_RGB888_MIX_MASK_OPA(dsc, dst_px_size)  \
+    lv_draw_sw_blend_argb8888_to_rgb888_x86(dsc, dst_px_size)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888(dsc) \
+    lv_draw_sw_blend_color_to_argb8888_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_OPA(dsc) \
+    lv_draw_sw_blend_color_to_argb8888_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_WITH_MASK(dsc) \
+    lv_draw_sw_blend_color_to_argb8888_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_COLOR_BLEND_TO_ARGB8888_MIX_MASK_OPA(dsc) \
+    lv_draw_sw_blend_color_to_argb8888_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888(dsc)  \
+    lv_draw_sw_blend_argb8888_to_argb8888_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_OPA(dsc)  \
+    lv_draw_sw_blend_argb8888_to_argb8888_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_WITH_MASK(dsc)  \
+    lv_draw_sw_blend_argb8888_to_argb8888_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA
+#define LV_DRAW_SW_ARGB8888_BLEND_NORMAL_TO_ARGB8888_MIX_MASK_OPA(dsc)  \
+    lv_draw_sw_blend_argb8888_to_argb8888_x86(dsc)
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888
+#define LV_DRAW_SW_TRANSFORM_ARGB8888(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_buf) \
+    lv_draw_sw_transform_argb8888_x86(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_buf)
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_RGB565A8
+#define LV_DRAW_SW_TRANSFORM_RGB565A8(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, cbuf, abuf) \
+    lv_draw_sw_transform_rgb565a8_x86(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, cbuf, abuf)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The instruction set extensions the kernels can use.
+ * A level includes all the lower levels.
+ */
+typedef enum {
+    LV_DRAW_SW_X86_LEVEL_NONE,      /**< Use the C implementation*/
+    LV_DRAW_SW_X86_LEVEL_SSE2,
+    LV_DRAW_SW_X86_LEVEL_AVX2,
+} lv_draw_sw_x86_level_t;
+
+/**
+ * Pointers to the kernels of a level.
+ * The hooks return `LV_RESULT_INVALID` (or `x_start` for the transformations)
+ * if a kernel is NULL to use the C implementation.
+ */
+typedef struct _lv_draw_sw_blend_x86_kernels_t {
+    lv_result_t (*color_to_rgb565)(_lv_draw_sw_blend_fill_dsc_t * dsc);
+    lv_result_t (*color_to_rgb888)(_lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size);
+    lv_result_t (*color_to_argb8888)(_lv_draw_sw_blend_fill_dsc_t * dsc);
+    lv_result_t (*argb8888_to_rgb565)(_lv_draw_sw_blend_image_dsc_t * dsc);
+    lv_result_t (*argb8888_to_rgb888)(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size);
+    lv_result_t (*argb8888_to_argb8888)(_lv_draw_sw_blend_image_dsc_t * dsc);
+    int32_t (*transform_argb8888)(const uint8_t * src, int32_t src_stride, int32_t xs_ups, int32_t ys_ups,
+                                  int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end, uint32_t * dest_buf);
+    int32_t (*transform_rgb565a8)(const uint8_t * src, int32_t src_stride, const lv_opa_t * src_alpha, int32_t xs_ups,
+                                  int32_t ys_ups, int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end,
+                                  uint16_t * cbuf, uint8_t * abuf);
+} lv_draw_sw_blend_x86_kernels_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Detect the instruction set extensions supported by the CPU and use the fastest kernels.
+ * Called by `lv_draw_sw_init()`.
+ */
+void lv_draw_sw_blend_x86_init(void);
+
+/**
+ * Get the highest level supported by both the CPU and the build.
+ * @return          the highest usable level
+ */
+lv_draw_sw_x86_level_t lv_draw_sw_blend_x86_get_supported_level(void);
+
+/**
+ * Limit the kernels to a level. E.g. to compare the results or the speed of the levels.
+ * If the level is not supported the highest supported level will be used instead.
+ * @param level     the level to use
+ */
+void lv_draw_sw_blend_x86_set_level(lv_draw_sw_x86_level_t level);
+
+/**
+ * Get the level of the kernels in use.
+ * @return          the current level
+ */
+lv_draw_sw_x86_level_t lv_draw_sw_blend_x86_get_level(void);
+
+lv_result_t lv_draw_sw_blend_color_to_rgb565_x86(_lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_color_to_rgb888_x86(_lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dest_px_size);
+
+lv_result_t lv_draw_sw_blend_color_to_argb8888_x86(_lv_draw_sw_blend_fill_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb565_x86(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+lv_result_t lv_draw_sw_blend_argb8888_to_rgb888_x86(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dest_px_size);
+
+lv_result_t lv_draw_sw_blend_argb8888_to_argb8888_x86(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+int32_t lv_draw_sw_transform_argb8888_x86(const uint8_t * src, int32_t src_stride, int32_t xs_ups, int32_t ys_ups,
+                                          int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end,
+                                          uint32_t * dest_buf);
+
+int32_t lv_draw_sw_transform_rgb565a8_x86(const uint8_t * src, int32_t src_stride, const lv_opa_t * src_alpha,
+                                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                          int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf);
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BLEND_X86_H*/
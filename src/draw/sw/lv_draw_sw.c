@@ -14,6 +14,7 @@
 #include "../../display/lv_display_private.h"
 #include "../../stdlib/lv_string.h"
 #include "../../core/lv_global.h"
+#include "../lv_draw_trace.h"
 
 #if LV_USE_VECTOR_GRAPHIC && LV_USE_THORVG
     #if LV_USE_THORVG_EXTERNAL
@@ -25,6 +26,8 @@
 
 #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
     #include "arm2d/lv_draw_sw_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+    #include "blend/x86/lv_blend_x86.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
@@ -83,11 +86,13 @@
  **********************/
 #if LV_USE_OS
     static void render_thread_cb(void * ptr);
+    static void finish_and_take_next(lv_draw_sw_unit_t * u);
 #endif
 
 static void execute_drawing(lv_draw_sw_unit_t * u);
 
 static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+static bool take_task(lv_draw_sw_unit_t * u, lv_layer_t * layer);
 static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit);
 
@@ -132,6 +137,11 @@ void lv_draw_sw_init(void)
 
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_init();
+    lv_draw_sw_shadow_cache_init();
+#endif
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+    lv_draw_sw_blend_x86_init();
 #endif
 
     uint32_t i;
@@ -160,6 +170,7 @@ void lv_draw_sw_deinit(void)
 
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
+    lv_draw_sw_shadow_cache_deinit();
 #endif
 }
 
@@ -244,7 +255,7 @@ static inline void execute_drawing_unit(lv_draw_sw_unit_t * u)
 {
     execute_drawing(u);
 
-    u->task_act->state = LV_DRAW_TASK_STATE_READY;
+    lv_draw_task_set_state(u->task_act, LV_DRAW_TASK_STATE_READY);
     u->task_act = NULL;
 
     /*The draw unit is free now. Request a new dispatching as it can get a new task*/
@@ -294,30 +305,24 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     LV_PROFILER_BEGIN;
     lv_draw_sw_unit_t * draw_sw_unit = (lv_draw_sw_unit_t *) draw_unit;
 
+    /*The render threads also take tasks by themselves so the list needs to be protected*/
+    lv_mutex_lock(&_draw_info.task_list_mutex);
+
     /*Return immediately if it's busy with draw task*/
     if(draw_sw_unit->task_act) {
+        lv_mutex_unlock(&_draw_info.task_list_mutex);
         LV_PROFILER_END;
         return 0;
     }
 
-    lv_draw_task_t * t = NULL;
-    t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_SW);
-    if(t == NULL) {
-        LV_PROFILER_END;
-        return -1;
-    }
+    bool taken = take_task(draw_sw_unit, layer);
+    lv_mutex_unlock(&_draw_info.task_list_mutex);
 
-    void * buf = lv_draw_layer_alloc_buf(layer);
-    if(buf == NULL) {
+    if(!taken) {
         LV_PROFILER_END;
         return -1;
     }
 
-    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
-    draw_sw_unit->base_unit.target_layer = layer;
-    draw_sw_unit->base_unit.clip_area = &t->clip_area;
-    draw_sw_unit->task_act = t;
-
 #if LV_USE_OS
     /*Let the render thread work*/
     if(draw_sw_unit->inited) lv_thread_sync_signal(&draw_sw_unit->sync);
@@ -328,6 +333,28 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     return 1;
 }
 
+/**
+ * Assign the next independent draw task of a layer to a draw unit.
+ * `task_list_mutex` needs to be locked.
+ * @param u         pointer to an idle SW draw unit
+ * @param layer     the layer to take the draw task from
+ * @return          true: a task was assigned; false: no available task or out of memory
+ */
+static bool take_task(lv_draw_sw_unit_t * u, lv_layer_t * layer)
+{
+    lv_draw_task_t * t = _lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_SW);
+    if(t == NULL) return false;
+
+    void * buf = lv_draw_layer_alloc_buf(layer);
+    if(buf == NULL) return false;
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    u->base_unit.target_layer = layer;
+    u->base_unit.clip_area = &t->clip_area;
+    u->task_act = t;
+    return true;
+}
+
 #if LV_USE_OS
 static void render_thread_cb(void * ptr)
 {
@@ -349,13 +376,49 @@ static void render_thread_cb(void * ptr)
             break;
         }
 
-        execute_drawing_unit(u);
+        execute_drawing(u);
+        finish_and_take_next(u);
     }
 
     u->inited = false;
     lv_thread_sync_delete(&u->sync);
     LV_LOG_INFO("exit software rendering thread");
 }
+
+/**
+ * Mark the current task of a render thread as ready and take the next
+ * independent tasks from the same layer for this and the idle SW draw units.
+ * This way the render threads don't need to wait for the dispatcher to get new work.
+ * @param u     pointer to a SW draw unit which has just finished its task
+ */
+static void finish_and_take_next(lv_draw_sw_unit_t * u)
+{
+    LV_PROFILER_BEGIN;
+    lv_layer_t * layer = u->base_unit.target_layer;
+
+    /*Once the task is ready the dispatcher can finish and free the layer.
+     *So mark it as ready and take the next task without releasing the lock.*/
+    lv_mutex_lock(&_draw_info.task_list_mutex);
+    _lv_draw_task_set_state(u->task_act, LV_DRAW_TASK_STATE_READY);
+    u->task_act = NULL;
+    take_task(u, layer);
+
+    /*Share the remaining work with the idle render threads*/
+    lv_draw_unit_t * unit = _draw_info.unit_head;
+    while(unit) {
+        lv_draw_sw_unit_t * other = (lv_draw_sw_unit_t *)unit;
+        if(other != u && unit->dispatch_cb == dispatch && other->inited && other->task_act == NULL) {
+            if(!take_task(other, layer)) break;
+            lv_thread_sync_signal(&other->sync);
+        }
+        unit = unit->next;
+    }
+    lv_mutex_unlock(&_draw_info.task_list_mutex);
+
+    /*Let the dispatcher free the finished tasks and continue with the other layers*/
+    lv_draw_dispatch_request();
+    LV_PROFILER_END;
+}
 #endif
 
 static void execute_drawing(lv_draw_sw_unit_t * u)
@@ -363,6 +426,9 @@ static void execute_drawing(lv_draw_sw_unit_t * u)
     LV_PROFILER_BEGIN;
     /*Render the draw task*/
     lv_draw_task_t * t = u->task_act;
+#if LV_USE_DRAW_TRACE
+    _lv_draw_trace_task_start((lv_draw_unit_t *)u, t);
+#endif
     switch(t->type) {
         case LV_DRAW_TASK_TYPE_FILL:
             lv_draw_sw_fill((lv_draw_unit_t *)u, t->draw_dsc, &t->area);
@@ -403,6 +469,10 @@ static void execute_drawing(lv_draw_sw_unit_t * u)
             break;
     }
 
+#if LV_USE_DRAW_TRACE
+    _lv_draw_trace_task_finish((lv_draw_unit_t *)u, t);
+#endif
+
 #if LV_USE_PARALLEL_DRAW_DEBUG
     /*Layers manage it for themselves*/
     if(t->type != LV_DRAW_TASK_TYPE_LAYER) {
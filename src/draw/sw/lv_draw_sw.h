@@ -43,14 +43,6 @@ typedef struct {
     uint32_t idx;
 } lv_draw_sw_unit_t;
 
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-typedef struct {
-    uint8_t cache[LV_DRAW_SW_SHADOW_CACHE_SIZE * LV_DRAW_SW_SHADOW_CACHE_SIZE];
-    int32_t cache_size;
-    int32_t cache_r;
-} lv_draw_sw_shadow_cache_t;
-#endif
-
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -90,6 +82,30 @@ void lv_draw_sw_border(lv_draw_unit_t * draw_unit, const lv_draw_border_dsc_t *
  */
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords);
 
+#if LV_DRAW_SW_COMPLEX
+/**
+ * Create the shadow cache which stores the blurred corners of the box shadows. Called internally.
+ */
+void lv_draw_sw_shadow_cache_init(void);
+
+/**
+ * Delete the shadow cache. Called internally.
+ */
+void lv_draw_sw_shadow_cache_deinit(void);
+
+/**
+ * Set the size of the shadow cache.
+ * @param new_size      the new size in bytes. 0: disable the cache
+ * @param evict_now     true: drop the corners immediately which don't fit into the new size
+ */
+void lv_draw_sw_shadow_cache_resize(uint32_t new_size, bool evict_now);
+
+/**
+ * Drop all the corners from the shadow cache.
+ */
+void lv_draw_sw_shadow_cache_drop_all(void);
+#endif
+
 /**
  * Draw an image with SW render. It handles image decoding, tiling, transformations, and recoloring.
  * @param draw_unit     pointer to a draw unit
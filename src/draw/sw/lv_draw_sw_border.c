@@ -35,6 +35,16 @@ static void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * ou
 static void draw_border_simple(lv_draw_unit_t * draw_unit, const lv_area_t * outer_area, const lv_area_t * inner_area,
                                lv_color_t color, lv_opa_t opa);
 
+#if LV_DRAW_SW_COMPLEX
+static lv_draw_sw_mask_res_t get_corner_mask_row(const lv_draw_sw_mask_radius_param_t * rin_param,
+                                                 lv_draw_sw_mask_radius_param_t * rout_param,
+                                                 lv_opa_t * mask_buf, int32_t abs_x, int32_t abs_y, int32_t len);
+static void blend_corner_row(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc,
+                             const lv_draw_sw_mask_radius_param_t * rin_param,
+                             lv_draw_sw_mask_radius_param_t * rout_param, lv_opa_t * mask_buf,
+                             int32_t y, int32_t x1, int32_t x2);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -98,18 +108,16 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
     lv_opa_t * mask_buf = lv_malloc(draw_area_w);
     blend_dsc.mask_buf = mask_buf;
 
-    void * mask_list[3] = {0};
-
     /*Create mask for the inner mask*/
     lv_draw_sw_mask_radius_param_t mask_rin_param;
     lv_draw_sw_mask_radius_init(&mask_rin_param, inner_area, rin, true);
-    mask_list[0] = &mask_rin_param;
 
     /*Create mask for the outer area*/
     lv_draw_sw_mask_radius_param_t mask_rout_param;
+    lv_draw_sw_mask_radius_param_t * mask_rout_p = NULL;
     if(rout > 0) {
         lv_draw_sw_mask_radius_init(&mask_rout_param, outer_area, rout, false);
-        mask_list[1] = &mask_rout_param;
+        mask_rout_p = &mask_rout_param;
     }
 
     int32_t h;
@@ -198,8 +206,8 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
             int32_t bottom_y = outer_area->y2 - h;
             if(top_y < draw_area.y1 && bottom_y > draw_area.y2) continue;   /*This line is clipped now*/
 
-            lv_memset(mask_buf, 0xff, draw_area_w);
-            blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, top_y, draw_area_w);
+            blend_dsc.mask_res = get_corner_mask_row(&mask_rin_param, mask_rout_p, mask_buf, blend_area.x1, top_y,
+                                                     draw_area_w);
 
             if(top_y >= draw_area.y1) {
                 blend_area.y1 = top_y;
@@ -222,23 +230,15 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
         if(blend_w > 0) {
             if(left_side || top_side) {
                 for(h = draw_area.y1; h < core_area.y1; h++) {
-                    blend_area.y1 = h;
-                    blend_area.y2 = h;
-
-                    lv_memset(mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_unit, &blend_dsc);
+                    blend_corner_row(draw_unit, &blend_dsc, &mask_rin_param, mask_rout_p, mask_buf, h,
+                                     blend_area.x1, blend_area.x2);
                 }
             }
 
             if(left_side || bottom_side) {
                 for(h = core_area.y2 + 1; h <= draw_area.y2; h++) {
-                    blend_area.y1 = h;
-                    blend_area.y2 = h;
-
-                    lv_memset(mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_unit, &blend_dsc);
+                    blend_corner_row(draw_unit, &blend_dsc, &mask_rin_param, mask_rout_p, mask_buf, h,
+                                     blend_area.x1, blend_area.x2);
                 }
             }
         }
@@ -253,30 +253,22 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
         if(blend_w > 0) {
             if(right_side || top_side) {
                 for(h = draw_area.y1; h < core_area.y1; h++) {
-                    blend_area.y1 = h;
-                    blend_area.y2 = h;
-
-                    lv_memset(mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_unit, &blend_dsc);
+                    blend_corner_row(draw_unit, &blend_dsc, &mask_rin_param, mask_rout_p, mask_buf, h,
+                                     blend_area.x1, blend_area.x2);
                 }
             }
 
             if(right_side || bottom_side) {
                 for(h = core_area.y2 + 1; h <= draw_area.y2; h++) {
-                    blend_area.y1 = h;
-                    blend_area.y2 = h;
-
-                    lv_memset(mask_buf, 0xff, blend_w);
-                    blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, h, blend_w);
-                    lv_draw_sw_blend(draw_unit, &blend_dsc);
+                    blend_corner_row(draw_unit, &blend_dsc, &mask_rin_param, mask_rout_p, mask_buf, h,
+                                     blend_area.x1, blend_area.x2);
                 }
             }
         }
     }
 
     lv_draw_sw_mask_free_param(&mask_rin_param);
-    if(rout > 0) lv_draw_sw_mask_free_param(&mask_rout_param);
+    if(mask_rout_p) lv_draw_sw_mask_free_param(mask_rout_p);
     lv_free(mask_buf);
 
 #endif /*LV_DRAW_SW_COMPLEX*/
@@ -329,4 +321,109 @@ static void draw_border_simple(lv_draw_unit_t * draw_unit, const lv_area_t * out
     }
 }
 
+#if LV_DRAW_SW_COMPLEX
+/**
+ * Get the mask of a row of the border's corners from its radius masks without `lv_draw_sw_mask_apply()`
+ * @param rin_param     the inner radius mask
+ * @param rout_param    the outer radius mask or NULL if the outer radius is 0
+ * @param mask_buf      store the mask of the row here
+ * @param abs_x         absolute X coordinate where the row starts
+ * @param abs_y         absolute Y coordinate of the row
+ * @param len           length of the row
+ * @return              the result of the masking, as `lv_draw_sw_mask_apply()` would return
+ */
+static lv_draw_sw_mask_res_t get_corner_mask_row(const lv_draw_sw_mask_radius_param_t * rin_param,
+                                                 lv_draw_sw_mask_radius_param_t * rout_param,
+                                                 lv_opa_t * mask_buf, int32_t abs_x, int32_t abs_y, int32_t len)
+{
+    lv_draw_sw_mask_res_t res = lv_draw_sw_mask_radius_fill_row(rin_param, mask_buf, abs_x, abs_y, len, LV_OPA_COVER);
+    if(rout_param == NULL || res == LV_DRAW_SW_MASK_RES_TRANSP) return res;
+
+    /*The inner mask doesn't affect the row so the outer mask can set it directly*/
+    if(res == LV_DRAW_SW_MASK_RES_FULL_COVER) {
+        return lv_draw_sw_mask_radius_fill_row(rout_param, mask_buf, abs_x, abs_y, len, LV_OPA_COVER);
+    }
+
+    /*Mix the outer mask after the inner one to get the same rounding as before*/
+    void * masks[2] = {rout_param, NULL};
+    res = lv_draw_sw_mask_apply(masks, mask_buf, abs_x, abs_y, len);
+    return res == LV_DRAW_SW_MASK_RES_TRANSP ? res : LV_DRAW_SW_MASK_RES_CHANGED;
+}
+
+/**
+ * Blend a row of a corner as spans: the anti-aliased parts with a mask and the longest
+ * fully covered part (inside the outer and outside the inner rounded rectangle) without a mask.
+ * @param draw_unit     pointer to a draw unit
+ * @param blend_dsc     the color and opacity of the border
+ * @param rin_param     the inner radius mask
+ * @param rout_param    the outer radius mask or NULL if the outer radius is 0
+ * @param mask_buf      a buffer for the mask of the row
+ * @param y             absolute Y coordinate of the row
+ * @param x1            first absolute X coordinate of the row
+ * @param x2            last absolute X coordinate of the row
+ */
+static void blend_corner_row(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc,
+                             const lv_draw_sw_mask_radius_param_t * rin_param,
+                             lv_draw_sw_mask_radius_param_t * rout_param, lv_opa_t * mask_buf,
+                             int32_t y, int32_t x1, int32_t x2)
+{
+    int32_t out_x1 = x1;
+    int32_t out_x2 = x2;
+    int32_t aa_len;
+    if(rout_param) lv_draw_sw_mask_radius_get_row(rout_param, y, &out_x1, &out_x2, &aa_len);
+    out_x1 = LV_MAX(out_x1, x1);
+    out_x2 = LV_MIN(out_x2, x2);
+
+    /*Cut out the pixels touched by the inner rounded rectangle and keep the longer side*/
+    int32_t mid_x1 = out_x1;
+    int32_t mid_x2 = out_x2;
+    int32_t in_x1;
+    int32_t in_x2;
+    lv_draw_sw_mask_radius_get_row(rin_param, y, &in_x1, &in_x2, &aa_len);
+    if(in_x1 <= in_x2 || aa_len > 0) {
+        in_x1 -= aa_len;
+        in_x2 += aa_len;
+        int32_t left_x2 = LV_MIN(out_x2, in_x1 - 1);
+        int32_t right_x1 = LV_MAX(out_x1, in_x2 + 1);
+        if(left_x2 - out_x1 >= out_x2 - right_x1) mid_x2 = left_x2;
+        else mid_x1 = right_x1;
+    }
+
+    lv_area_t blend_area = {x1, y, x2, y};
+    lv_draw_sw_blend_dsc_t dsc = *blend_dsc;
+    dsc.blend_area = &blend_area;
+    dsc.mask_area = &blend_area;
+    dsc.mask_buf = mask_buf;
+
+    /*Mix the opacity of the middle the same way as the blending would do it with a 0xFF mask*/
+    lv_opa_t mid_opa = dsc.opa >= LV_OPA_MAX ? LV_OPA_COVER : LV_OPA_MIX2(LV_OPA_COVER, dsc.opa);
+    bool mid_exact = mid_opa == LV_OPA_COVER || (mid_opa > LV_OPA_MIN && mid_opa < LV_OPA_MAX);
+    if(mid_x1 > mid_x2 || !mid_exact) {
+        dsc.mask_res = get_corner_mask_row(rin_param, rout_param, mask_buf, x1, y, x2 - x1 + 1);
+        lv_draw_sw_blend(draw_unit, &dsc);
+        return;
+    }
+
+    if(mid_x1 > x1) {
+        blend_area.x1 = x1;
+        blend_area.x2 = mid_x1 - 1;
+        dsc.mask_res = get_corner_mask_row(rin_param, rout_param, mask_buf, x1, y, mid_x1 - x1);
+        lv_draw_sw_blend(draw_unit, &dsc);
+    }
+
+    if(mid_x2 < x2) {
+        blend_area.x1 = mid_x2 + 1;
+        blend_area.x2 = x2;
+        dsc.mask_res = get_corner_mask_row(rin_param, rout_param, mask_buf, mid_x2 + 1, y, x2 - mid_x2);
+        lv_draw_sw_blend(draw_unit, &dsc);
+    }
+
+    blend_area.x1 = mid_x1;
+    blend_area.x2 = mid_x2;
+    dsc.mask_buf = NULL;
+    dsc.opa = mid_opa;
+    lv_draw_sw_blend(draw_unit, &dsc);
+}
+#endif /*LV_DRAW_SW_COMPLEX*/
+
 #endif /*LV_USE_DRAW_SW*/
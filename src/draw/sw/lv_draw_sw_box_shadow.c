@@ -17,6 +17,7 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
 #include "../../stdlib/lv_string.h"
+#include "../../misc/cache/lv_cache.h"
 #include "../lv_draw_mask.h"
 
 /*********************
@@ -25,20 +26,32 @@
 #define SHADOW_UPSCALE_SHIFT    6
 #define SHADOW_ENHANCE          1
 
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    #define shadow_cache LV_GLOBAL_DEFAULT()->sw_shadow_cache
-#endif
+#define shadow_cache_p          LV_GLOBAL_DEFAULT()->sw_shadow_cache
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    lv_cache_slot_size_t slot;
+    int32_t sw;             /**< Shadow width*/
+    int32_t r;              /**< Clamped radius*/
+    int32_t w;              /**< Width of the blurred rectangle, limited to where it still affects the corner*/
+    int32_t h;              /**< Height of the blurred rectangle, limited to where it still affects the corner*/
+    lv_opa_t * corners;     /**< The corners calculated by `shadow_draw_corners()`*/
+} shadow_cache_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+static void shadow_draw_corners(const lv_area_t * coords, lv_opa_t * corners, int32_t sw, int32_t r);
+static lv_cache_entry_t * shadow_cache_acquire(const lv_area_t * core_area, int32_t sw, int32_t r);
+static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_data_t * lhs, const shadow_cache_data_t * rhs);
+static bool shadow_cache_create_cb(shadow_cache_data_t * data, void * user_data);
+static void shadow_cache_free_cb(shadow_cache_data_t * data, void * user_data);
 
 /**********************
  *  STATIC VARIABLES
@@ -52,6 +65,43 @@ static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t
  *   GLOBAL FUNCTIONS
  **********************/
 
+void lv_draw_sw_shadow_cache_init(void)
+{
+    if(shadow_cache_p != NULL) return;
+
+    shadow_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(shadow_cache_data_t), LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) shadow_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) shadow_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) shadow_cache_free_cb,
+    });
+}
+
+void lv_draw_sw_shadow_cache_deinit(void)
+{
+    if(shadow_cache_p == NULL) return;
+
+    lv_cache_destroy(shadow_cache_p, NULL);
+    shadow_cache_p = NULL;
+}
+
+void lv_draw_sw_shadow_cache_resize(uint32_t new_size, bool evict_now)
+{
+    if(shadow_cache_p == NULL) return;
+
+    lv_cache_set_max_size(shadow_cache_p, new_size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(shadow_cache_p, new_size, NULL);
+    }
+}
+
+void lv_draw_sw_shadow_cache_drop_all(void)
+{
+    if(shadow_cache_p == NULL) return;
+
+    lv_cache_drop_all(shadow_cache_p, NULL);
+}
+
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
 {
     /*Calculate the rectangle which is blurred to get the shadow in `shadow_area`*/
@@ -94,31 +144,18 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     /*Get how many pixels are affected by the blur on the corners*/
     int32_t corner_size = dsc->width  + r_sh;
 
-    lv_opa_t * sh_buf;
-
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
-    lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
-    if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_malloc(corner_size * corner_size);
-        lv_memcpy(sh_buf, cache->cache, corner_size * corner_size);
+    /*Get the right corner and its mirrored version for the left side from the cache or calculate them now*/
+    lv_opa_t * sh_corners;
+    lv_cache_entry_t * sh_entry = shadow_cache_acquire(&core_area, dsc->width, r_sh);
+    if(sh_entry) {
+        shadow_cache_data_t * data = lv_cache_entry_get_data(sh_entry);
+        sh_corners = data->corners;
     }
     else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(cache->cache)) {
-            lv_memcpy(cache->cache, sh_buf, corner_size * corner_size);
-            cache->cache_size = corner_size;
-            cache->cache_r = r_sh;
-        }
+        sh_corners = lv_malloc(corner_size * corner_size * 2);
+        shadow_draw_corners(&core_area, sh_corners, dsc->width, r_sh);
     }
-#else
-    sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
-    shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
-#endif /*LV_DRAW_SW_SHADOW_CACHE_SIZE*/
+    const lv_opa_t * sh_buf = sh_corners;
 
     /*Skip a lot of masking if the background will cover the shadow that would be masked out*/
     bool simple = dsc->bg_cover;
@@ -135,7 +172,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     lv_opa_t * mask_buf = lv_malloc(lv_area_get_width(&shadow_area));
     lv_area_t blend_area;
     lv_area_t clip_area_sub;
-    lv_opa_t * sh_buf_tmp;
+    const lv_opa_t * sh_buf_tmp;
     int32_t y;
     bool simple_sub;
 
@@ -376,22 +413,8 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
         }
     }
 
-    /*Mirror the shadow corner buffer horizontally*/
-    sh_buf_tmp = sh_buf ;
-    for(y = 0; y < corner_size; y++) {
-        int32_t x;
-        lv_opa_t * start = sh_buf_tmp;
-        lv_opa_t * end = sh_buf_tmp + corner_size - 1;
-        for(x = 0; x < corner_size / 2; x++) {
-            lv_opa_t tmp = *start;
-            *start = *end;
-            *end = tmp;
-
-            start++;
-            end--;
-        }
-        sh_buf_tmp += corner_size;
-    }
+    /*Use the horizontally mirrored shadow corner for the left side*/
+    sh_buf = sh_corners + corner_size * corner_size;
 
     /*Left side*/
     blend_area.x1 = shadow_area.x1;
@@ -549,7 +572,8 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     if(!simple) {
         lv_draw_sw_mask_free_param(&mask_rout_param);
     }
-    lv_free(sh_buf);
+    if(sh_entry) lv_cache_release(shadow_cache_p, sh_entry, NULL);
+    else lv_free(sh_corners);
     lv_free(mask_buf);
 }
 
@@ -724,6 +748,93 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
     lv_free(sh_ups_blur_buf);
 }
 
+/**
+ * Calculate the blurred top right corner and its horizontally mirrored version for the left side
+ * @param coords    coordinates of the rectangle to blur. Only its size matters.
+ * @param corners   a buffer to store the result. Its size should be `(sw + r)^2 * 2`.
+ *                  The top right corner is followed by the top left corner.
+ * @param sw        shadow width
+ * @param r         radius
+ */
+static void shadow_draw_corners(const lv_area_t * coords, lv_opa_t * corners, int32_t sw, int32_t r)
+{
+    int32_t size = sw + r;
+
+    /*The second half is also used during the calculation so it can be set only after it*/
+    shadow_draw_corner_buf(coords, (uint16_t *)corners, sw, r);
+
+    const lv_opa_t * src = corners;
+    lv_opa_t * dest = corners + size * size;
+    int32_t y;
+    for(y = 0; y < size; y++) {
+        int32_t x;
+        for(x = 0; x < size; x++) {
+            dest[x] = src[size - 1 - x];
+        }
+        src += size;
+        dest += size;
+    }
+}
+
+/**
+ * Get the corners of a shadow from the shadow cache and calculate them if they are not cached yet
+ * @param core_area     the rectangle to blur
+ * @param sw            shadow width
+ * @param r             the clamped radius
+ * @return              the acquired cache entry or NULL if the corners can't be cached
+ */
+static lv_cache_entry_t * shadow_cache_acquire(const lv_area_t * core_area, int32_t sw, int32_t r)
+{
+    if(shadow_cache_p == NULL) return NULL;
+
+    int32_t size = sw + r;
+
+    /*The far sides of rectangles larger than `size + r` don't reach the calculated corner
+     *so all of them have the same corners*/
+    shadow_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.slot.size = size * size * 2;
+    search_key.sw = sw;
+    search_key.r = r;
+    search_key.w = LV_MIN(lv_area_get_width(core_area), size + r);
+    search_key.h = LV_MIN(lv_area_get_height(core_area), size + r);
+
+    /*Don't even try to add corners which would never fit*/
+    if(search_key.slot.size > lv_cache_get_max_size(shadow_cache_p, NULL)) return NULL;
+
+    return lv_cache_acquire_or_create(shadow_cache_p, &search_key, NULL);
+}
+
+static lv_cache_compare_res_t shadow_cache_compare_cb(const shadow_cache_data_t * lhs, const shadow_cache_data_t * rhs)
+{
+    if(lhs->sw != rhs->sw) return lhs->sw > rhs->sw ? 1 : -1;
+    if(lhs->r != rhs->r) return lhs->r > rhs->r ? 1 : -1;
+    if(lhs->w != rhs->w) return lhs->w > rhs->w ? 1 : -1;
+    if(lhs->h != rhs->h) return lhs->h > rhs->h ? 1 : -1;
+
+    return 0;
+}
+
+static bool shadow_cache_create_cb(shadow_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    int32_t size = data->sw + data->r;
+    data->corners = lv_malloc(size * size * 2);
+    if(data->corners == NULL) return false;
+
+    lv_area_t coords = {0, 0, data->w - 1, data->h - 1};
+    shadow_draw_corners(&coords, data->corners, data->sw, data->r);
+    return true;
+}
+
+static void shadow_cache_free_cb(shadow_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(data->corners);
+}
+
 #else /*LV_DRAW_SW_COMPLEX*/
 
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
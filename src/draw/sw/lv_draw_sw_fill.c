@@ -30,6 +30,11 @@
  *  STATIC PROTOTYPES
  **********************/
 
+#if LV_DRAW_SW_COMPLEX
+static void blend_corner_row(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc, int32_t y,
+                             int32_t x1, int32_t x2, int32_t mid_x1, int32_t mid_x2, lv_opa_t mask_opa);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -82,11 +87,9 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
     int32_t clipped_w = lv_area_get_width(&clipped_coords);
     lv_opa_t * mask_buf = NULL;
     lv_draw_sw_mask_radius_param_t mask_rout_param;
-    void * mask_list[2] = {NULL, NULL};
     if(rout > 0) {
         mask_buf = lv_malloc(clipped_w);
         lv_draw_sw_mask_radius_init(&mask_rout_param, &bg_coords, rout, false);
-        mask_list[0] = &mask_rout_param;
     }
 
     int32_t h;
@@ -126,11 +129,35 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
         int32_t bottom_y = bg_coords.y2 - h;
         if(top_y < clipped_coords.y1 && bottom_y > clipped_coords.y2) continue;   /*This line is clipped now*/
 
-        /* Initialize the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
-         * It saves calculating the final opa in lv_draw_sw_blend*/
-        lv_memset(mask_buf, opa, clipped_w);
-        blend_dsc.mask_res = lv_draw_sw_mask_apply(mask_list, mask_buf, blend_area.x1, top_y, clipped_w);
-        if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+        /* Set the covered pixels of the mask to opa instead of 0xFF and blend with LV_OPA_COVER.
+         * It saves calculating the final opa in lv_draw_sw_blend.
+         * Without horizontal gradient only the anti-aliased ends of the row need a mask.*/
+        int32_t mid_x1 = 0;
+        int32_t mid_x2 = -1;
+        if(grad_dir == LV_GRAD_DIR_HOR) {
+            blend_dsc.mask_res = lv_draw_sw_mask_radius_fill_row(&mask_rout_param, mask_buf, blend_area.x1, top_y,
+                                                                 clipped_w, opa);
+            if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+        }
+        else {
+            int32_t aa_len;
+            lv_draw_sw_mask_radius_get_row(&mask_rout_param, top_y, &mid_x1, &mid_x2, &aa_len);
+            mid_x1 = LV_MAX(mid_x1, blend_area.x1);
+            mid_x2 = LV_MIN(mid_x2, blend_area.x2);
+            if(mid_x1 > mid_x2) {
+                mid_x1 = blend_area.x2 + 1;
+                mid_x2 = blend_area.x2;
+            }
+
+            if(mid_x1 > blend_area.x1) {
+                lv_draw_sw_mask_radius_fill_row(&mask_rout_param, mask_buf, blend_area.x1, top_y,
+                                                mid_x1 - blend_area.x1, opa);
+            }
+            if(mid_x2 < blend_area.x2) {
+                lv_draw_sw_mask_radius_fill_row(&mask_rout_param, &mask_buf[mid_x2 + 1 - blend_area.x1], mid_x2 + 1, top_y,
+                                                blend_area.x2 - mid_x2, opa);
+            }
+        }
 
         bool hor_grad_processed = false;
         if(top_y >= clipped_coords.y1) {
@@ -151,7 +178,9 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
                     blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
             }
-            lv_draw_sw_blend(draw_unit, &blend_dsc);
+
+            if(grad_dir == LV_GRAD_DIR_HOR) lv_draw_sw_blend(draw_unit, &blend_dsc);
+            else blend_corner_row(draw_unit, &blend_dsc, top_y, blend_area.x1, blend_area.x2, mid_x1, mid_x2, opa);
         }
 
         if(bottom_y <= clipped_coords.y2) {
@@ -171,7 +200,9 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
                     blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
             }
-            lv_draw_sw_blend(draw_unit, &blend_dsc);
+
+            if(grad_dir == LV_GRAD_DIR_HOR) lv_draw_sw_blend(draw_unit, &blend_dsc);
+            else blend_corner_row(draw_unit, &blend_dsc, bottom_y, blend_area.x1, blend_area.x2, mid_x1, mid_x2, opa);
         }
     }
 
@@ -221,4 +252,63 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, const lv_draw_fill_dsc_t * dsc,
 #endif
 }
 
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_DRAW_SW_COMPLEX
+/**
+ * Blend a row of the rounded corners as spans: the anti-aliased ends with a mask
+ * and the fully covered middle without a mask.
+ * @param draw_unit     pointer to a draw unit
+ * @param blend_dsc     the color, opacity and mask buffer of the row. The mask buffer starts at `x1`
+ *                      and has to be set outside of the [`mid_x1`, `mid_x2`] range.
+ * @param y             the absolute Y coordinate of the row
+ * @param x1            the first absolute X coordinate of the row
+ * @param x2            the last absolute X coordinate of the row
+ * @param mid_x1        the first fully covered absolute X coordinate. `x2 + 1` if there are no such pixels.
+ * @param mid_x2        the last fully covered absolute X coordinate
+ * @param mask_opa      the value of the fully covered pixels in the mask
+ */
+static void blend_corner_row(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc, int32_t y,
+                             int32_t x1, int32_t x2, int32_t mid_x1, int32_t mid_x2, lv_opa_t mask_opa)
+{
+    lv_area_t mask_area = {x1, y, x2, y};
+    lv_area_t blend_area = mask_area;
+    lv_draw_sw_blend_dsc_t dsc = *blend_dsc;
+    dsc.mask_area = &mask_area;
+    dsc.blend_area = &blend_area;
+    dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+
+    /*Mix the opacity of the middle the same way as the blending would do it with the mask*/
+    lv_opa_t mid_opa = dsc.opa >= LV_OPA_MAX ? mask_opa : LV_OPA_MIX2(mask_opa, dsc.opa);
+    if(mid_x1 <= mid_x2 && mid_opa != LV_OPA_COVER && (mid_opa <= LV_OPA_MIN || mid_opa >= LV_OPA_MAX)) {
+        /*This opacity would be rounded differently without a mask*/
+        lv_memset((lv_opa_t *)&dsc.mask_buf[mid_x1 - x1], mask_opa, mid_x2 - mid_x1 + 1);
+        lv_draw_sw_blend(draw_unit, &dsc);
+        return;
+    }
+
+    if(mid_x1 > x1) {
+        blend_area.x1 = x1;
+        blend_area.x2 = mid_x1 - 1;
+        lv_draw_sw_blend(draw_unit, &dsc);
+    }
+
+    if(mid_x2 < x2) {
+        blend_area.x1 = mid_x2 + 1;
+        blend_area.x2 = x2;
+        lv_draw_sw_blend(draw_unit, &dsc);
+    }
+
+    if(mid_x1 <= mid_x2) {
+        blend_area.x1 = mid_x1;
+        blend_area.x2 = mid_x2;
+        dsc.mask_buf = NULL;
+        dsc.opa = mid_opa;
+        lv_draw_sw_blend(draw_unit, &dsc);
+    }
+}
+#endif /*LV_DRAW_SW_COMPLEX*/
+
 #endif /*LV_USE_DRAW_SW*/
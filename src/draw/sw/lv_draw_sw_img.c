@@ -28,7 +28,7 @@
 /*********************
  *      DEFINES
  *********************/
-#define MAX_BUF_SIZE (uint32_t) (4 * lv_display_get_horizontal_resolution(_lv_refr_get_disp_refreshing()) * lv_color_format_get_size(lv_display_get_color_format(_lv_refr_get_disp_refreshing())))
+#define MAX_BUF_SIZE(layer) (uint32_t) (4 * lv_area_get_width(&(layer)->buf_area) * lv_color_format_get_size((layer)->color_format))
 
 #ifndef LV_DRAW_SW_IMAGE
     #define LV_DRAW_SW_IMAGE(...)   LV_RESULT_INVALID
@@ -299,13 +299,13 @@ static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t
         int32_t buf_h;
         if(cf_final == LV_COLOR_FORMAT_RGB565A8) {
             uint32_t buf_stride = blend_w * 3;
-            buf_h = MAX_BUF_SIZE / buf_stride;
+            buf_h = MAX_BUF_SIZE(draw_unit->target_layer) / buf_stride;
             if(buf_h > blend_h) buf_h = blend_h;
             tmp_buf = lv_malloc(buf_stride * buf_h);
         }
         else {
             uint32_t buf_stride = blend_w * lv_color_format_get_size(cf_final);
-            buf_h = MAX_BUF_SIZE / buf_stride;
+            buf_h = MAX_BUF_SIZE(draw_unit->target_layer) / buf_stride;
             if(buf_h > blend_h) buf_h = blend_h;
             tmp_buf = lv_malloc(buf_stride * buf_h);
         }
@@ -339,8 +339,8 @@ static void LV_ATTRIBUTE_FAST_MEM draw_line_skew(lv_draw_unit_t * draw_unit, con
 
     /*Draw the background line by line*/
     int32_t h;
-    uint32_t hor_res = (uint32_t)lv_display_get_horizontal_resolution(_lv_refr_get_disp_refreshing());
-    size_t mask_buf_size = LV_MIN(lv_area_get_size(&blend_area), hor_res);
+    uint32_t layer_w = (uint32_t)lv_area_get_width(&draw_unit->target_layer->buf_area);
+    size_t mask_buf_size = LV_MIN(lv_area_get_size(&blend_area), layer_w);
     lv_opa_t * mask_buf = lv_malloc(mask_buf_size);
 
     int32_t y2 = blend_area.y2;
@@ -20,15 +20,20 @@
 /*********************
  *      DEFINES
  *********************/
-#define CIRCLE_CACHE_LIFE_MAX           1000
-#define CIRCLE_CACHE_AGING(life, r)     life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
-#define circle_cache_mutex              LV_GLOBAL_DEFAULT()->draw_info.circle_cache_mutex
-#define _circle_cache                   LV_GLOBAL_DEFAULT()->sw_circle_cache
+#define corner_cache_p                  LV_GLOBAL_DEFAULT()->sw_corner_cache
+
+/*Size of `cir_opa`, `opa_start_on_y` and `x_start_on_y` together. Use uint16_t for the latter two.*/
+#define CIRCLE_BUF_SIZE(radius)         ((radius) * 6 + 6)
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    lv_cache_slot_size_t slot;
+    _lv_draw_sw_mask_radius_circle_dsc_t circle;    /**< The key is `circle.radius`*/
+} corner_cache_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -64,6 +69,10 @@ static void circ_calc_aa4(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radi
 static lv_opa_t * get_next_line(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t y, int32_t * len,
                                 int32_t * x_start);
 static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
+static lv_cache_entry_t * corner_cache_acquire(int32_t radius);
+static lv_cache_compare_res_t corner_cache_compare_cb(const corner_cache_data_t * lhs, const corner_cache_data_t * rhs);
+static bool corner_cache_create_cb(corner_cache_data_t * data, void * user_data);
+static void corner_cache_free_cb(corner_cache_data_t * data, void * user_data);
 
 /**********************
  *  STATIC VARIABLES
@@ -79,12 +88,39 @@ static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, l
 
 void lv_draw_sw_mask_init(void)
 {
-    lv_mutex_init(&circle_cache_mutex);
+    if(corner_cache_p != NULL) return;
+
+    corner_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    sizeof(corner_cache_data_t), LV_DRAW_SW_CORNER_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t) corner_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t) corner_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t) corner_cache_free_cb,
+    });
 }
 
 void lv_draw_sw_mask_deinit(void)
 {
-    lv_mutex_delete(&circle_cache_mutex);
+    if(corner_cache_p == NULL) return;
+
+    lv_cache_destroy(corner_cache_p, NULL);
+    corner_cache_p = NULL;
+}
+
+void lv_draw_sw_mask_corner_cache_resize(uint32_t new_size, bool evict_now)
+{
+    if(corner_cache_p == NULL) return;
+
+    lv_cache_set_max_size(corner_cache_p, new_size, NULL);
+    if(evict_now) {
+        lv_cache_reserve(corner_cache_p, new_size, NULL);
+    }
+}
+
+void lv_draw_sw_mask_corner_cache_drop_all(void)
+{
+    if(corner_cache_p == NULL) return;
+
+    lv_cache_drop_all(corner_cache_p, NULL);
 }
 
 lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[], lv_opa_t * mask_buf, int32_t abs_x,
@@ -108,32 +144,18 @@ lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[]
 
 void lv_draw_sw_mask_free_param(void * p)
 {
-    lv_mutex_lock(&circle_cache_mutex);
     _lv_draw_sw_mask_common_dsc_t * pdsc = p;
     if(pdsc->type == LV_DRAW_SW_MASK_TYPE_RADIUS) {
         lv_draw_sw_mask_radius_param_t * radius_p = (lv_draw_sw_mask_radius_param_t *) p;
-        if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
-                lv_free(radius_p->circle->cir_opa);
-                lv_free(radius_p->circle);
-            }
-            else {
-                radius_p->circle->used_cnt--;
-            }
+        if(radius_p->circle_entry) {
+            lv_cache_release(corner_cache_p, radius_p->circle_entry, NULL);
         }
-    }
-
-    lv_mutex_unlock(&circle_cache_mutex);
-}
-
-void _lv_draw_sw_mask_cleanup(void)
-{
-    uint8_t i;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].buf) {
-            lv_free(_circle_cache[i].buf);
+        else if(radius_p->circle) {
+            lv_free(radius_p->circle->buf);
+            lv_free(radius_p->circle);
         }
-        lv_memzero(&(_circle_cache[i]), sizeof(_circle_cache[i]));
+        radius_p->circle = NULL;
+        radius_p->circle_entry = NULL;
     }
 }
 
@@ -305,52 +327,103 @@ void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const l
     param->dsc.cb = (lv_draw_sw_mask_xcb_t)lv_draw_mask_radius;
     param->dsc.type = LV_DRAW_SW_MASK_TYPE_RADIUS;
 
-    if(radius == 0) {
-        param->circle = NULL;
+    param->circle = NULL;
+    param->circle_entry = NULL;
+    if(radius == 0) return;
+
+    param->circle_entry = corner_cache_acquire(radius);
+    if(param->circle_entry) {
+        corner_cache_data_t * data = lv_cache_entry_get_data(param->circle_entry);
+        param->circle = &data->circle;
         return;
     }
 
-    lv_mutex_lock(&circle_cache_mutex);
+    /*The circle is not cached (e.g. the cache is disabled or too small). Calculate it only for this mask.*/
+    param->circle = lv_malloc_zeroed(sizeof(_lv_draw_sw_mask_radius_circle_dsc_t));
+    LV_ASSERT_MALLOC(param->circle);
+    circ_calc_aa4(param->circle, radius);
+}
 
-    uint32_t i;
+lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_radius_fill_row(
+    const lv_draw_sw_mask_radius_param_t * param, lv_opa_t * mask_buf, int32_t abs_x, int32_t abs_y, int32_t len,
+    lv_opa_t opa)
+{
+    bool outer = param->cfg.outer;
+    int32_t radius = param->cfg.radius;
+    const lv_area_t * rect = &param->cfg.rect;
 
-    /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].radius == radius) {
-            _circle_cache[i].used_cnt++;
-            CIRCLE_CACHE_AGING(_circle_cache[i].life, radius);
-            param->circle = &(_circle_cache[i]);
-            lv_mutex_unlock(&circle_cache_mutex);
-            return;
-        }
+    if(abs_y < rect->y1 || abs_y > rect->y2) {
+        lv_memset(mask_buf, outer ? opa : 0, len);
+        return outer ? LV_DRAW_SW_MASK_RES_FULL_COVER : LV_DRAW_SW_MASK_RES_TRANSP;
     }
 
-    /*If not cached use the free entry with lowest life*/
-    _lv_draw_sw_mask_radius_circle_dsc_t * entry = NULL;
-    for(i = 0; i < LV_DRAW_SW_CIRCLE_CACHE_SIZE; i++) {
-        if(_circle_cache[i].used_cnt == 0) {
-            if(!entry) entry = &(_circle_cache[i]);
-            else if(_circle_cache[i].life < entry->life) entry = &(_circle_cache[i]);
-        }
+    /*The pixels in [in_start, in_end) are inside the rounded rectangle.
+     *In the corners `aa_len` pixels are anti-aliased on both sides.*/
+    int32_t in_start = rect->x1 - abs_x;
+    int32_t in_end = rect->x2 - abs_x + 1;
+    const lv_opa_t * aa_opa = NULL;
+    int32_t aa_len = 0;
+    if((abs_x < rect->x1 + radius || abs_x + len > rect->x2 - radius) &&
+       (abs_y < rect->y1 + radius || abs_y > rect->y2 - radius)) {
+        int32_t y = abs_y - rect->y1;
+        int32_t cir_y = y < radius ? radius - y - 1 : y - (lv_area_get_height(rect) - radius);
+        int32_t x_start;
+        aa_opa = get_next_line(param->circle, cir_y, &aa_len, &x_start);
+        in_start += radius - x_start;
+        in_end -= radius - x_start;
     }
 
-    /*There is no unused entry. Allocate one temporarily*/
-    if(!entry) {
-        entry = lv_malloc_zeroed(sizeof(_lv_draw_sw_mask_radius_circle_dsc_t));
-        LV_ASSERT_MALLOC(entry);
-        entry->life = -1;
+    lv_opa_t in_opa = outer ? 0 : opa;
+    lv_opa_t out_opa = outer ? opa : 0;
+    int32_t aa_start = LV_CLAMP(0, in_start - aa_len, len);
+    int32_t aa_end = LV_CLAMP(0, in_end + aa_len, len);
+    int32_t fill_start = LV_CLAMP(0, in_start, len);
+    int32_t fill_end = LV_CLAMP(0, in_end, len);
+    lv_memset(mask_buf, out_opa, aa_start);
+    lv_memset(&mask_buf[fill_start], in_opa, fill_end - fill_start);
+    lv_memset(&mask_buf[aa_end], out_opa, len - aa_end);
+
+    /*The anti-aliased pixels are mixed with `opa` as `lv_draw_sw_mask_apply()` would do*/
+    int32_t i;
+    for(i = 0; i < aa_len; i++) {
+        lv_opa_t aa = outer ? 255 - aa_opa[aa_len - 1 - i] : aa_opa[aa_len - 1 - i];
+        int32_t x_left = in_start - 1 - i;
+        int32_t x_right = in_end + i;
+        if(x_left >= 0 && x_left < len) mask_buf[x_left] = mask_mix(aa, opa);
+        if(x_right >= 0 && x_right < len) mask_buf[x_right] = mask_mix(aa, opa);
     }
-    else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
+
+    if(outer == false && aa_start == aa_end) return LV_DRAW_SW_MASK_RES_TRANSP;
+    if(aa_len == 0) {
+        if(outer == false && fill_start == 0 && fill_end == len) return LV_DRAW_SW_MASK_RES_FULL_COVER;
+        if(outer && fill_start == fill_end) return LV_DRAW_SW_MASK_RES_FULL_COVER;
     }
+    return LV_DRAW_SW_MASK_RES_CHANGED;
+}
 
-    param->circle = entry;
+void lv_draw_sw_mask_radius_get_row(const lv_draw_sw_mask_radius_param_t * param, int32_t abs_y, int32_t * x1,
+                                    int32_t * x2, int32_t * aa_len)
+{
+    int32_t radius = param->cfg.radius;
+    const lv_area_t * rect = &param->cfg.rect;
 
-    circ_calc_aa4(param->circle, radius);
-    lv_mutex_unlock(&circle_cache_mutex);
+    *aa_len = 0;
+    if(abs_y < rect->y1 || abs_y > rect->y2) {
+        *x1 = rect->x1;
+        *x2 = rect->x1 - 1;
+        return;
+    }
 
+    *x1 = rect->x1;
+    *x2 = rect->x2;
+    if(abs_y < rect->y1 + radius || abs_y > rect->y2 - radius) {
+        int32_t y = abs_y - rect->y1;
+        int32_t cir_y = y < radius ? radius - y - 1 : y - (lv_area_get_height(rect) - radius);
+        int32_t x_start;
+        get_next_line(param->circle, cir_y, aa_len, &x_start);
+        *x1 += radius - x_start;
+        *x2 -= radius - x_start;
+    }
 }
 
 void lv_draw_sw_mask_fade_init(lv_draw_sw_mask_fade_param_t * param, const lv_area_t * coords, lv_opa_t opa_top,
@@ -1075,7 +1148,7 @@ static void circ_calc_aa4(_lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t radi
     /*Allocate buffers*/
     if(c->buf) lv_free(c->buf);
 
-    c->buf = lv_malloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
+    c->buf = lv_malloc(CIRCLE_BUF_SIZE(radius));
     LV_ASSERT_MALLOC(c->buf);
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
@@ -1232,4 +1305,48 @@ static inline lv_opa_t LV_ATTRIBUTE_FAST_MEM mask_mix(lv_opa_t mask_act, lv_opa_
     return LV_UDIV255(mask_act * mask_new);
 }
 
+/**
+ * Get the circle of a radius from the corner cache and calculate it if it's not cached yet
+ * @param radius    radius of the circle
+ * @return          the acquired cache entry or NULL if the circle can't be cached
+ */
+static lv_cache_entry_t * corner_cache_acquire(int32_t radius)
+{
+    if(corner_cache_p == NULL) return NULL;
+
+    corner_cache_data_t search_key;
+    lv_memzero(&search_key, sizeof(search_key));
+    search_key.slot.size = CIRCLE_BUF_SIZE(radius);
+    search_key.circle.radius = radius;
+
+    /*Don't even try to add circles which would never fit*/
+    if(search_key.slot.size > lv_cache_get_max_size(corner_cache_p, NULL)) return NULL;
+
+    return lv_cache_acquire_or_create(corner_cache_p, &search_key, NULL);
+}
+
+static lv_cache_compare_res_t corner_cache_compare_cb(const corner_cache_data_t * lhs, const corner_cache_data_t * rhs)
+{
+    if(lhs->circle.radius != rhs->circle.radius) {
+        return lhs->circle.radius > rhs->circle.radius ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static bool corner_cache_create_cb(corner_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    circ_calc_aa4(&data->circle, data->circle.radius);
+    return data->circle.buf != NULL;
+}
+
+static void corner_cache_free_cb(corner_cache_data_t * data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_free(data->circle.buf);
+}
+
 #endif /*LV_DRAW_SW_COMPLEX*/
@@ -17,6 +17,7 @@ extern "C" {
 #include "../../misc/lv_color.h"
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_types.h"
+#include "../../misc/cache/lv_cache.h"
 
 /*********************
  *      DEFINES
@@ -133,13 +134,9 @@ typedef struct  {
     lv_opa_t * cir_opa;         /*Opacity of values on the circumference of an 1/4 circle*/
     uint16_t * x_start_on_y;        /*The x coordinate of the circle for each y value*/
     uint16_t * opa_start_on_y;      /*The index of `cir_opa` for each y value*/
-    int32_t life;               /*How many times the entry way used*/
-    uint32_t used_cnt;          /*Like a semaphore to count the referencing masks*/
     int32_t radius;          /*The radius of the entry*/
 } _lv_draw_sw_mask_radius_circle_dsc_t;
 
-typedef _lv_draw_sw_mask_radius_circle_dsc_t _lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
-
 typedef struct {
     /*The first element must be the common descriptor*/
     _lv_draw_sw_mask_common_dsc_t dsc;
@@ -152,6 +149,7 @@ typedef struct {
     } cfg;
 
     _lv_draw_sw_mask_radius_circle_dsc_t * circle;
+    lv_cache_entry_t * circle_entry;    /*The corner cache entry of `circle` or NULL if it's not cached*/
 } lv_draw_sw_mask_radius_param_t;
 
 typedef struct {
@@ -217,10 +215,17 @@ lv_draw_sw_mask_res_t /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_mask_apply(void * m
 void lv_draw_sw_mask_free_param(void * p);
 
 /**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
+ * Set the size of the corner cache which stores the anti-aliased circles of the radius masks.
+ * @param new_size      the new size in bytes. 0: disable the cache
+ * @param evict_now     true: drop the circles immediately which don't fit into the new size
  */
-void _lv_draw_sw_mask_cleanup(void);
+void lv_draw_sw_mask_corner_cache_resize(uint32_t new_size, bool evict_now);
+
+/**
+ * Drop all the circles from the corner cache.
+ * The circles used by the masks are freed when the masks are freed.
+ */
+void lv_draw_sw_mask_corner_cache_drop_all(void);
 
 /**
  *Initialize a line mask from two points.
@@ -271,6 +276,37 @@ void lv_draw_sw_mask_angle_init(lv_draw_sw_mask_angle_param_t * param, int32_t v
 void lv_draw_sw_mask_radius_init(lv_draw_sw_mask_radius_param_t * param, const lv_area_t * rect, int32_t radius,
                                  bool inv);
 
+/**
+ * Set a row of a mask buffer from a radius mask directly, without `lv_draw_sw_mask_apply()`.
+ * The result is the same as setting the row to `opa` and applying only this mask,
+ * but every pixel is written only once.
+ * @param param     pointer to an initialized radius mask
+ * @param mask_buf  the row to set. Has to be `len` byte long.
+ * @param abs_x     absolute X coordinate where the row starts
+ * @param abs_y     absolute Y coordinate of the row
+ * @param len       length of the row (in pixel count)
+ * @param opa       opacity of the covered pixels
+ * @return          `LV_DRAW_SW_MASK_RES_TRANSP` if all the pixels are 0,
+ *                  `LV_DRAW_SW_MASK_RES_FULL_COVER` if all the pixels are `opa`, else `LV_DRAW_SW_MASK_RES_CHANGED`.
+ *                  `mask_buf` is set in all cases.
+ */
+lv_draw_sw_mask_res_t /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_mask_radius_fill_row(
+    const lv_draw_sw_mask_radius_param_t * param, lv_opa_t * mask_buf, int32_t abs_x, int32_t abs_y, int32_t len,
+    lv_opa_t opa);
+
+/**
+ * Get the extent of a row of the rounded rectangle of a radius mask.
+ * The pixels in [`x1`, `x2`] are fully inside the rectangle and `aa_len` pixels are anti-aliased on both sides.
+ * The rest of the row is fully outside. It's the same for inverted masks as only the inside and outside are swapped.
+ * @param param     pointer to an initialized radius mask
+ * @param abs_y     absolute Y coordinate of the row
+ * @param x1        store the first fully covered absolute X coordinate here
+ * @param x2        store the last fully covered absolute X coordinate here. `x2 < x1` if no pixel is fully covered.
+ * @param aa_len    store the number of anti-aliased pixels on each side here
+ */
+void lv_draw_sw_mask_radius_get_row(const lv_draw_sw_mask_radius_param_t * param, int32_t abs_y, int32_t * x1,
+                                    int32_t * x2, int32_t * aa_len);
+
 /**
  * Initialize a fade mask.
  * @param param pointer to a `lv_draw_mask_param_t` to initialize
@@ -14,11 +14,36 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_color.h"
 #include "../../stdlib/lv_string.h"
+#include "../../stdlib/lv_mem.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON
+    #include "blend/neon/lv_blend_neon.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+    #include "blend/helium/lv_blend_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_SSE2
+    #include "blend/sse2/lv_blend_sse2.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_AVX2
+    #include "blend/avx2/lv_blend_avx2.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+    #include "blend/x86/lv_blend_x86.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
+    #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
+#endif
 
 /*********************
  *      DEFINES
  *********************/
 
+/*The hooks get pixels whose neighbors are all in the image and
+ *return the first pixel they haven't processed. The rest is processed in C.*/
+#ifndef LV_DRAW_SW_TRANSFORM_ARGB8888
+    #define LV_DRAW_SW_TRANSFORM_ARGB8888(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_buf)  (x_start)
+#endif
+
+#ifndef LV_DRAW_SW_TRANSFORM_RGB565A8
+    #define LV_DRAW_SW_TRANSFORM_RGB565A8(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, cbuf, abuf)  (x_start)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -37,6 +62,23 @@ typedef struct {
     lv_point_t pivot;
 } point_transform_dsc_t;
 
+/*The source column and the horizontal neighbor of a destination column if only scaling is applied*/
+typedef struct {
+    int32_t x_int;      /*Source column or -1 if out of the image*/
+    int32_t x_next;     /*-1 or 1: direction of the horizontal neighbor*/
+    int32_t fract;      /*Weight of the neighbor in 0x00..0x7F range*/
+    bool edge;          /*The neighbor is out of the image*/
+} scale_col_t;
+
+/*The source row and the vertical neighbor of a destination row if only scaling is applied*/
+typedef struct {
+    const uint8_t * src_row;    /*Start of the source row or NULL if out of the image*/
+    int32_t y_int;
+    int32_t y_next;             /*-1 or 1: direction of the vertical neighbor*/
+    int32_t fract;              /*Weight of the neighbor in 0x00..0x7F range*/
+    bool edge;                  /*The neighbor is out of the image*/
+} scale_row_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -55,18 +97,54 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                              int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
 
+static void transform_argb8888_row(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                   int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                   int32_t x_end, uint8_t * dest_buf, bool aa);
+
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa);
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa);
+
+static void transform_argb8888_interior(const uint8_t * src, int32_t src_stride,
+                                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                        int32_t x_start, int32_t x_end, uint8_t * dest_buf);
+
+static void transform_rgb565a8_row(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                   int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                   int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
 
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
+
+static void transform_rgb565a8_interior(const uint8_t * src, int32_t src_stride, const lv_opa_t * src_alpha,
+                                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                        int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf);
+
+static bool get_interior_span(int32_t src_w, int32_t src_h, int32_t xs_ups, int32_t ys_ups,
+                              int32_t xs_step, int32_t ys_step, int32_t x_end, int32_t * span_start, int32_t * span_end);
 
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                          int32_t x_end, uint8_t * abuf, bool aa);
 
+static void scale_init_cols(scale_col_t * cols, int32_t src_w, int32_t xs_ups, int32_t xs_step, int32_t x_end);
+
+static void scale_init_row(scale_row_t * row, const uint8_t * src, int32_t src_h, int32_t src_stride, int32_t ys_ups);
+
+static void scale_rgb888(const scale_row_t * row, const scale_col_t * cols, int32_t src_stride,
+                         int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
+
+static void scale_argb8888(const scale_row_t * row, const scale_col_t * cols, int32_t src_stride,
+                           int32_t x_end, uint8_t * dest_buf, bool aa);
+
+static void scale_rgb565a8(const scale_row_t * row, const scale_col_t * cols, const uint8_t * src,
+                           int32_t src_h, int32_t src_stride, int32_t x_end, uint16_t * cbuf, uint8_t * abuf,
+                           bool src_has_a8, bool aa);
+
+static void scale_a8(const scale_row_t * row, const scale_col_t * cols, int32_t src_stride,
+                     int32_t x_end, uint8_t * abuf, bool aa);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -179,6 +257,51 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
         ys_ups_start = ys1_ups + 0x80;
     }
 
+    /*If scaled only the source column of a destination column is the same in every row.
+     *So find the columns and their neighbors only once and process the image row by row*/
+    scale_col_t * cols = NULL;
+    if(is_rotated == false) {
+        cols = lv_malloc(dest_w * sizeof(scale_col_t));
+        if(cols) scale_init_cols(cols, src_w, xs_ups, xs_step_256, dest_w);
+    }
+
+    if(cols) {
+        int32_t y;
+        for(y = 0; y < dest_h; y++) {
+            scale_row_t row;
+            scale_init_row(&row, src_buf, src_h, src_stride, ys_ups_start + ((ys_step_256_original * y) >> 8));
+
+            switch(src_cf) {
+                case LV_COLOR_FORMAT_XRGB8888:
+                    scale_rgb888(&row, cols, src_stride, dest_w, dest_buf, aa, 4);
+                    break;
+                case LV_COLOR_FORMAT_RGB888:
+                    scale_rgb888(&row, cols, src_stride, dest_w, dest_buf, aa, 3);
+                    break;
+                case LV_COLOR_FORMAT_A8:
+                    scale_a8(&row, cols, src_stride, dest_w, dest_buf, aa);
+                    break;
+                case LV_COLOR_FORMAT_ARGB8888:
+                    scale_argb8888(&row, cols, src_stride, dest_w, dest_buf, aa);
+                    break;
+                case LV_COLOR_FORMAT_RGB565:
+                    scale_rgb565a8(&row, cols, src_buf, src_h, src_stride, dest_w, dest_buf, alpha_buf, false, aa);
+                    break;
+                case LV_COLOR_FORMAT_RGB565A8:
+                    scale_rgb565a8(&row, cols, src_buf, src_h, src_stride, dest_w, dest_buf, alpha_buf, true, aa);
+                    break;
+                default:
+                    break;
+            }
+
+            dest_buf = (uint8_t *)dest_buf + dest_stride;
+            if(alpha_buf) alpha_buf += dest_stride_a8;
+        }
+
+        lv_free(cols);
+        return;
+    }
+
     int32_t y;
     for(y = 0; y < dest_h; y++) {
         if(is_rotated == false) {
@@ -216,17 +339,16 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
                 transform_a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa);
                 break;
             case LV_COLOR_FORMAT_ARGB8888:
-                transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   aa);
+                transform_argb8888_row(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
+                                       dest_buf, aa);
                 break;
             case LV_COLOR_FORMAT_RGB565:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   alpha_buf, false, aa);
+                transform_rgb565a8_row(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
+                                       dest_buf, alpha_buf, false, aa);
                 break;
             case LV_COLOR_FORMAT_RGB565A8:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
-                                   (uint16_t *)dest_buf,
-                                   alpha_buf, true, aa);
+                transform_rgb565a8_row(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
+                                       (uint16_t *)dest_buf, alpha_buf, true, aa);
                 break;
             default:
                 break;
@@ -337,16 +459,34 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
     }
 }
 
+static void transform_argb8888_row(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                   int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                   int32_t x_end, uint8_t * dest_buf, bool aa)
+{
+    int32_t span_start;
+    int32_t span_end;
+    if(!aa || !get_interior_span(src_w, src_h, xs_ups, ys_ups, xs_step, ys_step, x_end, &span_start, &span_end)) {
+        transform_argb8888(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, 0, x_end, dest_buf, aa);
+        return;
+    }
+
+    transform_argb8888(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, 0, span_start, dest_buf, aa);
+    int32_t x = LV_DRAW_SW_TRANSFORM_ARGB8888(src, src_stride, xs_ups, ys_ups, xs_step, ys_step,
+                                              span_start, span_end, (uint32_t *)dest_buf);
+    transform_argb8888_interior(src, src_stride, xs_ups, ys_ups, xs_step, ys_step, x, span_end, dest_buf);
+    transform_argb8888(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, span_end, x_end, dest_buf, aa);
+}
+
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa)
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -426,9 +566,93 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
     }
 }
 
+/**
+ * The same as `transform_argb8888` with anti-aliasing but all the pixels and their neighbors must be in the image
+ */
+static void transform_argb8888_interior(const uint8_t * src, int32_t src_stride,
+                                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                        int32_t x_start, int32_t x_end, uint8_t * dest_buf)
+{
+    lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs = xs_ups + ((xs_step * x) >> 8);
+        int32_t ys = ys_ups + ((ys_step * x) >> 8);
+        int32_t xs_fract = xs & 0xFF;
+        int32_t ys_fract = ys & 0xFF;
+
+        int32_t x_next;
+        int32_t y_next;
+        if(xs_fract < 0x80) {
+            x_next = -1;
+            xs_fract = 0x7F - xs_fract;
+        }
+        else {
+            x_next = 1;
+            xs_fract = xs_fract - 0x80;
+        }
+        if(ys_fract < 0x80) {
+            y_next = -1;
+            ys_fract = 0x7F - ys_fract;
+        }
+        else {
+            y_next = 1;
+            ys_fract = ys_fract - 0x80;
+        }
+
+        const lv_color32_t * src_c32 = (const lv_color32_t *)(src + (ys >> 8) * src_stride + (xs >> 8) * 4);
+        lv_color32_t c32 = src_c32[0];
+        lv_color32_t px_hor = src_c32[x_next];
+        lv_color32_t px_ver = *(const lv_color32_t *)((uint8_t *)src_c32 + y_next * src_stride);
+
+        if(px_ver.alpha == 0) {
+            c32.alpha = (c32.alpha * (0xFF - ys_fract)) >> 8;
+        }
+        else if(!lv_color32_eq(c32, px_ver)) {
+            c32.alpha = ((px_ver.alpha * ys_fract) + (c32.alpha * (0xFF - ys_fract))) >> 8;
+            px_ver.alpha = ys_fract;
+            c32 = lv_color_mix32(px_ver, c32);
+        }
+
+        if(px_hor.alpha == 0) {
+            c32.alpha = (c32.alpha * (0xFF - xs_fract)) >> 8;
+        }
+        else if(!lv_color32_eq(c32, px_hor)) {
+            c32.alpha = ((px_hor.alpha * xs_fract) + (c32.alpha * (0xFF - xs_fract))) >> 8;
+            px_hor.alpha = xs_fract;
+            c32 = lv_color_mix32(px_hor, c32);
+        }
+
+        dest_c32[x] = c32;
+    }
+}
+
+static void transform_rgb565a8_row(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                   int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                   int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
+{
+    int32_t span_start;
+    int32_t span_end;
+    if(!aa || !get_interior_span(src_w, src_h, xs_ups, ys_ups, xs_step, ys_step, x_end, &span_start, &span_end)) {
+        transform_rgb565a8(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, 0, x_end, cbuf, abuf,
+                           src_has_a8, aa);
+        return;
+    }
+
+    const lv_opa_t * src_alpha = src_has_a8 ? src + src_stride * src_h : NULL;
+    transform_rgb565a8(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, 0, span_start, cbuf, abuf,
+                       src_has_a8, aa);
+    int32_t x = LV_DRAW_SW_TRANSFORM_RGB565A8(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step,
+                                              span_start, span_end, cbuf, abuf);
+    transform_rgb565a8_interior(src, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step, x, span_end, cbuf, abuf);
+    transform_rgb565a8(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, span_end, x_end, cbuf, abuf,
+                       src_has_a8, aa);
+}
+
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
@@ -439,7 +663,7 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
     int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -537,6 +761,75 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
     }
 }
 
+/**
+ * The same as `transform_rgb565a8` with anti-aliasing but all the pixels and their neighbors must be in the image
+ * @param src_alpha     the alpha map of the source or NULL if it has no alpha
+ */
+static void transform_rgb565a8_interior(const uint8_t * src, int32_t src_stride, const lv_opa_t * src_alpha,
+                                        int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                        int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf)
+{
+    /*Must be signed type, because we would use negative array index calculated from stride*/
+    int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
+
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs = xs_ups + ((xs_step * x) >> 8);
+        int32_t ys = ys_ups + ((ys_step * x) >> 8);
+        int32_t xs_int = xs >> 8;
+        int32_t ys_int = ys >> 8;
+        int32_t xs_fract = xs & 0xFF;
+        int32_t ys_fract = ys & 0xFF;
+
+        int32_t x_next;
+        int32_t y_next;
+        if(xs_fract < 0x80) {
+            x_next = -1;
+            xs_fract = (0x7F - xs_fract) * 2;
+        }
+        else {
+            x_next = 1;
+            xs_fract = (xs_fract - 0x80) * 2;
+        }
+        if(ys_fract < 0x80) {
+            y_next = -1;
+            ys_fract = (0x7F - ys_fract) * 2;
+        }
+        else {
+            y_next = 1;
+            ys_fract = (ys_fract - 0x80) * 2;
+        }
+
+        const uint16_t * src_tmp_u16 = (const uint16_t *)(src + (ys_int * src_stride) + xs_int * 2);
+        cbuf[x] = src_tmp_u16[0];
+        uint16_t px_hor = src_tmp_u16[x_next];
+        uint16_t px_ver = *(const uint16_t *)((uint8_t *)src_tmp_u16 + (y_next * src_stride));
+
+        if(src_alpha) {
+            const lv_opa_t * src_alpha_tmp = src_alpha + (ys_int * alpha_stride) + xs_int;
+            abuf[x] = src_alpha_tmp[0];
+
+            lv_opa_t a_hor = src_alpha_tmp[x_next];
+            lv_opa_t a_ver = src_alpha_tmp[y_next * alpha_stride];
+
+            if(a_ver != abuf[x]) a_ver = ((a_ver * ys_fract) + (abuf[x] * (0x100 - ys_fract))) >> 8;
+            if(a_hor != abuf[x]) a_hor = ((a_hor * xs_fract) + (abuf[x] * (0x100 - xs_fract))) >> 8;
+            abuf[x] = (a_ver + a_hor) >> 1;
+
+            if(abuf[x] == 0x00) continue;
+        }
+        else {
+            abuf[x] = 0xff;
+        }
+
+        if(cbuf[x] != px_ver || cbuf[x] != px_hor) {
+            uint16_t v = lv_color_16_16_mix(px_ver, cbuf[x], ys_fract);
+            uint16_t h = lv_color_16_16_mix(px_hor, cbuf[x], xs_fract);
+            cbuf[x] = lv_color_16_16_mix(h, v, LV_OPA_50);
+        }
+    }
+}
+
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
                          int32_t x_end, uint8_t * abuf, bool aa)
@@ -611,6 +904,359 @@ static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int3
     }
 }
 
+/**
+ * Find the pixels of a row which are in the image with all their neighbors.
+ * The source coordinates change monotonically along the row so these pixels are next to each other.
+ * @param src_w         width of the source image
+ * @param src_h         height of the source image
+ * @param xs_ups        upscaled source X coordinate of the first pixel
+ * @param ys_ups        upscaled source Y coordinate of the first pixel
+ * @param xs_step       upscaled X step in the source image between the pixels
+ * @param ys_step       upscaled Y step in the source image between the pixels
+ * @param x_end         number of pixels in the row
+ * @param span_start    store the first pixel of the span here
+ * @param span_end      store the pixel after the span here
+ * @return              true: there is such a span; false: all the pixels are close to the edges or out of the image
+ */
+static bool get_interior_span(int32_t src_w, int32_t src_h, int32_t xs_ups, int32_t ys_ups,
+                              int32_t xs_step, int32_t ys_step, int32_t x_end, int32_t * span_start, int32_t * span_end)
+{
+    int32_t x;
+    for(x = 0; x < x_end; x++) {
+        int32_t xs_int = (xs_ups + ((xs_step * x) >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + ((ys_step * x) >> 8)) >> 8;
+        if(xs_int >= 1 && xs_int <= src_w - 2 && ys_int >= 1 && ys_int <= src_h - 2) break;
+    }
+    if(x == x_end) return false;
+    *span_start = x;
+
+    for(x = x_end - 1; x > *span_start; x--) {
+        int32_t xs_int = (xs_ups + ((xs_step * x) >> 8)) >> 8;
+        int32_t ys_int = (ys_ups + ((ys_step * x) >> 8)) >> 8;
+        if(xs_int >= 1 && xs_int <= src_w - 2 && ys_int >= 1 && ys_int <= src_h - 2) break;
+    }
+    *span_end = x + 1;
+    return true;
+}
+
+/**
+ * Find the source column and the horizontal neighbor of each destination column.
+ * The same as the per pixel calculation of `transform_...` functions with `ys_step == 0`
+ * @param cols      store the result here (`x_end` elements)
+ * @param src_w     width of the source image
+ * @param xs_ups    upscaled source X coordinate of the first destination column
+ * @param xs_step   upscaled step in the source image between destination columns
+ * @param x_end     number of destination columns
+ */
+static void scale_init_cols(scale_col_t * cols, int32_t src_w, int32_t xs_ups, int32_t xs_step, int32_t x_end)
+{
+    int32_t x;
+    for(x = 0; x < x_end; x++) {
+        int32_t xs = xs_ups + ((xs_step * x) >> 8);
+        int32_t xs_int = xs >> 8;
+        if(xs_int < 0 || xs_int >= src_w) {
+            cols[x].x_int = -1;
+            continue;
+        }
+
+        int32_t xs_fract = xs & 0xFF;
+        cols[x].x_int = xs_int;
+        if(xs_fract < 0x80) {
+            cols[x].x_next = -1;
+            cols[x].fract = 0x7F - xs_fract;
+            cols[x].edge = xs_int == 0;
+        }
+        else {
+            cols[x].x_next = 1;
+            cols[x].fract = xs_fract - 0x80;
+            cols[x].edge = xs_int == src_w - 1;
+        }
+    }
+}
+
+/**
+ * Find the source row and the vertical neighbor of a destination row.
+ * @param row           store the result here
+ * @param src           the source image
+ * @param src_h         height of the source image
+ * @param src_stride    stride of the source image
+ * @param ys_ups        upscaled source Y coordinate of the destination row
+ */
+static void scale_init_row(scale_row_t * row, const uint8_t * src, int32_t src_h, int32_t src_stride, int32_t ys_ups)
+{
+    int32_t ys_int = ys_ups >> 8;
+    if(ys_int < 0 || ys_int >= src_h) {
+        row->src_row = NULL;
+        return;
+    }
+
+    int32_t ys_fract = ys_ups & 0xFF;
+    row->src_row = src + ys_int * src_stride;
+    row->y_int = ys_int;
+    if(ys_fract < 0x80) {
+        row->y_next = -1;
+        row->fract = 0x7F - ys_fract;
+        row->edge = ys_int == 0;
+    }
+    else {
+        row->y_next = 1;
+        row->fract = ys_fract - 0x80;
+        row->edge = ys_int == src_h - 1;
+    }
+}
+
+/*The `scale_...` functions give the same result as their `transform_...` pair but
+ *the vertical mix of a source column is calculated only once if it's used by more columns*/
+
+static void scale_rgb888(const scale_row_t * row, const scale_col_t * cols, int32_t src_stride,
+                         int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
+{
+    lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
+
+    int32_t x;
+    if(row->src_row == NULL) {
+        for(x = 0; x < x_end; x++) dest_c32[x].alpha = 0x00;
+        return;
+    }
+
+    int32_t ys_fract = row->fract;
+    bool mix = aa && !row->edge;
+    int32_t last_x_int = -1;
+    lv_color32_t last_c32 = {0};
+    for(x = 0; x < x_end; x++) {
+        const scale_col_t * col = &cols[x];
+        if(col->x_int < 0) {
+            dest_c32[x].alpha = 0x00;
+            continue;
+        }
+
+        const uint8_t * src_u8 = row->src_row + col->x_int * px_size;
+        if(mix && !col->edge) {
+            if(col->x_int != last_x_int) {
+                last_c32.red = src_u8[2];
+                last_c32.green = src_u8[1];
+                last_c32.blue = src_u8[0];
+                last_c32.alpha = 0xff;
+
+                const uint8_t * px_ver_u8 = src_u8 + (int32_t)(row->y_next * src_stride);
+                lv_color32_t px_ver;
+                px_ver.red = px_ver_u8[2];
+                px_ver.green = px_ver_u8[1];
+                px_ver.blue = px_ver_u8[0];
+                px_ver.alpha = 0xff;
+
+                if(!lv_color32_eq(last_c32, px_ver)) {
+                    px_ver.alpha = ys_fract;
+                    last_c32 = lv_color_mix32(px_ver, last_c32);
+                }
+                last_x_int = col->x_int;
+            }
+
+            dest_c32[x] = last_c32;
+
+            const uint8_t * px_hor_u8 = src_u8 + (int32_t)(col->x_next * px_size);
+            lv_color32_t px_hor;
+            px_hor.red = px_hor_u8[2];
+            px_hor.green = px_hor_u8[1];
+            px_hor.blue = px_hor_u8[0];
+            px_hor.alpha = 0xff;
+
+            if(!lv_color32_eq(dest_c32[x], px_hor)) {
+                px_hor.alpha = col->fract;
+                dest_c32[x] = lv_color_mix32(px_hor, dest_c32[x]);
+            }
+        }
+        else {
+            dest_c32[x].red = src_u8[2];
+            dest_c32[x].green = src_u8[1];
+            dest_c32[x].blue = src_u8[0];
+            dest_c32[x].alpha = 0xff;
+
+            /*Partially out of the image*/
+            if(col->edge) dest_c32[x].alpha = (0xff * (0xFF - col->fract)) >> 8;
+            else if(row->edge) dest_c32[x].alpha = (0xff * (0xFF - ys_fract)) >> 8;
+        }
+    }
+}
+
+static void scale_argb8888(const scale_row_t * row, const scale_col_t * cols, int32_t src_stride,
+                           int32_t x_end, uint8_t * dest_buf, bool aa)
+{
+    lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
+
+    if(row->src_row == NULL) {
+        lv_memzero(dest_buf, x_end * sizeof(lv_color32_t));
+        return;
+    }
+
+    const lv_color32_t * src_row_c32 = (const lv_color32_t *)row->src_row;
+    int32_t ys_fract = row->fract;
+    bool mix = aa && !row->edge;
+    int32_t last_x_int = -1;
+    lv_color32_t last_c32 = {0};
+    int32_t x;
+    for(x = 0; x < x_end; x++) {
+        const scale_col_t * col = &cols[x];
+        if(col->x_int < 0) {
+            ((uint32_t *)dest_buf)[x] = 0x00000000;
+            continue;
+        }
+
+        const lv_color32_t * src_c32 = &src_row_c32[col->x_int];
+        if(mix && !col->edge) {
+            if(col->x_int != last_x_int) {
+                last_c32 = src_c32[0];
+                lv_color32_t px_ver = *(const lv_color32_t *)((uint8_t *)src_c32 + row->y_next * src_stride);
+                if(px_ver.alpha == 0) {
+                    last_c32.alpha = (last_c32.alpha * (0xFF - ys_fract)) >> 8;
+                }
+                else if(!lv_color32_eq(last_c32, px_ver)) {
+                    last_c32.alpha = ((px_ver.alpha * ys_fract) + (last_c32.alpha * (0xFF - ys_fract))) >> 8;
+                    px_ver.alpha = ys_fract;
+                    last_c32 = lv_color_mix32(px_ver, last_c32);
+                }
+                last_x_int = col->x_int;
+            }
+
+            lv_color32_t c32 = last_c32;
+            lv_color32_t px_hor = src_c32[col->x_next];
+            int32_t xs_fract = col->fract;
+            if(px_hor.alpha == 0) {
+                c32.alpha = (c32.alpha * (0xFF - xs_fract)) >> 8;
+            }
+            else if(!lv_color32_eq(c32, px_hor)) {
+                c32.alpha = ((px_hor.alpha * xs_fract) + (c32.alpha * (0xFF - xs_fract))) >> 8;
+                px_hor.alpha = xs_fract;
+                c32 = lv_color_mix32(px_hor, c32);
+            }
+            dest_c32[x] = c32;
+        }
+        else {
+            dest_c32[x] = src_c32[0];
+
+            /*Partially out of the image*/
+            if(col->edge) dest_c32[x].alpha = (dest_c32[x].alpha * (0x7F - col->fract)) >> 7;
+            else if(row->edge) dest_c32[x].alpha = (dest_c32[x].alpha * (0x7F - ys_fract)) >> 7;
+        }
+    }
+}
+
+static void scale_rgb565a8(const scale_row_t * row, const scale_col_t * cols, const uint8_t * src,
+                           int32_t src_h, int32_t src_stride, int32_t x_end, uint16_t * cbuf, uint8_t * abuf,
+                           bool src_has_a8, bool aa)
+{
+    if(row->src_row == NULL) {
+        lv_memzero(abuf, x_end);
+        return;
+    }
+
+    /*Must be signed type, because we would use negative array index calculated from stride*/
+    int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
+    const lv_opa_t * src_alpha_row = src + src_stride * src_h + row->y_int * alpha_stride;
+
+    const uint16_t * src_row_u16 = (const uint16_t *)row->src_row;
+    int32_t ys_fract = row->fract * 2;
+    bool mix = aa && !row->edge;
+    int32_t last_v_x_int = -1;
+    int32_t last_a_x_int = -1;
+    uint16_t last_v = 0;
+    lv_opa_t last_a_ver = 0;
+    int32_t x;
+    for(x = 0; x < x_end; x++) {
+        const scale_col_t * col = &cols[x];
+        if(col->x_int < 0) {
+            abuf[x] = 0x00;
+            continue;
+        }
+
+        const uint16_t * src_tmp_u16 = &src_row_u16[col->x_int];
+        cbuf[x] = src_tmp_u16[0];
+        int32_t xs_fract = col->fract * 2;
+
+        if(mix && !col->edge) {
+            uint16_t px_ver = *(const uint16_t *)((uint8_t *)src_tmp_u16 + (row->y_next * src_stride));
+            uint16_t px_hor = src_tmp_u16[col->x_next];
+
+            if(src_has_a8) {
+                const lv_opa_t * src_alpha_tmp = &src_alpha_row[col->x_int];
+                lv_opa_t a = src_alpha_tmp[0];
+                if(col->x_int != last_a_x_int) {
+                    last_a_ver = src_alpha_tmp[row->y_next * alpha_stride];
+                    if(last_a_ver != a) last_a_ver = ((last_a_ver * ys_fract) + (a * (0x100 - ys_fract))) >> 8;
+                    last_a_x_int = col->x_int;
+                }
+
+                lv_opa_t a_hor = src_alpha_tmp[col->x_next];
+                if(a_hor != a) a_hor = ((a_hor * xs_fract) + (a * (0x100 - xs_fract))) >> 8;
+                abuf[x] = (last_a_ver + a_hor) >> 1;
+
+                if(abuf[x] == 0x00) continue;
+            }
+            else {
+                abuf[x] = 0xff;
+            }
+
+            if(cbuf[x] != px_ver || cbuf[x] != px_hor) {
+                if(col->x_int != last_v_x_int) {
+                    last_v = lv_color_16_16_mix(px_ver, cbuf[x], ys_fract);
+                    last_v_x_int = col->x_int;
+                }
+                uint16_t h = lv_color_16_16_mix(px_hor, cbuf[x], xs_fract);
+                cbuf[x] = lv_color_16_16_mix(h, last_v, LV_OPA_50);
+            }
+        }
+        /*Partially out of the image*/
+        else {
+            lv_opa_t a = src_has_a8 ? src_alpha_row[col->x_int] : 0xff;
+
+            if(col->edge) abuf[x] = (a * (0xFF - xs_fract)) >> 8;
+            else if(row->edge) abuf[x] = (a * (0xFF - ys_fract)) >> 8;
+            else abuf[x] = a;
+        }
+    }
+}
+
+static void scale_a8(const scale_row_t * row, const scale_col_t * cols, int32_t src_stride,
+                     int32_t x_end, uint8_t * abuf, bool aa)
+{
+    if(row->src_row == NULL) {
+        lv_memzero(abuf, x_end);
+        return;
+    }
+
+    int32_t ys_fract = row->fract * 2;
+    bool mix = aa && !row->edge;
+    int32_t x;
+    for(x = 0; x < x_end; x++) {
+        const scale_col_t * col = &cols[x];
+        if(col->x_int < 0) {
+            abuf[x] = 0x00;
+            continue;
+        }
+
+        const uint8_t * src_tmp = &row->src_row[col->x_int];
+        int32_t xs_fract = col->fract * 2;
+        abuf[x] = src_tmp[0];
+
+        /*The same as in `transform_a8`: the horizontal neighbor is mixed with the vertical fraction*/
+        if(mix && !col->edge) {
+            lv_opa_t a_ver = src_tmp[col->x_next];
+            lv_opa_t a_hor = src_tmp[row->y_next * src_stride];
+
+            if(a_ver != abuf[x]) a_ver = ((a_ver * ys_fract) + (abuf[x] * (0x100 - ys_fract))) >> 8;
+            if(a_hor != abuf[x]) a_hor = ((a_hor * xs_fract) + (abuf[x] * (0x100 - xs_fract))) >> 8;
+            abuf[x] = (a_ver + a_hor) >> 1;
+        }
+        /*Partially out of the image*/
+        else if(col->edge) {
+            abuf[x] = (src_tmp[0] * (0xFF - xs_fract)) >> 8;
+        }
+        else if(row->edge) {
+            abuf[x] = (src_tmp[0] * (0xFF - ys_fract)) >> 8;
+        }
+    }
+}
+
 static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
                                      int32_t * yout)
 {
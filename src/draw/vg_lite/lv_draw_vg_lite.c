@@ -183,14 +183,14 @@ static int32_t draw_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
         return -1;
     }
 
-    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    lv_draw_task_set_state(t, LV_DRAW_TASK_STATE_IN_PROGRESS);
     u->base_unit.target_layer = layer;
     u->base_unit.clip_area = &t->clip_area;
     u->task_act = t;
 
     draw_execute(u);
 
-    u->task_act->state = LV_DRAW_TASK_STATE_READY;
+    lv_draw_task_set_state(u->task_act, LV_DRAW_TASK_STATE_READY);
     u->task_act = NULL;
 
     /*The draw unit is free now. Request a new dispatching as it can get a new task*/
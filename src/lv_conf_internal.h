@@ -26,6 +26,9 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_SSE2         3
+#define LV_DRAW_SW_ASM_AVX2         4
+#define LV_DRAW_SW_ASM_X86          5
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
 /* Handle special Kconfig options */
@@ -226,6 +229,16 @@
     #endif
 #endif
 
+/*Default max. size of a strip rendered at once in LV_DISPLAY_RENDER_MODE_PARTIAL.
+ *Around the size of the L2 cache keeps the rendered strip in the cache. 0: fill the whole draw buffer*/
+#ifndef LV_DEF_STRIP_SIZE
+    #ifdef CONFIG_LV_DEF_STRIP_SIZE
+        #define LV_DEF_STRIP_SIZE CONFIG_LV_DEF_STRIP_SIZE
+    #else
+        #define LV_DEF_STRIP_SIZE   (256 * 1024)    /*[bytes]*/
+    #endif
+#endif
+
 /*Default Dot Per Inch. Used to initialize default sizes such as widgets sized, style paddings.
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #ifndef LV_DPI_DEF
@@ -305,6 +318,29 @@
     #endif
 #endif
 
+/*Keep the rendered layers of widgets in a cache of this many bytes.
+ *While only the opacity or transformation of a widget changes (e.g. it's faded or rotated)
+ *it's not rendered again, just its cached layer is blended.
+ *The least recently used layers are dropped when the cache is full. 0: disable the cache*/
+#ifndef LV_DRAW_LAYER_CACHE_DEF_SIZE
+    #ifdef CONFIG_LV_DRAW_LAYER_CACHE_DEF_SIZE
+        #define LV_DRAW_LAYER_CACHE_DEF_SIZE CONFIG_LV_DRAW_LAYER_CACHE_DEF_SIZE
+    #else
+        #define LV_DRAW_LAYER_CACHE_DEF_SIZE     0   /*[bytes]*/
+    #endif
+#endif
+
+/*Limit the memory used by all the layers, including the cached ones.
+ *If a new layer would exceed it the least recently used cached layers are dropped first
+ *and layers are not cached if they wouldn't fit. 0: no limit*/
+#ifndef LV_DRAW_LAYER_MAX_MEMORY
+    #ifdef CONFIG_LV_DRAW_LAYER_MAX_MEMORY
+        #define LV_DRAW_LAYER_MAX_MEMORY CONFIG_LV_DRAW_LAYER_MAX_MEMORY
+    #else
+        #define LV_DRAW_LAYER_MAX_MEMORY         0   /*[bytes]*/
+    #endif
+#endif
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -316,6 +352,40 @@
     #endif
 #endif
 
+/* Number of draw tasks (and the same number of draw descriptors) to allocate from a pool
+ * instead of `lv_malloc`. The pool is allocated on first use and reset when all draw tasks are finished.
+ * If more draw tasks are needed they are allocated with `lv_malloc`.
+ * 0: don't use a pool*/
+#ifndef LV_DRAW_TASK_POOL_CNT
+    #ifdef CONFIG_LV_DRAW_TASK_POOL_CNT
+        #define LV_DRAW_TASK_POOL_CNT CONFIG_LV_DRAW_TASK_POOL_CNT
+    #else
+        #define LV_DRAW_TASK_POOL_CNT    0
+    #endif
+#endif
+
+/* Number of the newest draw tasks of a layer which are kept back from the draw units,
+ * so that the later opaque tasks can still cull them. The older tasks are dispatched
+ * while the rest of the tasks are created.
+ * 0: dispatch the tasks right away and cull only the ones which weren't taken yet*/
+#ifndef LV_DRAW_CULL_WINDOW
+    #ifdef CONFIG_LV_DRAW_CULL_WINDOW
+        #define LV_DRAW_CULL_WINDOW CONFIG_LV_DRAW_CULL_WINDOW
+    #else
+        #define LV_DRAW_CULL_WINDOW    16
+    #endif
+#endif
+
+/* Allow widgets with `LV_OBJ_FLAG_RETAIN_DRAW` to keep the draw tasks of their main part
+ * and replay them in the next refreshes while the widget is unchanged.*/
+#ifndef LV_USE_DRAW_LIST
+    #ifdef CONFIG_LV_USE_DRAW_LIST
+        #define LV_USE_DRAW_LIST CONFIG_LV_USE_DRAW_LIST
+    #else
+        #define LV_USE_DRAW_LIST    0
+    #endif
+#endif
+
 #ifndef LV_USE_DRAW_SW
     #ifdef _LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_DRAW_SW
@@ -376,26 +446,27 @@
     #endif
 
     #if LV_DRAW_SW_COMPLEX == 1
-        /*Allow buffering some shadow calculation.
-        *LV_DRAW_SW_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-        *Caching has LV_DRAW_SW_SHADOW_CACHE_SIZE^2 RAM cost*/
-        #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE
-            #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
-                #define LV_DRAW_SW_SHADOW_CACHE_SIZE CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE
+        /* Size of the cache for the blurred corners of box shadows in bytes.
+        * (shadow_width + radius)^2 * 2 bytes are used per shadow shape.
+        * The least recently used shapes are dropped when the cache is full.
+        * 0: to disable caching */
+        #ifndef LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES
+            #ifdef CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES
+                #define LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES CONFIG_LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES
             #else
-                #define LV_DRAW_SW_SHADOW_CACHE_SIZE 0
+                #define LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES (8 * 1024)
             #endif
         #endif
 
-        /* Set number of maximally cached circle data.
-        * The circumference of 1/4 circle are saved for anti-aliasing
-        * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+        /* Size of the cache for the anti-aliased corners of rounded rectangles in bytes.
+        * The circumference of 1/4 circle is saved for each radius, radius * 6 bytes are used per radius.
+        * The least recently used radiuses are dropped when the cache is full.
         * 0: to disable caching */
-        #ifndef LV_DRAW_SW_CIRCLE_CACHE_SIZE
-            #ifdef CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
-                #define LV_DRAW_SW_CIRCLE_CACHE_SIZE CONFIG_LV_DRAW_SW_CIRCLE_CACHE_SIZE
+        #ifndef LV_DRAW_SW_CORNER_CACHE_SIZE
+            #ifdef CONFIG_LV_DRAW_SW_CORNER_CACHE_SIZE
+                #define LV_DRAW_SW_CORNER_CACHE_SIZE CONFIG_LV_DRAW_SW_CORNER_CACHE_SIZE
             #else
-                #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+                #define LV_DRAW_SW_CORNER_CACHE_SIZE (4 * 1024)
             #endif
         #endif
     #endif
@@ -2649,6 +2720,27 @@
     #endif
 #endif
 
+/*1: Record the type, area, draw unit, queue wait and execution time of each draw task.
+ * Print per type histograms with `lv_draw_trace_dump_stat()`
+ * or export a Chrome trace with `lv_draw_trace_dump_chrome()`*/
+#ifndef LV_USE_DRAW_TRACE
+    #ifdef CONFIG_LV_USE_DRAW_TRACE
+        #define LV_USE_DRAW_TRACE CONFIG_LV_USE_DRAW_TRACE
+    #else
+        #define LV_USE_DRAW_TRACE 0
+    #endif
+#endif
+#if LV_USE_DRAW_TRACE
+    /*Number of the last draw tasks kept for the Chrome trace*/
+    #ifndef LV_DRAW_TRACE_RECORD_CNT
+        #ifdef CONFIG_LV_DRAW_TRACE_RECORD_CNT
+            #define LV_DRAW_TRACE_RECORD_CNT CONFIG_LV_DRAW_TRACE_RECORD_CNT
+        #else
+            #define LV_DRAW_TRACE_RECORD_CNT 1024
+        #endif
+    #endif
+#endif
+
 /*1: Enable Monkey test*/
 #ifndef LV_USE_MONKEY
     #ifdef CONFIG_LV_USE_MONKEY
@@ -3316,6 +3408,14 @@ LV_EXPORT_CONST_INT(LV_DRAW_BUF_ALIGN);
     #define LV_USE_THORVG  (LV_USE_THORVG_INTERNAL || LV_USE_THORVG_EXTERNAL)
 #endif
 
+#if LV_DRAW_SW_COMPLEX && defined(LV_DRAW_SW_CIRCLE_CACHE_SIZE)
+    #warning "LV_DRAW_SW_CIRCLE_CACHE_SIZE was replaced by LV_DRAW_SW_CORNER_CACHE_SIZE which is set in bytes. Please update lv_conf.h or run menuconfig again."
+#endif
+
+#if LV_DRAW_SW_COMPLEX && defined(LV_DRAW_SW_SHADOW_CACHE_SIZE)
+    #warning "LV_DRAW_SW_SHADOW_CACHE_SIZE was replaced by LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES which is set in bytes instead of shadow size. Please update lv_conf.h or run menuconfig again."
+#endif
+
 #if LV_USE_OS
     #if (LV_USE_FREETYPE || LV_USE_THORVG) && LV_DRAW_THREAD_STACK_SIZE < (32 * 1024)
         #warning "Increase LV_DRAW_THREAD_STACK_SIZE to at least 32KB for FreeType or ThorVG."
@@ -95,11 +95,6 @@ static inline void lv_global_init(lv_global_t * global)
     global->style_last_custom_prop_id = (uint32_t)_LV_STYLE_LAST_BUILT_IN_PROP;
     global->event_last_register_id = _LV_EVENT_LAST;
     lv_rand_set_seed(0x1234ABCD);
-
-#if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
-    global->sw_shadow_cache.cache_size = -1;
-    global->sw_shadow_cache.cache_r = -1;
-#endif
 }
 
 static inline void _lv_cleanup_devices(lv_global_t * global)
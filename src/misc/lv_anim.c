@@ -39,6 +39,7 @@ static int32_t lv_anim_path_cubic_bezier(const lv_anim_t * a, int32_t x1,
 static uint32_t convert_speed_to_time(uint32_t speed, int32_t start, int32_t end);
 static void resolve_time(lv_anim_t * a);
 static bool remove_concurrent_anims(lv_anim_t * a_current);
+static uint32_t anim_get_time(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -233,6 +234,20 @@ void lv_anim_refr_now(void)
     anim_timer(NULL);
 }
 
+void lv_anim_set_frame_time(uint32_t tick)
+{
+    /*Don't let the animation time go backward*/
+    if((int32_t)(tick - anim_get_time()) <= 0) return;
+
+    state.frame_time = tick;
+    state.frame_time_set = true;
+}
+
+void lv_anim_clear_frame_time(void)
+{
+    state.frame_time_set = false;
+}
+
 int32_t lv_anim_path_linear(const lv_anim_t * a)
 {
     /*Calculate the current step*/
@@ -356,10 +371,12 @@ static void anim_timer(lv_timer_t * param)
 
         //        printf("%p, %d\n", a, a->start_value);
 
-        uint32_t elaps = lv_tick_elaps(a->last_timer_run);
-        a->act_time += elaps;
-
-        a->last_timer_run = lv_tick_get();
+        /*Never step the animation backward*/
+        uint32_t anim_time = anim_get_time();
+        if((int32_t)(anim_time - a->last_timer_run) > 0) {
+            a->act_time += anim_time - a->last_timer_run;
+            a->last_timer_run = anim_time;
+        }
 
         /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
          * happened in `anim_completed_handler` which could make this linked list reading corrupt
@@ -468,6 +485,21 @@ static void anim_completed_handler(lv_anim_t * a)
     }
 }
 
+/**
+ * Get the time for which the animations are evaluated
+ * @return  the frame time set by `lv_anim_set_frame_time()` if it's still ahead, else the current tick
+ */
+static uint32_t anim_get_time(void)
+{
+    uint32_t tick = lv_tick_get();
+    if(state.frame_time_set) {
+        if((int32_t)(state.frame_time - tick) > 0) return state.frame_time;
+        state.frame_time_set = false;
+    }
+
+    return tick;
+}
+
 static void anim_mark_list_change(void)
 {
     state.anim_list_changed = true;
@@ -88,6 +88,8 @@ typedef enum {
 typedef struct {
     bool anim_list_changed;
     bool anim_run_round;
+    bool frame_time_set;
+    uint32_t frame_time;
     lv_timer_t * timer;
     lv_ll_t anim_ll;
 } lv_anim_state_t;
@@ -544,6 +546,21 @@ uint32_t lv_anim_speed_clamped(uint32_t speed, uint32_t min_time, uint32_t max_t
  */
 void lv_anim_refr_now(void);
 
+/**
+ * Evaluate the animations for a given time instead of the current tick until `lv_tick_get()` reaches it
+ * or `lv_anim_clear_frame_time()` is called.
+ * Used while a display is refreshed to show the animations as they should look when its frame becomes visible.
+ * The animation time never goes backward so earlier times are ignored.
+ * @param tick      the time when the next frame is presented, in the same time base as `lv_tick_get()`
+ */
+void lv_anim_set_frame_time(uint32_t tick);
+
+/**
+ * Evaluate the animations for the current tick again after `lv_anim_set_frame_time()`.
+ * The animations which were already evaluated for a later time stay there until `lv_tick_get()` reaches it.
+ */
+void lv_anim_clear_frame_time(void);
+
 /**
  * Calculate the current value of an animation applying linear characteristic
  * @param a     pointer to an animation
@@ -126,6 +126,8 @@ struct _lv_draw_unit_t;
 typedef struct _lv_draw_unit_t lv_draw_unit_t;
 struct _lv_draw_task_t;
 typedef struct _lv_draw_task_t lv_draw_task_t;
+struct _lv_draw_list_t;
+typedef struct _lv_draw_list_t lv_draw_list_t;
 
 struct _lv_indev_t;
 typedef struct _lv_indev_t lv_indev_t;
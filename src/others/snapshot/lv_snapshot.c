@@ -110,21 +110,21 @@ lv_result_t lv_snapshot_take_to_draw_buf(lv_obj_t * obj, lv_color_format_t cf, l
     layer.color_format = cf;
     layer._clip_area = snapshot_area;
 
-    lv_display_t * disp_old = _lv_refr_get_disp_refreshing();
-    lv_display_t * disp_new = lv_obj_get_display(obj);
-    lv_layer_t * layer_old = disp_new->layer_head;
-    disp_new->layer_head = &layer;
+    /*The child layers (e.g. of transformed objects) get the display from the layer*/
+    lv_display_t * disp = lv_obj_get_display(obj);
+    layer.disp = disp;
+    lv_layer_t * layer_old = disp->layer_head;
+    disp->layer_head = &layer;
 
-    _lv_refr_set_disp_refreshing(disp_new);
     lv_obj_redraw(&layer, obj);
 
+    /*Dispatch the child layers too as they are in the layer list of the display*/
     while(layer.draw_task_head) {
         lv_draw_dispatch_wait_for_request();
-        lv_draw_dispatch_layer(NULL, &layer);
+        lv_draw_dispatch_display(disp);
     }
 
-    disp_new->layer_head = layer_old;
-    _lv_refr_set_disp_refreshing(disp_old);
+    disp->layer_head = layer_old;
 
     return LV_RESULT_OK;
 }
@@ -0,0 +1,322 @@
+/**
+ * @file benchmark_blend.c
+ *
+ * Measure the speed of the software blend kernels without a display.
+ * Every combination of destination and source color format, mask, opacity,
+ * blend mode and width is measured and the results are written as JSON.
+ * Use `--output` to keep the JSON separated from the logs printed to stdout.
+ *
+ * Usage: benchmark_blend [--min-time-ms <ms>] [--x86-level none|sse2|avx2] [--output <file>]
+ */
+
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "../../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.h"
+#include "../../../src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include "../../../src/draw/sw/blend/x86/lv_blend_x86.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define MAX_W           1024
+#define PX_PER_RUN      (64 * 1024)     /*Use similar sized areas for all the widths*/
+#define DEF_MIN_TIME_MS 10              /*Per sample*/
+#define SAMPLE_CNT      5
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_color_format_t cf;
+    const char * name;
+} format_t;
+
+typedef struct {
+    const format_t * dest;
+    const format_t * src;    /*NULL to fill with a color*/
+    bool mask;
+    lv_opa_t opa;
+    lv_blend_mode_t blend_mode;
+    int32_t w;
+} bench_case_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static double bench(const bench_case_t * c, uint32_t min_time_ms);
+static void blend(const bench_case_t * c, int32_t h);
+static uint64_t time_ns(void);
+static void fill_random(uint8_t * buf, uint32_t size);
+static const char * blend_mode_to_str(lv_blend_mode_t mode);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const format_t dest_formats[] = {
+    {LV_COLOR_FORMAT_RGB565, "RGB565"},
+    {LV_COLOR_FORMAT_RGB888, "RGB888"},
+    {LV_COLOR_FORMAT_XRGB8888, "XRGB8888"},
+    {LV_COLOR_FORMAT_ARGB8888, "ARGB8888"},
+};
+
+static const format_t src_formats[] = {
+    {LV_COLOR_FORMAT_RGB565, "RGB565"},
+    {LV_COLOR_FORMAT_RGB888, "RGB888"},
+    {LV_COLOR_FORMAT_XRGB8888, "XRGB8888"},
+    {LV_COLOR_FORMAT_ARGB8888, "ARGB8888"},
+};
+
+static const lv_blend_mode_t blend_modes[] = {
+    LV_BLEND_MODE_NORMAL,
+    LV_BLEND_MODE_ADDITIVE,
+    LV_BLEND_MODE_SUBTRACTIVE,
+    LV_BLEND_MODE_MULTIPLY,
+};
+
+static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_50};
+static const int32_t widths[] = {1, 7, 16, 64, 256, MAX_W};
+
+static uint8_t dest_buf[PX_PER_RUN * 4];
+static uint8_t src_buf[PX_PER_RUN * 4];
+static lv_opa_t mask_buf[PX_PER_RUN];
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    uint32_t min_time_ms = DEF_MIN_TIME_MS;
+    const char * level_name = "default";
+    const char * out_path = NULL;
+    int i;
+    for(i = 1; i < argc; i++) {
+        if(strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            min_time_ms = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "--x86-level") == 0 && i + 1 < argc) {
+            level_name = argv[++i];
+        }
+        else if(strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        }
+        else {
+            fprintf(stderr, "Usage: %s [--min-time-ms <ms>] [--x86-level none|sse2|avx2] [--output <file>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    FILE * out = out_path ? fopen(out_path, "w") : stdout;
+    if(out == NULL) {
+        fprintf(stderr, "Can't open %s\n", out_path);
+        return 1;
+    }
+
+    lv_init();
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+    if(strcmp(level_name, "none") == 0) lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_NONE);
+    else if(strcmp(level_name, "sse2") == 0) lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_SSE2);
+    else if(strcmp(level_name, "avx2") == 0) lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_AVX2);
+    static const char * level_names[] = {"none", "sse2", "avx2"};
+    level_name = level_names[lv_draw_sw_blend_x86_get_level()];
+#endif
+
+    fill_random(dest_buf, sizeof(dest_buf));
+    fill_random(src_buf, sizeof(src_buf));
+    fill_random(mask_buf, sizeof(mask_buf));
+
+    fprintf(out, "{\n  \"asm\": %d,\n  \"x86_level\": \"%s\",\n  \"min_time_ms\": %u,\n  \"samples\": %d,\n  \"results\": [",
+            LV_USE_DRAW_SW_ASM, level_name, (unsigned)min_time_ms, SAMPLE_CNT);
+
+    bool first = true;
+    uint32_t d;
+    for(d = 0; d < sizeof(dest_formats) / sizeof(dest_formats[0]); d++) {
+        /*The first "source" is the color fill*/
+        uint32_t s;
+        for(s = 0; s <= sizeof(src_formats) / sizeof(src_formats[0]); s++) {
+            const format_t * src = s == 0 ? NULL : &src_formats[s - 1];
+            uint32_t mode_cnt = src ? sizeof(blend_modes) / sizeof(blend_modes[0]) : 1;
+            uint32_t m;
+            for(m = 0; m < mode_cnt; m++) {
+                uint32_t mask;
+                for(mask = 0; mask < 2; mask++) {
+                    uint32_t o;
+                    for(o = 0; o < sizeof(opas) / sizeof(opas[0]); o++) {
+                        uint32_t wi;
+                        for(wi = 0; wi < sizeof(widths) / sizeof(widths[0]); wi++) {
+                            bench_case_t c = {
+                                .dest = &dest_formats[d],
+                                .src = src,
+                                .mask = mask,
+                                .opa = opas[o],
+                                .blend_mode = blend_modes[m],
+                                .w = widths[wi],
+                            };
+                            double mpx_per_s = bench(&c, min_time_ms);
+                            fprintf(out, "%s\n    {\"dest\": \"%s\", \"src\": \"%s\", \"mask\": %s, \"opa\": %d, "
+                                    "\"blend_mode\": \"%s\", \"w\": %d, \"mpx_per_s\": %.2f}",
+                                    first ? "" : ",", c.dest->name, src ? src->name : "COLOR",
+                                    c.mask ? "true" : "false", c.opa, blend_mode_to_str(c.blend_mode),
+                                    (int)c.w, mpx_per_s);
+                            first = false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+    if(out != stdout) fclose(out);
+
+    lv_deinit();
+    return 0;
+}
+
+/*Used by `LV_ASSERT_HANDLER` of the test configuration*/
+void lv_test_assert_fail(void)
+{
+    fprintf(stderr, "Assertion failed\n");
+    abort();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Blend areas of `PX_PER_RUN` pixels until `min_time_ms` elapses in each sample.
+ * The fastest sample is used to filter out the noise of the other processes.
+ * @return  the speed in megapixels per second
+ */
+static double bench(const bench_case_t * c, uint32_t min_time_ms)
+{
+    int32_t h = PX_PER_RUN / c->w;
+    uint64_t min_time_ns = (uint64_t)min_time_ms * 1000000;
+    double best = 0;
+
+    /*Warm up the caches*/
+    blend(c, h);
+
+    uint32_t i;
+    for(i = 0; i < SAMPLE_CNT; i++) {
+        uint64_t px_cnt = 0;
+        uint64_t t_start = time_ns();
+        uint64_t t_elapsed;
+        do {
+            blend(c, h);
+            px_cnt += (uint64_t)c->w * h;
+            t_elapsed = time_ns() - t_start;
+        } while(t_elapsed < min_time_ns);
+
+        if(t_elapsed == 0) t_elapsed = 1;
+        double mpx_per_s = (double)px_cnt * 1000.0 / (double)t_elapsed;
+        if(mpx_per_s > best) best = mpx_per_s;
+    }
+
+    return best;
+}
+
+static void blend(const bench_case_t * c, int32_t h)
+{
+    uint32_t dest_px_size = lv_color_format_get_size(c->dest->cf);
+    int32_t dest_stride = c->w * dest_px_size;
+
+    if(c->src == NULL) {
+        _lv_draw_sw_blend_fill_dsc_t dsc;
+        dsc.dest_buf = dest_buf;
+        dsc.dest_w = c->w;
+        dsc.dest_h = h;
+        dsc.dest_stride = dest_stride;
+        dsc.mask_buf = c->mask ? mask_buf : NULL;
+        dsc.mask_stride = c->w;
+        dsc.color = lv_color_hex(0x3080c0);
+        dsc.opa = c->opa;
+
+        switch(c->dest->cf) {
+            case LV_COLOR_FORMAT_RGB565:
+                lv_draw_sw_blend_color_to_rgb565(&dsc);
+                break;
+            case LV_COLOR_FORMAT_RGB888:
+            case LV_COLOR_FORMAT_XRGB8888:
+                lv_draw_sw_blend_color_to_rgb888(&dsc, dest_px_size);
+                break;
+            case LV_COLOR_FORMAT_ARGB8888:
+                lv_draw_sw_blend_color_to_argb8888(&dsc);
+                break;
+            default:
+                break;
+        }
+    }
+    else {
+        _lv_draw_sw_blend_image_dsc_t dsc;
+        dsc.dest_buf = dest_buf;
+        dsc.dest_w = c->w;
+        dsc.dest_h = h;
+        dsc.dest_stride = dest_stride;
+        dsc.mask_buf = c->mask ? mask_buf : NULL;
+        dsc.mask_stride = c->w;
+        dsc.src_buf = src_buf;
+        dsc.src_stride = c->w * lv_color_format_get_size(c->src->cf);
+        dsc.src_color_format = c->src->cf;
+        dsc.opa = c->opa;
+        dsc.blend_mode = c->blend_mode;
+
+        switch(c->dest->cf) {
+            case LV_COLOR_FORMAT_RGB565:
+                lv_draw_sw_blend_image_to_rgb565(&dsc);
+                break;
+            case LV_COLOR_FORMAT_RGB888:
+            case LV_COLOR_FORMAT_XRGB8888:
+                lv_draw_sw_blend_image_to_rgb888(&dsc, dest_px_size);
+                break;
+            case LV_COLOR_FORMAT_ARGB8888:
+                lv_draw_sw_blend_image_to_argb8888(&dsc);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static uint64_t time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void fill_random(uint8_t * buf, uint32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) buf[i] = lv_rand(0, 255);
+}
+
+static const char * blend_mode_to_str(lv_blend_mode_t mode)
+{
+    switch(mode) {
+        case LV_BLEND_MODE_NORMAL:
+            return "NORMAL";
+        case LV_BLEND_MODE_ADDITIVE:
+            return "ADDITIVE";
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            return "SUBTRACTIVE";
+        case LV_BLEND_MODE_MULTIPLY:
+            return "MULTIPLY";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+#endif
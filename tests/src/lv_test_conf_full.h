@@ -1,5 +1,8 @@
 #define LV_MEM_SIZE                     (32 * 1024 * 1024)
-#define LV_DRAW_SW_SHADOW_CACHE_SIZE    8
+#define LV_USE_DRAW_SW_ASM              LV_DRAW_SW_ASM_X86  /*Falls back to C on other architectures*/
+#define LV_DRAW_TASK_POOL_CNT           64
+#define LV_USE_DRAW_LIST                1
+#define LV_DRAW_LAYER_MAX_MEMORY        (1024 * 1024)
 #define LV_DRAW_THREAD_STACK_SIZE    (64 * 1024) /*Increase stack size to 64KB in order to run ThorVG*/
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
@@ -83,6 +86,7 @@
 #define LV_USE_VECTOR_GRAPHIC   1
 #define LV_USE_PROFILER         1
 #define LV_PROFILER_INCLUDE     "lv_profiler_builtin.h"
+#define LV_USE_DRAW_TRACE       1
 
 #define LV_BUILD_EXAMPLES       1
 #define LV_USE_DEMO_WIDGETS     1
@@ -0,0 +1,153 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * canvas;
+static lv_layer_t layer;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    LV_DRAW_BUF_DEFINE(draw_buf, 100, 100, LV_COLOR_FORMAT_NATIVE);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, &draw_buf);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    /*The tasks of a canvas layer are not dispatched until the layer is finished*/
+    lv_canvas_init_layer(canvas, &layer);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_draw_task_t * fill(int32_t x1, int32_t y1, int32_t x2, int32_t y2, lv_color_t color, lv_opa_t opa,
+                             int32_t radius)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = color;
+    dsc.bg_opa = opa;
+    dsc.radius = radius;
+
+    lv_area_t a = {x1, y1, x2, y2};
+    lv_draw_rect(&layer, &dsc, &a);
+
+    lv_draw_task_t * t = layer.draw_task_head;
+    while(t->next) t = t->next;
+    return t;
+}
+
+static void assert_px(int32_t x, int32_t y, lv_color_t color)
+{
+    lv_color32_t px = lv_canvas_get_px(canvas, x, y);
+    TEST_ASSERT_EQUAL_UINT8(color.red, px.red);
+    TEST_ASSERT_EQUAL_UINT8(color.green, px.green);
+    TEST_ASSERT_EQUAL_UINT8(color.blue, px.blue);
+}
+
+void test_draw_cull_fully_covered(void)
+{
+    lv_draw_task_t * t1 = fill(10, 10, 40, 40, lv_palette_main(LV_PALETTE_RED), LV_OPA_COVER, 10);
+    lv_draw_task_t * t2 = fill(0, 0, 50, 50, lv_palette_main(LV_PALETTE_BLUE), LV_OPA_COVER, 0);
+
+    /*The first task is culled right away as it's still in the cull window*/
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_READY, t1->state);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_WAITING, t2->state);
+
+    lv_draw_queue_layer_tasks(&layer);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_READY, t1->state);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t2->state);
+
+    lv_canvas_finish_layer(canvas, &layer);
+    assert_px(25, 25, lv_palette_main(LV_PALETTE_BLUE));
+    assert_px(60, 60, lv_color_white());
+}
+
+void test_draw_cull_partially_covered(void)
+{
+    lv_draw_task_t * t1 = fill(10, 10, 40, 40, lv_palette_main(LV_PALETTE_RED), LV_OPA_COVER, 0);
+    fill(0, 0, 50, 20, lv_palette_main(LV_PALETTE_BLUE), LV_OPA_COVER, 0);
+    lv_draw_queue_layer_tasks(&layer);
+
+    /*The top of the first task is covered so only the rest is drawn*/
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t1->state);
+    TEST_ASSERT_EQUAL_INT32(21, t1->clip_area.y1);
+
+    lv_canvas_finish_layer(canvas, &layer);
+    assert_px(25, 15, lv_palette_main(LV_PALETTE_BLUE));
+    assert_px(25, 30, lv_palette_main(LV_PALETTE_RED));
+}
+
+void test_draw_cull_not_opaque(void)
+{
+    lv_draw_task_t * t1 = fill(10, 10, 40, 40, lv_palette_main(LV_PALETTE_RED), LV_OPA_COVER, 0);
+    lv_draw_task_t * t2 = fill(0, 0, 50, 50, lv_palette_main(LV_PALETTE_BLUE), LV_OPA_50, 0);
+    lv_draw_task_t * t3 = fill(0, 0, 50, 50, lv_palette_main(LV_PALETTE_BLUE), LV_OPA_COVER, 5);
+    lv_draw_queue_layer_tasks(&layer);
+
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t1->state);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t2->state);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t3->state);
+    TEST_ASSERT_EQUAL_INT32(0, t1->clip_area.y1);
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+void test_draw_cull_window(void)
+{
+    /*The tasks pushed out of the cull window are dispatched while the later tasks are created*/
+    lv_draw_task_t * t1 = fill(10, 10, 40, 40, lv_palette_main(LV_PALETTE_RED), LV_OPA_COVER, 0);
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_CULL_WINDOW; i++) {
+        TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_WAITING, t1->state);
+        fill(60, 60, 70, 70, lv_palette_main(LV_PALETTE_GREEN), LV_OPA_50, 0);
+    }
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t1->state);
+
+    /*It's not culled anymore as a draw unit might have taken it*/
+    fill(0, 0, 50, 50, lv_palette_main(LV_PALETTE_BLUE), LV_OPA_COVER, 0);
+    TEST_ASSERT_EQUAL(LV_DRAW_TASK_STATE_QUEUED, t1->state);
+
+    lv_canvas_finish_layer(canvas, &layer);
+    assert_px(25, 25, lv_palette_main(LV_PALETTE_BLUE));
+}
+
+void test_draw_cull_display_refresh(void)
+{
+#if LV_USE_DRAW_TRACE
+    lv_canvas_finish_layer(canvas, &layer);
+
+    /*The tasks of a refreshed area are culled before the draw units can take them*/
+    lv_obj_t * obj1 = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj1);
+    lv_obj_set_style_bg_opa(obj1, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj1, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_size(obj1, 100, 100);
+    lv_obj_set_pos(obj1, 200, 200);
+
+    lv_obj_t * obj2 = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj2);
+    lv_obj_set_style_bg_opa(obj2, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj2, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_size(obj2, 100, 100);
+    lv_obj_set_pos(obj2, 200, 200);
+    lv_refr_now(NULL);
+
+    lv_draw_trace_reset();
+    lv_obj_invalidate(obj1);
+    lv_refr_now(NULL);
+
+    /*Only the screen's background and obj2 are drawn, obj1 is covered by obj2*/
+    const lv_draw_trace_stat_t * fill_stat = lv_draw_trace_get_stat(LV_DRAW_TASK_TYPE_FILL);
+    TEST_ASSERT_EQUAL_UINT32(2, fill_stat->task_cnt);
+    TEST_ASSERT_LESS_THAN_UINT32(3 * 100 * 100, fill_stat->area_px_sum);
+#else
+    TEST_IGNORE_MESSAGE("Needs LV_USE_DRAW_TRACE to count the drawn tasks");
+#endif
+}
+
+#endif
@@ -0,0 +1,114 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * canvas;
+static lv_layer_t layer;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    LV_DRAW_BUF_DEFINE(draw_buf, 100, 100, LV_COLOR_FORMAT_NATIVE);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, &draw_buf);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    /*The tasks of a canvas layer are not dispatched until the layer is finished*/
+    lv_canvas_init_layer(canvas, &layer);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static lv_draw_task_t * fill(int32_t x1, int32_t y1, int32_t x2, int32_t y2, lv_color_t color)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = color;
+    dsc.bg_opa = LV_OPA_50;
+
+    lv_area_t a = {x1, y1, x2, y2};
+    lv_draw_rect(&layer, &dsc, &a);
+
+    lv_draw_task_t * t = layer.draw_task_head;
+    while(t->next) t = t->next;
+    return t;
+}
+
+void test_draw_dependency_overlapping_tasks_wait(void)
+{
+    lv_draw_task_t * t1 = fill(0, 0, 20, 20, lv_palette_main(LV_PALETTE_RED));
+    lv_draw_task_t * t2 = fill(50, 50, 70, 70, lv_palette_main(LV_PALETTE_GREEN));
+    lv_draw_task_t * t3 = fill(10, 10, 30, 30, lv_palette_main(LV_PALETTE_BLUE));
+    uint8_t id = t1->preferred_draw_unit_id;
+
+    /*The tasks can't be taken until they are queued*/
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, NULL, id));
+    lv_draw_queue_layer_tasks(&layer);
+
+    TEST_ASSERT_EQUAL_PTR(t1, lv_draw_get_next_available_task(&layer, NULL, id));
+    TEST_ASSERT_EQUAL_PTR(t2, lv_draw_get_next_available_task(&layer, t1, id));
+    /*The third task overlaps with the first one*/
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, t2, id));
+
+    /*Taking a task doesn't make the overlapping tasks available*/
+    lv_draw_task_set_state(t1, LV_DRAW_TASK_STATE_IN_PROGRESS);
+    TEST_ASSERT_EQUAL_PTR(t2, lv_draw_get_next_available_task(&layer, NULL, id));
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, t2, id));
+
+    /*Finishing it does*/
+    lv_draw_task_set_state(t1, LV_DRAW_TASK_STATE_READY);
+    TEST_ASSERT_EQUAL_PTR(t2, lv_draw_get_next_available_task(&layer, NULL, id));
+    TEST_ASSERT_EQUAL_PTR(t3, lv_draw_get_next_available_task(&layer, t2, id));
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+void test_draw_dependency_new_task_uses_the_grid(void)
+{
+    lv_draw_task_t * t1 = fill(0, 0, 20, 20, lv_palette_main(LV_PALETTE_RED));
+    uint8_t id = t1->preferred_draw_unit_id;
+    lv_draw_queue_layer_tasks(&layer);
+    TEST_ASSERT_EQUAL_PTR(t1, lv_draw_get_next_available_task(&layer, NULL, id));
+
+    /*Tasks added after the grid was built are still checked against the older ones*/
+    lv_draw_task_t * t2 = fill(15, 15, 40, 40, lv_palette_main(LV_PALETTE_GREEN));
+    lv_draw_task_t * t3 = fill(60, 60, 90, 90, lv_palette_main(LV_PALETTE_BLUE));
+    lv_draw_queue_layer_tasks(&layer);
+    TEST_ASSERT_EQUAL_PTR(t3, lv_draw_get_next_available_task(&layer, t1, id));
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, t3, id));
+
+    lv_draw_task_set_state(t1, LV_DRAW_TASK_STATE_READY);
+    TEST_ASSERT_EQUAL_PTR(t2, lv_draw_get_next_available_task(&layer, NULL, id));
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+void test_draw_dependency_finished_task_passes_its_cells_on(void)
+{
+    lv_draw_task_t * t1 = fill(0, 0, 20, 20, lv_palette_main(LV_PALETTE_RED));
+    lv_draw_task_t * t2 = fill(10, 10, 30, 30, lv_palette_main(LV_PALETTE_GREEN));
+    lv_draw_task_t * t3 = fill(5, 5, 25, 25, lv_palette_main(LV_PALETTE_BLUE));
+    uint8_t id = t1->preferred_draw_unit_id;
+    lv_draw_queue_layer_tasks(&layer);
+    TEST_ASSERT_EQUAL_PTR(t1, lv_draw_get_next_available_task(&layer, NULL, id));
+
+    /*The grid is updated task by task, it's not built again*/
+    lv_draw_task_set_state(t1, LV_DRAW_TASK_STATE_READY);
+    TEST_ASSERT_FALSE(layer._dep_grid_invalid);
+
+    /*Only the next task on the cells of the finished task becomes available*/
+    TEST_ASSERT_EQUAL_PTR(t2, lv_draw_get_next_available_task(&layer, NULL, id));
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, t2, id));
+
+    lv_draw_task_set_state(t2, LV_DRAW_TASK_STATE_READY);
+    TEST_ASSERT_EQUAL_PTR(t3, lv_draw_get_next_available_task(&layer, NULL, id));
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+#endif
@@ -0,0 +1,234 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "../../../src/core/lv_global.h"
+
+#include "unity/unity.h"
+
+static uint32_t draw_main_cnt;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    draw_main_cnt = 0;
+    lv_draw_layer_cache_resize(1024 * 1024, false);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+    lv_draw_layer_cache_resize(0, true);
+}
+
+static void draw_main_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_main_cnt++;
+}
+
+static lv_obj_t * create_layered_obj(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 200, 100);
+    lv_obj_set_style_shadow_width(obj, 20, 0);
+    lv_obj_set_style_transform_pivot_x(obj, lv_pct(50), 0);
+    lv_obj_set_style_transform_pivot_y(obj, lv_pct(50), 0);
+    lv_obj_center(obj);
+    lv_obj_add_event_cb(obj, draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Cached layer");
+    lv_obj_center(label);
+
+    return obj;
+}
+
+void test_draw_layer_cache_rotate(void)
+{
+    lv_obj_t * obj = create_layered_obj();
+    lv_obj_set_style_transform_rotation(obj, 100, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+
+    /*Only blended again with the new rotation*/
+    lv_obj_set_style_transform_rotation(obj, 200, 0);
+    lv_refr_now(NULL);
+    lv_obj_set_style_transform_rotation(obj, 300, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+}
+
+void test_draw_layer_cache_fade(void)
+{
+    lv_obj_t * obj = create_layered_obj();
+    lv_obj_set_style_opa_layered(obj, LV_OPA_50, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+
+    lv_obj_set_style_opa_layered(obj, LV_OPA_70, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+}
+
+void test_draw_layer_cache_same_as_not_cached(void)
+{
+    lv_obj_t * obj = create_layered_obj();
+    lv_obj_set_style_transform_rotation(obj, 150, 0);
+    lv_obj_set_style_opa_layered(obj, LV_OPA_70, 0);
+
+    lv_draw_layer_cache_resize(0, true);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/layer_cache_1.png");
+
+    /*Rendered to the cache and drawn from the cache*/
+    lv_draw_layer_cache_resize(1024 * 1024, false);
+    draw_main_cnt = 0;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/layer_cache_1.png");
+}
+
+void test_draw_layer_cache_redraw_on_change(void)
+{
+    lv_obj_t * obj = create_layered_obj();
+    lv_obj_set_style_transform_rotation(obj, 100, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+
+    /*A child has changed*/
+    lv_label_set_text(lv_obj_get_child(obj, 0), "Changed");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_main_cnt);
+
+    /*The content of the widget has changed*/
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, draw_main_cnt);
+
+    /*Moved*/
+    lv_obj_set_x(obj, 10);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(4, draw_main_cnt);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(4, draw_main_cnt);
+}
+
+void test_draw_layer_cache_redraw_on_parent_change(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(parent, lv_pct(100), lv_pct(100));
+    lv_obj_t * obj = create_layered_obj();
+    lv_obj_set_parent(obj, parent);
+    lv_obj_set_style_transform_rotation(obj, 100, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+
+    /*The label in the cached layer inherits the text color*/
+    lv_obj_set_style_text_color(parent, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_main_cnt);
+
+    /*The opacity of the parent is applied when the children are rendered*/
+    lv_obj_set_style_opa(parent, LV_OPA_50, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, draw_main_cnt);
+}
+
+void test_draw_layer_cache_layer_memory(void)
+{
+    uint32_t used_kb = LV_GLOBAL_DEFAULT()->draw_info.used_memory_for_layers_kb;
+
+    lv_obj_t * obj = create_layered_obj();
+    lv_obj_set_style_opa_layered(obj, LV_OPA_50, 0);
+    lv_refr_now(NULL);
+
+    /*The cached layer is counted as layer memory until it's dropped*/
+    TEST_ASSERT_GREATER_THAN_UINT32(used_kb, LV_GLOBAL_DEFAULT()->draw_info.used_memory_for_layers_kb);
+    lv_draw_layer_cache_drop(NULL);
+    TEST_ASSERT_EQUAL_UINT32(used_kb, LV_GLOBAL_DEFAULT()->draw_info.used_memory_for_layers_kb);
+}
+
+void test_draw_layer_cache_max_memory(void)
+{
+#if LV_DRAW_LAYER_MAX_MEMORY
+    /*The cache could keep all the layers but LV_DRAW_LAYER_MAX_MEMORY can't*/
+    lv_draw_layer_cache_resize(16 * 1024 * 1024, false);
+    uint32_t i;
+    for(i = 0; i < 9; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_screen_active());
+        lv_obj_set_size(obj, 250, 150);
+        lv_obj_set_pos(obj, (i % 3) * 265, (i / 3) * 160);
+        lv_obj_set_style_opa_layered(obj, LV_OPA_50, 0);
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(LV_DRAW_LAYER_MAX_MEMORY, 9 * 250 * 150 * 4);
+    lv_refr_now(NULL);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_DRAW_LAYER_MAX_MEMORY / 1024,
+                                     LV_GLOBAL_DEFAULT()->draw_info.used_memory_for_layers_kb);
+
+    /*The least recently used cached layers are dropped to cache a widget which changes again*/
+    lv_obj_t * last = lv_obj_get_child(lv_screen_active(), -1);
+    lv_obj_add_event_cb(last, draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_set_style_opa_layered(last, LV_OPA_70, 0);
+    lv_refr_now(NULL);
+    uint32_t cnt = draw_main_cnt;
+    TEST_ASSERT_GREATER_THAN_UINT32(0, cnt);
+
+    lv_obj_set_style_opa_layered(last, LV_OPA_80, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(cnt, draw_main_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_DRAW_LAYER_MAX_MEMORY / 1024,
+                                     LV_GLOBAL_DEFAULT()->draw_info.used_memory_for_layers_kb);
+#else
+    TEST_IGNORE_MESSAGE("LV_DRAW_LAYER_MAX_MEMORY is not set");
+#endif
+}
+
+void test_draw_layer_cache_budget(void)
+{
+    /*The layer doesn't fit into the cache*/
+    lv_draw_layer_cache_resize(1024, true);
+
+    lv_obj_t * obj = create_layered_obj();
+    lv_obj_set_style_transform_rotation(obj, 100, 0);
+    lv_refr_now(NULL);
+    lv_obj_set_style_transform_rotation(obj, 200, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_main_cnt);
+}
+
+void test_draw_layer_cache_lru(void)
+{
+    lv_obj_t * obj1 = create_layered_obj();
+    lv_obj_set_style_opa_layered(obj1, LV_OPA_50, 0);
+    lv_obj_align(obj1, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_t * obj2 = create_layered_obj();
+    lv_obj_set_style_opa_layered(obj2, LV_OPA_50, 0);
+    lv_obj_align(obj2, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+
+    /*Only one of the layers fits into the cache*/
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(250, 150, LV_COLOR_FORMAT_ARGB8888, 0);
+    lv_draw_layer_cache_resize(draw_buf->data_size, true);
+    lv_draw_buf_destroy(draw_buf);
+
+    lv_refr_now(NULL);
+
+    /*The layer of obj2 is the most recently used so it's kept in the cache*/
+    lv_obj_set_style_opa_layered(obj2, LV_OPA_70, 0);
+    lv_refr_now(NULL);
+    uint32_t cnt = draw_main_cnt;
+    lv_obj_set_style_opa_layered(obj2, LV_OPA_80, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(cnt, draw_main_cnt);
+
+    /*The layer of obj1 was dropped to make room for obj2's layer*/
+    lv_obj_set_style_opa_layered(obj1, LV_OPA_70, 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(cnt + 1, draw_main_cnt);
+}
+
+#endif
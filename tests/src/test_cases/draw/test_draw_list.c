@@ -0,0 +1,175 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_DRAW_LIST
+
+static uint32_t draw_main_cnt;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    draw_main_cnt = 0;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static void draw_main_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_main_cnt++;
+}
+
+static lv_obj_t * create_retained_label(void)
+{
+    lv_obj_t * btn = lv_button_create(lv_screen_active());
+    lv_obj_set_style_shadow_width(btn, 20, 0);
+    lv_obj_center(btn);
+
+    lv_obj_t * label = lv_label_create(btn);
+    lv_label_set_text(label, "Retained");
+    lv_obj_add_flag(label, LV_OBJ_FLAG_RETAIN_DRAW);
+    lv_obj_add_event_cb(label, draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+    return label;
+}
+
+static void redraw_screen(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+}
+
+void test_draw_list_replay_unchanged(void)
+{
+    create_retained_label();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+
+    redraw_screen();
+    redraw_screen();
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+}
+
+void test_draw_list_same_as_drawn(void)
+{
+    lv_obj_t * label = create_retained_label();
+    lv_obj_remove_flag(label, LV_OBJ_FLAG_RETAIN_DRAW);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/draw_list_1.png");
+
+    lv_obj_add_flag(label, LV_OBJ_FLAG_RETAIN_DRAW);
+    redraw_screen();
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/draw_list_1.png");
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/draw_list_1.png");
+}
+
+void test_draw_list_redraw_on_change(void)
+{
+    lv_obj_t * label = create_retained_label();
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+
+    /*Content change*/
+    lv_label_set_text(label, "Changed");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_main_cnt);
+
+    /*Style change of the parent can change the inherited properties*/
+    lv_obj_set_style_text_color(lv_obj_get_parent(label), lv_color_hex(0xff0000), 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, draw_main_cnt);
+
+    /*Moving the parent moves the label too*/
+    lv_obj_set_x(lv_obj_get_parent(label), 10);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(4, draw_main_cnt);
+
+    redraw_screen();
+    TEST_ASSERT_EQUAL_UINT32(4, draw_main_cnt);
+}
+
+void test_draw_list_keeps_the_clip_area(void)
+{
+    /*The scrolling label clips its text to its own area while drawing*/
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_set_long_mode(label, LV_LABEL_LONG_SCROLL);
+    lv_label_set_text(label, "A long text which overflows the label");
+    lv_obj_set_width(label, 100);
+    lv_obj_center(label);
+    lv_obj_add_event_cb(label, draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/draw_list_clip.png");
+
+    lv_obj_add_flag(label, LV_OBJ_FLAG_RETAIN_DRAW);
+    redraw_screen();
+    uint32_t cnt = draw_main_cnt;
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/draw_list_clip.png");
+    TEST_ASSERT_EQUAL_UINT32(cnt, draw_main_cnt);
+}
+
+void test_draw_list_not_recorded_if_clipped(void)
+{
+    lv_obj_t * label = create_retained_label();
+    lv_refr_now(NULL);
+
+    /*Redraw only a part of the label: it's replayed on the smaller clip area*/
+    lv_area_t a = label->coords;
+    a.x2 = a.x1 + 5;
+    lv_obj_invalidate_area(lv_screen_active(), &a);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, draw_main_cnt);
+
+    /*After a change it's drawn only partially so it can't be recorded*/
+    lv_display_enable_invalidation(NULL, false);
+    lv_obj_set_style_text_color(label, lv_color_hex(0x0000ff), 0);
+    lv_display_enable_invalidation(NULL, true);
+    lv_obj_invalidate_area(lv_screen_active(), &a);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, draw_main_cnt);
+
+    lv_obj_invalidate_area(lv_screen_active(), &a);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(3, draw_main_cnt);
+
+    /*Recorded again when fully drawn*/
+    redraw_screen();
+    redraw_screen();
+    TEST_ASSERT_EQUAL_UINT32(4, draw_main_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_list_replay_unchanged(void)
+{
+}
+
+void test_draw_list_same_as_drawn(void)
+{
+}
+
+void test_draw_list_redraw_on_change(void)
+{
+}
+
+void test_draw_list_keeps_the_clip_area(void)
+{
+}
+
+void test_draw_list_not_recorded_if_clipped(void)
+{
+}
+
+#endif
+
+#endif
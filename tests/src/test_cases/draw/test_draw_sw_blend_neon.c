@@ -0,0 +1,211 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/draw/sw/blend/lv_draw_sw_blend.h"
+#include "../../../src/draw/sw/blend/neon/lv_blend_neon.h"
+
+#include "unity/unity.h"
+
+#define SRC_W       23
+#define SRC_H       17
+#define ROW_W       40
+#define ITER_CNT    2000
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+#if LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE
+
+static uint8_t src_buf[SRC_W * SRC_H * 4];
+static uint8_t dest_ref[ROW_W * 4];
+static uint8_t dest_simd[ROW_W * 4];
+static lv_opa_t abuf_ref[ROW_W];
+static lv_opa_t abuf_simd[ROW_W];
+
+/*Prefer the values where the special cases of the mixing are*/
+static uint8_t rand_alpha(void)
+{
+    static const uint8_t special[] = {0, 1, 2, 3, 127, 128, 252, 253, 254, 255};
+    if(lv_rand(0, 1)) return special[lv_rand(0, sizeof(special) - 1)];
+    else return lv_rand(0, 255);
+}
+
+/*Random pixels but many of them are the same as their left neighbor*/
+static void fill_random(uint32_t px_size, bool argb)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(src_buf); i++) {
+        src_buf[i] = (argb && (i % 4) == 3) ? rand_alpha() : lv_rand(0, 255);
+    }
+    for(i = 1; i < SRC_W * SRC_H; i++) {
+        if(lv_rand(0, 3) == 0) lv_memcpy(&src_buf[i * px_size], &src_buf[(i - 1) * px_size], px_size);
+    }
+}
+
+static void get_neighbors(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step, int32_t x,
+                          int32_t * xs_int, int32_t * ys_int, int32_t * x_next, int32_t * y_next,
+                          int32_t * xs_fract, int32_t * ys_fract)
+{
+    int32_t xs = xs_ups + ((xs_step * x) >> 8);
+    int32_t ys = ys_ups + ((ys_step * x) >> 8);
+    *xs_int = xs >> 8;
+    *ys_int = ys >> 8;
+    *xs_fract = xs & 0xFF;
+    *ys_fract = ys & 0xFF;
+    *x_next = *xs_fract < 0x80 ? -1 : 1;
+    *y_next = *ys_fract < 0x80 ? -1 : 1;
+    *xs_fract = *xs_fract < 0x80 ? 0x7F - *xs_fract : *xs_fract - 0x80;
+    *ys_fract = *ys_fract < 0x80 ? 0x7F - *ys_fract : *ys_fract - 0x80;
+}
+
+/*The same as the interior pixels of `transform_argb8888()` in `lv_draw_sw_transform.c`*/
+static lv_color32_t mix_neighbor_32_ref(lv_color32_t c, lv_color32_t n, int32_t fract)
+{
+    if(n.alpha == 0) {
+        c.alpha = (c.alpha * (0xFF - fract)) >> 8;
+    }
+    else if(!lv_color32_eq(c, n)) {
+        c.alpha = ((n.alpha * fract) + (c.alpha * (0xFF - fract))) >> 8;
+        n.alpha = fract;
+        c = lv_color_mix32(n, c);
+    }
+    return c;
+}
+
+static void transform_argb8888_ref(int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                   int32_t x_start, int32_t x_end, uint8_t * dest_buf)
+{
+    const lv_color32_t * src = (const lv_color32_t *)src_buf;
+    lv_color32_t * dest = (lv_color32_t *)dest_buf;
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_int, ys_int, x_next, y_next, xs_fract, ys_fract;
+        get_neighbors(xs_ups, ys_ups, xs_step, ys_step, x, &xs_int, &ys_int, &x_next, &y_next, &xs_fract, &ys_fract);
+        const lv_color32_t * c = &src[ys_int * SRC_W + xs_int];
+        lv_color32_t res = mix_neighbor_32_ref(c[0], c[y_next * SRC_W], ys_fract);
+        dest[x] = mix_neighbor_32_ref(res, c[x_next], xs_fract);
+    }
+}
+
+/*The same as the interior pixels of `transform_rgb565a8()` in `lv_draw_sw_transform.c`*/
+static void transform_rgb565a8_ref(const lv_opa_t * src_alpha, int32_t xs_ups, int32_t ys_ups,
+                                   int32_t xs_step, int32_t ys_step, int32_t x_start, int32_t x_end,
+                                   uint16_t * cbuf, uint8_t * abuf)
+{
+    const uint16_t * src = (const uint16_t *)src_buf;
+    int32_t x;
+    for(x = x_start; x < x_end; x++) {
+        int32_t xs_int, ys_int, x_next, y_next, xs_fract, ys_fract;
+        get_neighbors(xs_ups, ys_ups, xs_step, ys_step, x, &xs_int, &ys_int, &x_next, &y_next, &xs_fract, &ys_fract);
+        xs_fract *= 2;
+        ys_fract *= 2;
+
+        const uint16_t * c = &src[ys_int * SRC_W + xs_int];
+        cbuf[x] = c[0];
+        if(src_alpha) {
+            const lv_opa_t * a = &src_alpha[ys_int * SRC_W + xs_int];
+            int32_t a_hor = ((a[x_next] * xs_fract) + (a[0] * (0x100 - xs_fract))) >> 8;
+            int32_t a_ver = ((a[y_next * SRC_W] * ys_fract) + (a[0] * (0x100 - ys_fract))) >> 8;
+            abuf[x] = (a_ver + a_hor) >> 1;
+            if(abuf[x] == 0x00) continue;
+        }
+        else {
+            abuf[x] = 0xff;
+        }
+
+        uint16_t v = lv_color_16_16_mix(c[y_next * SRC_W], c[0], ys_fract);
+        uint16_t h = lv_color_16_16_mix(c[x_next], c[0], xs_fract);
+        cbuf[x] = lv_color_16_16_mix(h, v, LV_OPA_50);
+    }
+}
+
+/*Get a random row whose pixels and their neighbors are all in the image*/
+static void rand_row(int32_t * xs_ups, int32_t * ys_ups, int32_t * xs_step, int32_t * ys_step,
+                     int32_t * x_start, int32_t * x_end)
+{
+    while(1) {
+        *xs_ups = lv_rand(256, (SRC_W - 1) * 256 - 1);
+        *ys_ups = lv_rand(256, (SRC_H - 1) * 256 - 1);
+        *xs_step = (int32_t)lv_rand(0, 1024) - 512;
+        *ys_step = (int32_t)lv_rand(0, 1024) - 512;
+
+        int32_t x;
+        for(x = 0; x < ROW_W; x++) {
+            int32_t xs_int = (*xs_ups + ((*xs_step * x) >> 8)) >> 8;
+            int32_t ys_int = (*ys_ups + ((*ys_step * x) >> 8)) >> 8;
+            if(xs_int < 1 || xs_int > SRC_W - 2 || ys_int < 1 || ys_int > SRC_H - 2) break;
+        }
+        if(x == 0) continue;
+
+        *x_end = x;
+        *x_start = lv_rand(0, x - 1);
+        return;
+    }
+}
+
+static void test_transform(lv_color_format_t cf)
+{
+    uint32_t px_size = cf == LV_COLOR_FORMAT_ARGB8888 ? 4 : 2;
+    int32_t src_stride = SRC_W * px_size;
+    const lv_opa_t * src_alpha = cf == LV_COLOR_FORMAT_RGB565A8 ? src_buf + src_stride * SRC_H : NULL;
+
+    uint32_t i;
+    for(i = 0; i < ITER_CNT; i++) {
+        fill_random(px_size, cf == LV_COLOR_FORMAT_ARGB8888);
+        if(src_alpha) {
+            uint32_t j;
+            for(j = 0; j < SRC_W * SRC_H; j++) src_buf[src_stride * SRC_H + j] = rand_alpha();
+        }
+
+        int32_t xs_ups, ys_ups, xs_step, ys_step, x_start, x_end;
+        rand_row(&xs_ups, &ys_ups, &xs_step, &ys_step, &x_start, &x_end);
+
+        lv_memzero(dest_ref, sizeof(dest_ref));
+        lv_memzero(dest_simd, sizeof(dest_simd));
+        lv_memzero(abuf_ref, sizeof(abuf_ref));
+        lv_memzero(abuf_simd, sizeof(abuf_simd));
+
+        /*The pixels not processed by the kernel are processed in C*/
+        int32_t x;
+        if(cf == LV_COLOR_FORMAT_ARGB8888) {
+            transform_argb8888_ref(xs_ups, ys_ups, xs_step, ys_step, x_start, x_end, dest_ref);
+            x = lv_draw_sw_transform_argb8888_neon(src_buf, src_stride, xs_ups, ys_ups, xs_step, ys_step,
+                                                   x_start, x_end, (uint32_t *)dest_simd);
+            transform_argb8888_ref(xs_ups, ys_ups, xs_step, ys_step, x, x_end, dest_simd);
+        }
+        else {
+            transform_rgb565a8_ref(src_alpha, xs_ups, ys_ups, xs_step, ys_step, x_start, x_end,
+                                   (uint16_t *)dest_ref, abuf_ref);
+            x = lv_draw_sw_transform_rgb565a8_neon(src_buf, src_stride, src_alpha, xs_ups, ys_ups, xs_step, ys_step,
+                                                   x_start, x_end, (uint16_t *)dest_simd, abuf_simd);
+            transform_rgb565a8_ref(src_alpha, xs_ups, ys_ups, xs_step, ys_step, x, x_end,
+                                   (uint16_t *)dest_simd, abuf_simd);
+        }
+
+        TEST_ASSERT_GREATER_OR_EQUAL(x_start, x);
+        TEST_ASSERT_LESS_OR_EQUAL(x_end, x);
+        TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_simd, sizeof(dest_ref));
+        TEST_ASSERT_EQUAL_MEMORY(abuf_ref, abuf_simd, sizeof(abuf_ref));
+    }
+}
+
+#endif /*LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE*/
+
+void test_neon_transform_is_pixel_exact(void)
+{
+#if LV_DRAW_SW_NEON_INTRINSICS_AVAILABLE
+    test_transform(LV_COLOR_FORMAT_ARGB8888);
+    test_transform(LV_COLOR_FORMAT_RGB565);
+    test_transform(LV_COLOR_FORMAT_RGB565A8);
+#else
+    TEST_IGNORE_MESSAGE("NEON is not available");
+#endif
+}
+
+#endif
@@ -0,0 +1,319 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "../../../src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.h"
+#include "../../../src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+#include "../../../src/draw/sw/blend/sse2/lv_blend_sse2.h"
+#include "../../../src/draw/sw/blend/avx2/lv_blend_avx2.h"
+#include "../../../src/draw/sw/blend/x86/lv_blend_x86.h"
+#include "../../../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#define MAX_W       40
+#define MAX_H       4
+#define STRIDE      (MAX_W * 4 + 12)
+#define ITER_CNT    2000
+
+#define TR_SRC_W    23
+#define TR_SRC_H    17
+#define TR_DEST_W   45
+#define TR_DEST_H   5
+
+typedef void (*color_ref_cb_t)(_lv_draw_sw_blend_fill_dsc_t * dsc);
+typedef void (*image_ref_cb_t)(_lv_draw_sw_blend_image_dsc_t * dsc);
+typedef lv_result_t (*color_simd_cb_t)(_lv_draw_sw_blend_fill_dsc_t * dsc);
+typedef lv_result_t (*image_simd_cb_t)(_lv_draw_sw_blend_image_dsc_t * dsc);
+
+static uint8_t dest_ref[STRIDE * MAX_H];
+static uint8_t dest_simd[STRIDE * MAX_H];
+static uint8_t src_buf[STRIDE * MAX_H];
+static lv_opa_t mask_buf[STRIDE * MAX_H];
+static uint8_t tr_src_buf[TR_SRC_W * TR_SRC_H * 4];
+static uint8_t tr_dest_ref[TR_DEST_W * TR_DEST_H * 4];
+static uint8_t tr_dest_simd[TR_DEST_W * TR_DEST_H * 4];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+    lv_draw_sw_blend_x86_init();
+#endif
+}
+
+/*The hooks of the C implementation can call the kernels too, so disable them for the reference*/
+static void use_c_implementation(void)
+{
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+    lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_NONE);
+#endif
+}
+
+/*Prefer the values where the special cases of the blending are*/
+static uint8_t rand_alpha(void)
+{
+    static const uint8_t special[] = {0, 1, 2, 3, 127, 128, 252, 253, 254, 255};
+    if(lv_rand(0, 1)) return special[lv_rand(0, sizeof(special) - 1)];
+    else return lv_rand(0, 255);
+}
+
+static void fill_random(uint8_t * buf, uint32_t size, bool argb)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        buf[i] = (argb && (i % 4) == 3) ? rand_alpha() : lv_rand(0, 255);
+    }
+}
+
+static void prepare(int32_t * w, int32_t * h, lv_opa_t * opa, bool * mask, bool dest_argb)
+{
+    *w = lv_rand(1, MAX_W);
+    *h = lv_rand(1, MAX_H);
+    *opa = lv_rand(0, 1) ? LV_OPA_COVER : rand_alpha();
+    *mask = lv_rand(0, 1);
+
+    fill_random(dest_ref, sizeof(dest_ref), dest_argb);
+    lv_memcpy(dest_simd, dest_ref, sizeof(dest_ref));
+    fill_random(src_buf, sizeof(src_buf), true);
+    uint32_t i;
+    for(i = 0; i < sizeof(mask_buf); i++) mask_buf[i] = rand_alpha();
+}
+
+static void test_color(color_ref_cb_t ref_cb, color_simd_cb_t simd_cb, bool dest_argb)
+{
+    uint32_t i;
+    for(i = 0; i < ITER_CNT; i++) {
+        _lv_draw_sw_blend_fill_dsc_t dsc;
+        bool mask;
+        prepare(&dsc.dest_w, &dsc.dest_h, &dsc.opa, &mask, dest_argb);
+        dsc.dest_stride = STRIDE;
+        dsc.mask_buf = mask ? mask_buf : NULL;
+        dsc.mask_stride = MAX_W + 3;
+        dsc.color = lv_color_hex(lv_rand(0, 0xFFFFFF));
+
+        dsc.dest_buf = dest_ref;
+        ref_cb(&dsc);
+        dsc.dest_buf = dest_simd;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, simd_cb(&dsc));
+        TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_simd, sizeof(dest_ref));
+    }
+}
+
+static void test_image(image_ref_cb_t ref_cb, image_simd_cb_t simd_cb, bool dest_argb)
+{
+    uint32_t i;
+    for(i = 0; i < ITER_CNT; i++) {
+        _lv_draw_sw_blend_image_dsc_t dsc;
+        bool mask;
+        prepare(&dsc.dest_w, &dsc.dest_h, &dsc.opa, &mask, dest_argb);
+        dsc.dest_stride = STRIDE;
+        dsc.mask_buf = mask ? mask_buf : NULL;
+        dsc.mask_stride = MAX_W + 3;
+        dsc.src_buf = src_buf;
+        dsc.src_stride = STRIDE - 4;
+        dsc.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+        dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+        dsc.dest_buf = dest_ref;
+        ref_cb(&dsc);
+        dsc.dest_buf = dest_simd;
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, simd_cb(&dsc));
+        TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_simd, sizeof(dest_ref));
+    }
+}
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+/*Rotate random images and compare the result of a level with the C implementation*/
+static void test_transform(lv_color_format_t cf, lv_draw_sw_x86_level_t level)
+{
+    int32_t src_stride = TR_SRC_W * (cf == LV_COLOR_FORMAT_ARGB8888 ? 4 : 2);
+
+    uint32_t i;
+    for(i = 0; i < ITER_CNT / 10; i++) {
+        fill_random(tr_src_buf, sizeof(tr_src_buf), cf == LV_COLOR_FORMAT_ARGB8888);
+        if(cf == LV_COLOR_FORMAT_RGB565A8) {
+            uint8_t * alpha = tr_src_buf + src_stride * TR_SRC_H;
+            uint32_t j;
+            for(j = 0; j < TR_SRC_W * TR_SRC_H; j++) alpha[j] = rand_alpha();
+        }
+
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.rotation = lv_rand(1, 3599);
+        dsc.scale_x = lv_rand(64, 1024);
+        dsc.scale_y = lv_rand(0, 1) ? dsc.scale_x : (int32_t)lv_rand(64, 1024);
+        dsc.pivot.x = lv_rand(0, TR_SRC_W);
+        dsc.pivot.y = lv_rand(0, TR_SRC_H);
+        dsc.antialias = lv_rand(0, 3) != 0;
+
+        lv_area_t area;
+        area.x1 = lv_rand(0, 40) - 20;
+        area.y1 = lv_rand(0, 40) - 20;
+        area.x2 = area.x1 + lv_rand(1, TR_DEST_W) - 1;
+        area.y2 = area.y1 + lv_rand(1, TR_DEST_H) - 1;
+
+        lv_memzero(tr_dest_ref, sizeof(tr_dest_ref));
+        lv_memzero(tr_dest_simd, sizeof(tr_dest_simd));
+        lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_NONE);
+        lv_draw_sw_transform(NULL, &area, tr_src_buf, TR_SRC_W, TR_SRC_H, src_stride, &dsc, NULL, cf, tr_dest_ref);
+        lv_draw_sw_blend_x86_set_level(level);
+        lv_draw_sw_transform(NULL, &area, tr_src_buf, TR_SRC_W, TR_SRC_H, src_stride, &dsc, NULL, cf, tr_dest_simd);
+        TEST_ASSERT_EQUAL_MEMORY(tr_dest_ref, tr_dest_simd, sizeof(tr_dest_ref));
+    }
+}
+#endif
+
+static void color_to_xrgb8888_ref(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    lv_draw_sw_blend_color_to_rgb888(dsc, 4);
+}
+
+static void image_to_xrgb8888_ref(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    lv_draw_sw_blend_image_to_rgb888(dsc, 4);
+}
+
+#if LV_DRAW_SW_SSE2_AVAILABLE
+static lv_result_t color_to_xrgb8888_sse2(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    return lv_draw_sw_blend_color_to_rgb888_sse2(dsc, 4);
+}
+
+static lv_result_t image_to_xrgb8888_sse2(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    return lv_draw_sw_blend_argb8888_to_rgb888_sse2(dsc, 4);
+}
+#endif
+
+#if LV_DRAW_SW_AVX2_AVAILABLE
+static lv_result_t color_to_xrgb8888_avx2(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    return lv_draw_sw_blend_color_to_rgb888_avx2(dsc, 4);
+}
+
+static lv_result_t image_to_xrgb8888_avx2(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    return lv_draw_sw_blend_argb8888_to_rgb888_avx2(dsc, 4);
+}
+
+static bool avx2_supported(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("avx2");
+#else
+    return true;
+#endif
+}
+#endif
+
+void test_sse2_blend_is_pixel_exact(void)
+{
+#if LV_DRAW_SW_SSE2_AVAILABLE
+    use_c_implementation();
+    test_color(lv_draw_sw_blend_color_to_rgb565, lv_draw_sw_blend_color_to_rgb565_sse2, false);
+    test_color(color_to_xrgb8888_ref, color_to_xrgb8888_sse2, false);
+    test_color(lv_draw_sw_blend_color_to_argb8888, lv_draw_sw_blend_color_to_argb8888_sse2, true);
+    test_image(lv_draw_sw_blend_image_to_rgb565, lv_draw_sw_blend_argb8888_to_rgb565_sse2, false);
+    test_image(image_to_xrgb8888_ref, image_to_xrgb8888_sse2, false);
+    test_image(lv_draw_sw_blend_image_to_argb8888, lv_draw_sw_blend_argb8888_to_argb8888_sse2, true);
+#else
+    TEST_IGNORE_MESSAGE("SSE2 is not available");
+#endif
+}
+
+void test_avx2_blend_is_pixel_exact(void)
+{
+#if LV_DRAW_SW_AVX2_AVAILABLE
+    if(!avx2_supported()) TEST_IGNORE_MESSAGE("AVX2 is not supported by the CPU");
+    use_c_implementation();
+
+    test_color(lv_draw_sw_blend_color_to_rgb565, lv_draw_sw_blend_color_to_rgb565_avx2, false);
+    test_color(color_to_xrgb8888_ref, color_to_xrgb8888_avx2, false);
+    test_color(lv_draw_sw_blend_color_to_argb8888, lv_draw_sw_blend_color_to_argb8888_avx2, true);
+    test_image(lv_draw_sw_blend_image_to_rgb565, lv_draw_sw_blend_argb8888_to_rgb565_avx2, false);
+    test_image(image_to_xrgb8888_ref, image_to_xrgb8888_avx2, false);
+    test_image(lv_draw_sw_blend_image_to_argb8888, lv_draw_sw_blend_argb8888_to_argb8888_avx2, true);
+#else
+    TEST_IGNORE_MESSAGE("AVX2 is not available");
+#endif
+}
+
+void test_x86_transform_is_pixel_exact(void)
+{
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+    static const lv_color_format_t cfs[] = {LV_COLOR_FORMAT_ARGB8888, LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB565A8};
+    uint32_t i;
+    for(i = 0; i < sizeof(cfs) / sizeof(cfs[0]); i++) {
+        test_transform(cfs[i], LV_DRAW_SW_X86_LEVEL_SSE2);
+        test_transform(cfs[i], LV_DRAW_SW_X86_LEVEL_AVX2);
+    }
+#else
+    TEST_IGNORE_MESSAGE("The x86 dispatch is not enabled");
+#endif
+}
+
+void test_sse2_rgb888_falls_back_to_c(void)
+{
+#if LV_DRAW_SW_SSE2_AVAILABLE
+    _lv_draw_sw_blend_fill_dsc_t dsc;
+    lv_memzero(&dsc, sizeof(dsc));
+    dsc.dest_buf = dest_simd;
+    dsc.dest_w = 1;
+    dsc.dest_h = 1;
+    dsc.opa = LV_OPA_COVER;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_draw_sw_blend_color_to_rgb888_sse2(&dsc, 3));
+#else
+    TEST_IGNORE_MESSAGE("SSE2 is not available");
+#endif
+}
+
+void test_x86_dispatch_uses_the_supported_level(void)
+{
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+    lv_draw_sw_x86_level_t supported = lv_draw_sw_blend_x86_get_supported_level();
+    TEST_ASSERT_EQUAL(supported, lv_draw_sw_blend_x86_get_level());
+#if LV_DRAW_SW_SSE2_AVAILABLE
+    TEST_ASSERT_GREATER_OR_EQUAL(LV_DRAW_SW_X86_LEVEL_SSE2, supported);
+#endif
+#if LV_DRAW_SW_AVX2_AVAILABLE
+    if(avx2_supported()) TEST_ASSERT_EQUAL(LV_DRAW_SW_X86_LEVEL_AVX2, supported);
+#endif
+
+    /*Unsupported levels fall back to the highest supported one*/
+    lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_AVX2);
+    TEST_ASSERT_EQUAL(supported, lv_draw_sw_blend_x86_get_level());
+#else
+    TEST_IGNORE_MESSAGE("The x86 dispatch is not enabled");
+#endif
+}
+
+void test_x86_dispatch_level_none_uses_c(void)
+{
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+    _lv_draw_sw_blend_fill_dsc_t dsc;
+    lv_memzero(&dsc, sizeof(dsc));
+    dsc.dest_buf = dest_simd;
+    dsc.dest_w = 1;
+    dsc.dest_h = 1;
+    dsc.dest_stride = STRIDE;
+    dsc.opa = LV_OPA_COVER;
+
+    lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_NONE);
+    TEST_ASSERT_EQUAL(LV_DRAW_SW_X86_LEVEL_NONE, lv_draw_sw_blend_x86_get_level());
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_draw_sw_blend_color_to_argb8888_x86(&dsc));
+
+    lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_SSE2);
+    if(lv_draw_sw_blend_x86_get_level() != LV_DRAW_SW_X86_LEVEL_NONE) {
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_draw_sw_blend_color_to_argb8888_x86(&dsc));
+    }
+#else
+    TEST_IGNORE_MESSAGE("The x86 dispatch is not enabled");
+#endif
+}
+
+#endif
@@ -0,0 +1,105 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/draw/sw/lv_draw_sw_mask.h"
+
+#include "unity/unity.h"
+
+#define ROW_W   128
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_draw_sw_mask_corner_cache_resize(LV_DRAW_SW_CORNER_CACHE_SIZE, false);
+}
+
+static void check_rows(int32_t radius, bool outer)
+{
+    lv_area_t rect;
+    lv_area_set(&rect, 10, 10, 10 + lv_rand(2 * radius, 2 * radius + 40), 10 + lv_rand(2 * radius, 2 * radius + 40));
+
+    lv_draw_sw_mask_radius_param_t param;
+    lv_draw_sw_mask_radius_init(&param, &rect, radius, outer);
+    void * masks[2] = {&param, NULL};
+
+    lv_opa_t ref[ROW_W];
+    lv_opa_t res[ROW_W];
+    int32_t y;
+    for(y = rect.y1 - 2; y <= rect.y2 + 2; y++) {
+        int32_t x = lv_rand(0, rect.x2);
+        int32_t len = lv_rand(1, ROW_W);
+        lv_opa_t opa = lv_rand(0, 1) ? LV_OPA_COVER : lv_rand(0, 255);
+
+        lv_memset(ref, opa, len);
+        lv_draw_sw_mask_res_t ref_res = lv_draw_sw_mask_apply(masks, ref, x, y, len);
+        lv_draw_sw_mask_res_t row_res = lv_draw_sw_mask_radius_fill_row(&param, res, x, y, len, opa);
+
+        if(ref_res == LV_DRAW_SW_MASK_RES_TRANSP) lv_memzero(ref, len);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, res, len);
+
+        /*Only the results telling something about the content have to be exact*/
+        if(row_res == LV_DRAW_SW_MASK_RES_FULL_COVER) {
+            int32_t i;
+            for(i = 0; i < len; i++) TEST_ASSERT_EQUAL_UINT8(opa, res[i]);
+        }
+        else if(row_res == LV_DRAW_SW_MASK_RES_TRANSP) {
+            int32_t i;
+            for(i = 0; i < len; i++) TEST_ASSERT_EQUAL_UINT8(0, res[i]);
+        }
+    }
+
+    lv_draw_sw_mask_free_param(&param);
+}
+
+void test_corner_rows_match_the_mask_chain(void)
+{
+    int32_t radius;
+    for(radius = 1; radius < 40; radius++) {
+        check_rows(radius, false);
+        check_rows(radius, true);
+    }
+}
+
+void test_corner_row_extent(void)
+{
+    lv_opa_t row[ROW_W];
+    int32_t radius;
+    for(radius = 1; radius < 40; radius++) {
+        lv_area_t rect;
+        lv_area_set(&rect, 4, 4, 4 + lv_rand(2 * radius, ROW_W - 8), 4 + lv_rand(2 * radius, 2 * radius + 40));
+
+        lv_draw_sw_mask_radius_param_t param;
+        lv_draw_sw_mask_radius_init(&param, &rect, radius, false);
+
+        int32_t y;
+        for(y = rect.y1 - 2; y <= rect.y2 + 2; y++) {
+            int32_t x1;
+            int32_t x2;
+            int32_t aa_len;
+            lv_draw_sw_mask_radius_get_row(&param, y, &x1, &x2, &aa_len);
+            lv_draw_sw_mask_radius_fill_row(&param, row, 0, y, ROW_W, LV_OPA_COVER);
+
+            int32_t x;
+            for(x = 0; x < ROW_W; x++) {
+                if(x >= x1 && x <= x2) TEST_ASSERT_EQUAL_UINT8(LV_OPA_COVER, row[x]);
+                else if(x < x1 - aa_len || x > x2 + aa_len) TEST_ASSERT_EQUAL_UINT8(0, row[x]);
+            }
+        }
+
+        lv_draw_sw_mask_free_param(&param);
+    }
+}
+
+void test_corner_rows_without_cache(void)
+{
+    /*The tables are calculated for each mask if they don't fit into the cache*/
+    lv_draw_sw_mask_corner_cache_resize(0, true);
+    check_rows(20, false);
+    check_rows(33, true);
+}
+
+#endif
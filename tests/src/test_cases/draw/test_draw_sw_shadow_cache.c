@@ -0,0 +1,81 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+    lv_draw_sw_shadow_cache_resize(LV_DRAW_SW_SHADOW_CACHE_SIZE_BYTES, true);
+}
+
+static void create_shadows(void)
+{
+    static const int32_t sizes[][2] = {{8, 6}, {30, 20}, {120, 40}, {200, 90}};
+    static const int32_t widths[] = {1, 4, 15, 30};
+    static const int32_t radii[] = {0, 5, 12, LV_RADIUS_CIRCLE};
+
+    lv_obj_set_flex_flow(lv_screen_active(), LV_FLEX_FLOW_ROW_WRAP);
+
+    uint32_t i;
+    for(i = 0; i < 16; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_screen_active());
+        lv_obj_set_style_pad_all(obj, 0, 0);
+        lv_obj_set_size(obj, sizes[i % 4][0], sizes[i % 4][1]);
+        lv_obj_set_style_radius(obj, radii[(i / 4) % 4], 0);
+        lv_obj_set_style_shadow_width(obj, widths[(i + i / 4) % 4], 0);
+        lv_obj_set_style_shadow_spread(obj, i % 3, 0);
+        lv_obj_set_style_shadow_offset_x(obj, i % 5, 0);
+        lv_obj_set_style_shadow_offset_y(obj, 3, 0);
+        lv_obj_set_style_shadow_opa(obj, i % 2 ? LV_OPA_COVER : LV_OPA_50, 0);
+        lv_obj_set_style_bg_opa(obj, i % 3 ? LV_OPA_COVER : LV_OPA_30, 0);
+    }
+}
+
+void test_shadow_cache_same_as_not_cached(void)
+{
+    create_shadows();
+
+    lv_draw_sw_shadow_cache_resize(0, true);
+    lv_draw_buf_t * ref = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    /*Render twice to draw from the cache too*/
+    lv_draw_sw_shadow_cache_resize(1024 * 1024, false);
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_draw_buf_t * act = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+        TEST_ASSERT_NOT_NULL(act);
+        TEST_ASSERT_EQUAL_UINT32(ref->data_size, act->data_size);
+        TEST_ASSERT_EQUAL_MEMORY(ref->data, act->data, ref->data_size);
+        lv_draw_buf_destroy(act);
+    }
+
+    lv_draw_buf_destroy(ref);
+}
+
+void test_shadow_cache_budget(void)
+{
+    create_shadows();
+
+    /*Only some of the shadows fit into the cache and the others evict each other*/
+    lv_draw_sw_shadow_cache_resize(0, true);
+    lv_draw_buf_t * ref = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    lv_draw_sw_shadow_cache_resize(2 * 1024, false);
+    lv_draw_buf_t * act = lv_snapshot_take(lv_screen_active(), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(act);
+    TEST_ASSERT_EQUAL_MEMORY(ref->data, act->data, ref->data_size);
+
+    lv_draw_buf_destroy(act);
+    lv_draw_buf_destroy(ref);
+}
+
+#endif
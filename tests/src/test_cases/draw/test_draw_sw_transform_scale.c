@@ -0,0 +1,82 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+LV_IMAGE_DECLARE(test_image_cogwheel_a8);
+LV_IMAGE_DECLARE(test_image_cogwheel_argb8888);
+LV_IMAGE_DECLARE(test_image_cogwheel_rgb565);
+LV_IMAGE_DECLARE(test_image_cogwheel_rgb565a8);
+LV_IMAGE_DECLARE(test_image_cogwheel_xrgb8888);
+LV_IMAGE_DECLARE(test_RGB888_NONE_align1);
+
+static const lv_image_dsc_t * images[] = {
+    &test_image_cogwheel_a8,
+    &test_image_cogwheel_argb8888,
+    &test_image_cogwheel_rgb565,
+    &test_image_cogwheel_rgb565a8,
+    &test_image_cogwheel_xrgb8888,
+    &test_RGB888_NONE_align1,
+};
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_obj_set_flex_flow(lv_screen_active(), LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_flex_align(lv_screen_active(), LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_SPACE_EVENLY);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static void create_images(int32_t scale_x, int32_t scale_y, int32_t w, int32_t h)
+{
+    uint32_t aa;
+    for(aa = 0; aa <= 1; aa++) {
+        uint32_t i;
+        for(i = 0; i < sizeof(images) / sizeof(images[0]); i++) {
+            lv_obj_t * img = lv_image_create(lv_screen_active());
+            lv_image_set_src(img, images[i]);
+            lv_obj_set_size(img, w, h);
+            lv_image_set_inner_align(img, LV_IMAGE_ALIGN_CENTER);
+            lv_image_set_scale_x(img, scale_x);
+            lv_image_set_scale_y(img, scale_y);
+            lv_image_set_antialias(img, aa);
+            lv_obj_set_style_image_recolor(img, lv_palette_main(LV_PALETTE_RED), 0);   /*For A8*/
+            lv_obj_set_style_bg_color(img, lv_palette_lighten(LV_PALETTE_BLUE, 4), 0);
+            lv_obj_set_style_bg_opa(img, LV_OPA_COVER, 0);
+        }
+    }
+}
+
+void test_draw_sw_transform_scale_down(void)
+{
+    create_images(180, 110, 120, 120);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/transform_scale_down.png");
+}
+
+void test_draw_sw_transform_scale_up(void)
+{
+    /*Only the center of the images is visible*/
+    create_images(330, 410, 120, 200);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/transform_scale_up.png");
+}
+
+void test_draw_sw_transform_scale_pivot(void)
+{
+    uint32_t i;
+    for(i = 0; i < sizeof(images) / sizeof(images[0]); i++) {
+        lv_obj_t * img = lv_image_create(lv_screen_active());
+        lv_image_set_src(img, images[i]);
+        lv_image_set_pivot(img, 10, 20);
+        lv_image_set_scale_x(img, 290);
+        lv_image_set_scale_y(img, 170);
+        lv_obj_set_style_image_recolor(img, lv_palette_main(LV_PALETTE_GREEN), 0);   /*For A8*/
+    }
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/transform_scale_pivot.png");
+}
+
+#endif
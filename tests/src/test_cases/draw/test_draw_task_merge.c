@@ -0,0 +1,128 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * canvas;
+static lv_layer_t layer;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    LV_DRAW_BUF_DEFINE(draw_buf, 100, 100, LV_COLOR_FORMAT_NATIVE);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, &draw_buf);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+
+    /*The tasks of a canvas layer are not dispatched until the layer is finished*/
+    lv_canvas_init_layer(canvas, &layer);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static uint32_t get_task_cnt(void)
+{
+    uint32_t cnt = 0;
+    lv_draw_task_t * t;
+    for(t = layer.draw_task_head; t; t = t->next) cnt++;
+    return cnt;
+}
+
+static void draw_cell(int32_t x1, int32_t y1, int32_t x2, int32_t y2, lv_color_t bg_color, lv_border_side_t side)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = bg_color;
+    dsc.bg_opa = LV_OPA_50;
+    dsc.border_side = side;
+    dsc.border_width = side == LV_BORDER_SIDE_NONE ? 0 : 2;
+    dsc.border_color = lv_color_black();
+
+    lv_area_t a = {x1, y1, x2, y2};
+    lv_draw_rect(&layer, &dsc, &a);
+}
+
+static void assert_px(int32_t x, int32_t y, lv_color_t color)
+{
+    lv_color32_t px = lv_canvas_get_px(canvas, x, y);
+    TEST_ASSERT_EQUAL_UINT8(color.red, px.red);
+    TEST_ASSERT_EQUAL_UINT8(color.green, px.green);
+    TEST_ASSERT_EQUAL_UINT8(color.blue, px.blue);
+}
+
+void test_draw_task_merge_fill_row(void)
+{
+    draw_cell(0, 0, 9, 9, lv_palette_main(LV_PALETTE_RED), LV_BORDER_SIDE_NONE);
+    draw_cell(10, 0, 19, 9, lv_palette_main(LV_PALETTE_RED), LV_BORDER_SIDE_NONE);
+    draw_cell(20, 0, 29, 9, lv_palette_main(LV_PALETTE_RED), LV_BORDER_SIDE_NONE);
+    TEST_ASSERT_EQUAL_UINT32(1, get_task_cnt());
+    TEST_ASSERT_EQUAL_INT32(29, layer.draw_task_head->area.x2);
+
+    /*Column below the first cell*/
+    draw_cell(0, 10, 29, 19, lv_palette_main(LV_PALETTE_RED), LV_BORDER_SIDE_NONE);
+    TEST_ASSERT_EQUAL_UINT32(1, get_task_cnt());
+    TEST_ASSERT_EQUAL_INT32(19, layer.draw_task_head->area.y2);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    /*The semi transparent cells are not blended twice anywhere*/
+    lv_color32_t px = lv_canvas_get_px(canvas, 5, 5);
+    assert_px(9, 5, lv_color_make(px.red, px.green, px.blue));
+    assert_px(10, 10, lv_color_make(px.red, px.green, px.blue));
+    assert_px(29, 19, lv_color_make(px.red, px.green, px.blue));
+    assert_px(30, 5, lv_color_white());
+}
+
+void test_draw_task_merge_not_mergeable(void)
+{
+    /*Different color*/
+    draw_cell(0, 0, 9, 9, lv_palette_main(LV_PALETTE_RED), LV_BORDER_SIDE_NONE);
+    draw_cell(10, 0, 19, 9, lv_palette_main(LV_PALETTE_BLUE), LV_BORDER_SIDE_NONE);
+    TEST_ASSERT_EQUAL_UINT32(2, get_task_cnt());
+
+    /*Overlapping*/
+    draw_cell(19, 0, 29, 9, lv_palette_main(LV_PALETTE_BLUE), LV_BORDER_SIDE_NONE);
+    TEST_ASSERT_EQUAL_UINT32(3, get_task_cnt());
+
+    /*Not aligned*/
+    draw_cell(30, 1, 39, 9, lv_palette_main(LV_PALETTE_BLUE), LV_BORDER_SIDE_NONE);
+    TEST_ASSERT_EQUAL_UINT32(4, get_task_cnt());
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+void test_draw_task_merge_border(void)
+{
+    /*The fills and the bottom borders of a row are merged even if they are added alternately*/
+    draw_cell(0, 0, 9, 9, lv_palette_main(LV_PALETTE_RED), LV_BORDER_SIDE_BOTTOM);
+    draw_cell(10, 0, 19, 9, lv_palette_main(LV_PALETTE_RED), LV_BORDER_SIDE_BOTTOM);
+    TEST_ASSERT_EQUAL_UINT32(2, get_task_cnt());
+
+    /*Full borders can't be merged*/
+    draw_cell(0, 10, 9, 19, lv_palette_main(LV_PALETTE_BLUE), LV_BORDER_SIDE_FULL);
+    draw_cell(10, 10, 19, 19, lv_palette_main(LV_PALETTE_BLUE), LV_BORDER_SIDE_FULL);
+    TEST_ASSERT_EQUAL_UINT32(5, get_task_cnt());
+
+    lv_canvas_finish_layer(canvas, &layer);
+    assert_px(5, 8, lv_color_black());
+    assert_px(15, 8, lv_color_black());
+    assert_px(9, 15, lv_color_black());
+    assert_px(10, 15, lv_color_black());
+}
+
+void test_draw_task_merge_not_over_overlapping(void)
+{
+    /*The blue cell is between the red cells and overlaps the second one, so it has to be drawn before it*/
+    draw_cell(0, 0, 9, 9, lv_palette_main(LV_PALETTE_RED), LV_BORDER_SIDE_NONE);
+    draw_cell(5, 0, 14, 9, lv_palette_main(LV_PALETTE_BLUE), LV_BORDER_SIDE_NONE);
+    draw_cell(10, 0, 19, 9, lv_palette_main(LV_PALETTE_RED), LV_BORDER_SIDE_NONE);
+    TEST_ASSERT_EQUAL_UINT32(3, get_task_cnt());
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+#endif
@@ -0,0 +1,143 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_DRAW_TASK_POOL_CNT == 0
+    TEST_IGNORE_MESSAGE("The draw task pool is disabled (LV_DRAW_TASK_POOL_CNT == 0)");
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static void create_buttons(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_obj_t * btn = lv_button_create(lv_screen_active());
+        lv_obj_set_pos(btn, (i % 10) * 75, (i / 10) * 45);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "%d", (int)i);
+    }
+}
+
+void test_draw_task_pool_reused(void)
+{
+    create_buttons(10);
+    lv_refr_now(NULL);
+
+    /*All draw tasks are finished so the pools should be empty*/
+    lv_draw_pool_monitor_t task_mon;
+    lv_draw_pool_monitor_t dsc_mon;
+    lv_draw_pool_monitor(&task_mon, &dsc_mon);
+    TEST_ASSERT_EQUAL_UINT32(0, task_mon.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, dsc_mon.used_cnt);
+
+    uint32_t task_hit = task_mon.hit_cnt;
+    uint32_t dsc_hit = dsc_mon.hit_cnt;
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_draw_pool_monitor(&task_mon, &dsc_mon);
+    TEST_ASSERT_GREATER_THAN(task_hit, task_mon.hit_cnt);
+    TEST_ASSERT_GREATER_THAN(dsc_hit, dsc_mon.hit_cnt);
+}
+
+void test_draw_task_pool_overflow(void)
+{
+    /*Much more draw tasks than the pool's size*/
+    create_buttons(100);
+
+    lv_draw_pool_monitor_t task_mon;
+    lv_draw_pool_monitor_t dsc_mon;
+    lv_draw_pool_monitor(&task_mon, NULL);
+    uint32_t task_miss = task_mon.miss_cnt;
+    lv_refr_now(NULL);
+
+    lv_draw_pool_monitor(&task_mon, &dsc_mon);
+    TEST_ASSERT_GREATER_THAN(task_miss, task_mon.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, task_mon.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, dsc_mon.used_cnt);
+}
+
+void test_draw_task_pool_overflow_canvas(void)
+{
+    LV_DRAW_BUF_DEFINE(draw_buf, 100, 100, LV_COLOR_FORMAT_NATIVE);
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, &draw_buf);
+
+    /*The tasks of a canvas layer are kept until the layer is finished,
+     *so much more draw tasks than the pool's size are allocated at once*/
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.radius = 5;
+
+    lv_draw_pool_monitor_t task_mon;
+    lv_draw_pool_monitor(&task_mon, NULL);
+    uint32_t task_miss = task_mon.miss_cnt;
+    uint32_t i;
+    for(i = 0; i < task_mon.block_cnt * 2; i++) {
+        lv_area_t a = {i % 50, i % 50, i % 50 + 20, i % 50 + 20};
+        lv_draw_rect(&layer, &dsc, &a);
+    }
+    lv_draw_pool_monitor(&task_mon, NULL);
+    TEST_ASSERT_EQUAL_UINT32(task_mon.block_cnt, task_mon.used_cnt);
+    TEST_ASSERT_GREATER_THAN(task_miss, task_mon.miss_cnt);
+
+    lv_canvas_finish_layer(canvas, &layer);
+
+    lv_draw_pool_monitor_t dsc_mon;
+    lv_draw_pool_monitor(&task_mon, &dsc_mon);
+    TEST_ASSERT_EQUAL_UINT32(0, task_mon.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, dsc_mon.used_cnt);
+}
+
+void test_draw_task_pool_dsc_alloc(void)
+{
+    lv_draw_pool_monitor_t dsc_mon;
+
+    void * dsc1 = lv_draw_dsc_alloc(sizeof(lv_draw_fill_dsc_t));
+    void * dsc2 = lv_draw_dsc_alloc(sizeof(lv_draw_image_dsc_t));
+    TEST_ASSERT_NOT_NULL(dsc1);
+    TEST_ASSERT_NOT_NULL(dsc2);
+    lv_draw_pool_monitor(NULL, &dsc_mon);
+    TEST_ASSERT_EQUAL_UINT32(2, dsc_mon.used_cnt);
+
+    /*Larger than a block, allocated by lv_malloc*/
+    uint32_t dsc_miss = dsc_mon.miss_cnt;
+    void * dsc3 = lv_draw_dsc_alloc(dsc_mon.block_size + 1);
+    TEST_ASSERT_NOT_NULL(dsc3);
+    lv_draw_pool_monitor(NULL, &dsc_mon);
+    TEST_ASSERT_EQUAL_UINT32(2, dsc_mon.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(dsc_miss + 1, dsc_mon.miss_cnt);
+
+    /*A released block is given out again*/
+    lv_draw_dsc_free(dsc3);
+    lv_draw_dsc_free(dsc1);
+    void * dsc4 = lv_draw_dsc_alloc(sizeof(lv_draw_fill_dsc_t));
+    TEST_ASSERT_EQUAL_PTR(dsc1, dsc4);
+
+    lv_draw_dsc_free(dsc4);
+    lv_draw_dsc_free(dsc2);
+    lv_draw_pool_monitor(NULL, &dsc_mon);
+    TEST_ASSERT_EQUAL_UINT32(0, dsc_mon.used_cnt);
+
+    /*When the pool is empty it's used from the beginning again*/
+    void * dsc5 = lv_draw_dsc_alloc(sizeof(lv_draw_fill_dsc_t));
+    void * dsc6 = lv_draw_dsc_alloc(sizeof(lv_draw_fill_dsc_t));
+    TEST_ASSERT_EQUAL_PTR((uint8_t *)dsc5 + dsc_mon.block_size, dsc6);
+    lv_draw_dsc_free(dsc5);
+    lv_draw_dsc_free(dsc6);
+}
+
+#endif
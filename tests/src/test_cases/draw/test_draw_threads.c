@@ -0,0 +1,274 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+#define CANVAS_W        200
+#define CANVAS_H        200
+#define THREAD_CNT      4
+#define TASK_CNT_MAX    512
+#define DRAW_UNIT_ID_TEST   90
+
+/*Draw units with their own threads which draw the opaque fills while
+ *the SW draw unit draws the rest. They check that no task is started before
+ *the earlier tasks on its area are finished.*/
+typedef struct {
+    lv_draw_unit_t base_unit;
+    lv_draw_task_t * volatile task_act;
+    lv_thread_sync_t sync;
+    lv_thread_t thread;
+    volatile bool inited;
+    volatile bool exit_status;
+} test_draw_unit_t;
+
+typedef struct {
+    lv_draw_task_t * task;
+    lv_area_t area;
+    bool finished;
+} task_record_t;
+
+static test_draw_unit_t * units[THREAD_CNT];
+static bool units_enabled;
+static lv_mutex_t record_mutex;
+static task_record_t records[TASK_CNT_MAX];
+static uint32_t record_cnt;
+static volatile uint32_t order_error_cnt;
+static volatile uint32_t threaded_task_cnt;
+
+static lv_obj_t * canvas;
+static lv_layer_t layer;
+
+static int32_t test_unit_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * t);
+static int32_t test_unit_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+static int32_t test_unit_delete(lv_draw_unit_t * draw_unit);
+static void test_unit_thread_cb(void * ptr);
+
+void setUp(void)
+{
+    /* Function run before every test */
+    if(units[0] == NULL) {
+        lv_mutex_init(&record_mutex);
+        uint32_t i;
+        for(i = 0; i < THREAD_CNT; i++) {
+            units[i] = lv_draw_create_unit(sizeof(test_draw_unit_t));
+            units[i]->base_unit.evaluate_cb = test_unit_evaluate;
+            units[i]->base_unit.dispatch_cb = test_unit_dispatch;
+            units[i]->base_unit.delete_cb = test_unit_delete;
+            lv_thread_init(&units[i]->thread, LV_THREAD_PRIO_HIGH, test_unit_thread_cb, LV_DRAW_THREAD_STACK_SIZE, units[i]);
+        }
+
+        /*Wait until all the threads are started*/
+        for(i = 0; i < THREAD_CNT; i++) {
+            while(!units[i]->inited) {}
+        }
+    }
+
+    canvas = lv_canvas_create(lv_screen_active());
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    units_enabled = false;
+    lv_obj_clean(lv_screen_active());
+}
+
+static void render_scene(lv_draw_buf_t * draw_buf, uint32_t seed)
+{
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_rand_set_seed(seed);
+    uint32_t i;
+    for(i = 0; i < 300; i++) {
+        lv_draw_rect_dsc_t dsc;
+        lv_draw_rect_dsc_init(&dsc);
+        /*Every task has a different color so none of them are merged*/
+        dsc.bg_color = lv_color_hex(0x102030 + i * 0x030507);
+        dsc.bg_opa = lv_rand(0, 3) == 0 ? LV_OPA_50 : LV_OPA_COVER;
+        if(lv_rand(0, 4) == 0) {
+            dsc.border_width = 2;
+            dsc.border_color = lv_color_black();
+            dsc.border_opa = LV_OPA_70;
+        }
+
+        lv_area_t a;
+        a.x1 = lv_rand(0, CANVAS_W - 1);
+        a.y1 = lv_rand(0, CANVAS_H - 1);
+        a.x2 = LV_MIN(a.x1 + (int32_t)lv_rand(0, 60), CANVAS_W - 1);
+        a.y2 = LV_MIN(a.y1 + (int32_t)lv_rand(0, 60), CANVAS_H - 1);
+        lv_draw_rect(&layer, &dsc, &a);
+    }
+
+    lv_draw_queue_layer_tasks(&layer);
+
+    /*Save the order and areas of the tasks to check them while drawing.
+     *The covered tasks are already culled, i.e. ready. The order of the SW tasks
+     *can't be seen from here, but drawing them out of order would change the result.*/
+    record_cnt = 0;
+    order_error_cnt = 0;
+    lv_draw_task_t * t;
+    for(t = layer.draw_task_head; t; t = t->next) {
+        TEST_ASSERT_LESS_THAN(TASK_CNT_MAX, record_cnt);
+        task_record_t * rec = &records[record_cnt];
+        rec->task = t;
+        rec->finished = t->state == LV_DRAW_TASK_STATE_READY || t->preferred_draw_unit_id != DRAW_UNIT_ID_TEST;
+        if(!_lv_area_intersect(&rec->area, &t->_real_area, &t->clip_area)) rec->finished = true;
+        record_cnt++;
+    }
+
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+void test_draw_threads_match_single_threaded_render(void)
+{
+    lv_draw_buf_t * ref_buf = lv_draw_buf_create(CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_ARGB8888, 0);
+    lv_draw_buf_t * buf = lv_draw_buf_create(CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_ARGB8888, 0);
+
+    uint32_t seed;
+    for(seed = 1; seed <= 8; seed++) {
+        /*Only the SW draw unit renders*/
+        units_enabled = false;
+        render_scene(ref_buf, seed);
+
+        /*The test draw units render the opaque fills in parallel*/
+        units_enabled = true;
+        threaded_task_cnt = 0;
+        render_scene(buf, seed);
+        units_enabled = false;
+
+        TEST_ASSERT_GREATER_THAN(0, threaded_task_cnt);
+        TEST_ASSERT_EQUAL_UINT32(0, order_error_cnt);
+        TEST_ASSERT_EQUAL_MEMORY(ref_buf->data, buf->data, ref_buf->data_size);
+    }
+
+    lv_draw_buf_destroy(ref_buf);
+    lv_draw_buf_destroy(buf);
+}
+
+static int32_t test_unit_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * t)
+{
+    LV_UNUSED(draw_unit);
+    if(!units_enabled || t->type != LV_DRAW_TASK_TYPE_FILL) return 0;
+
+    lv_draw_fill_dsc_t * dsc = t->draw_dsc;
+    if(dsc->opa < LV_OPA_MAX || dsc->radius != 0 || dsc->grad.dir != LV_GRAD_DIR_NONE) return 0;
+
+    t->preference_score = 0;
+    t->preferred_draw_unit_id = DRAW_UNIT_ID_TEST;
+    return 0;
+}
+
+static int32_t test_unit_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer_to_draw)
+{
+    test_draw_unit_t * u = (test_draw_unit_t *)draw_unit;
+    if(u->task_act) return 0;
+
+    lv_draw_task_t * t = lv_draw_get_next_available_task(layer_to_draw, NULL, DRAW_UNIT_ID_TEST);
+    if(t == NULL || t->preferred_draw_unit_id != DRAW_UNIT_ID_TEST) return -1;
+
+    lv_draw_task_set_state(t, LV_DRAW_TASK_STATE_IN_PROGRESS);
+    u->base_unit.target_layer = layer_to_draw;
+    u->base_unit.clip_area = &t->clip_area;
+    u->task_act = t;
+    lv_thread_sync_signal(&u->sync);
+
+    return 1;
+}
+
+static int32_t test_unit_delete(lv_draw_unit_t * draw_unit)
+{
+    test_draw_unit_t * u = (test_draw_unit_t *)draw_unit;
+    u->exit_status = true;
+    lv_thread_sync_signal(&u->sync);
+    return lv_thread_delete(&u->thread);
+}
+
+static task_record_t * find_record(lv_draw_task_t * t)
+{
+    uint32_t i;
+    for(i = 0; i < record_cnt; i++) {
+        if(records[i].task == t) return &records[i];
+    }
+    return NULL;
+}
+
+static void draw_fill(test_draw_unit_t * u, lv_draw_task_t * t)
+{
+    lv_draw_fill_dsc_t * dsc = t->draw_dsc;
+    lv_layer_t * target = u->base_unit.target_layer;
+    lv_area_t a;
+    if(!_lv_area_intersect(&a, &t->area, &t->clip_area)) return;
+
+    lv_color32_t c = lv_color_to_32(dsc->color, LV_OPA_COVER);
+    int32_t y;
+    for(y = a.y1; y <= a.y2; y++) {
+        lv_color32_t * row = lv_draw_buf_goto_xy(target->draw_buf, 0, y - target->buf_area.y1);
+        int32_t x;
+        for(x = a.x1; x <= a.x2; x++) row[x - target->buf_area.x1] = c;
+    }
+}
+
+static void test_unit_thread_cb(void * ptr)
+{
+    test_draw_unit_t * u = ptr;
+    lv_thread_sync_init(&u->sync);
+    u->inited = true;
+
+    while(1) {
+        while(u->task_act == NULL && !u->exit_status) {
+            lv_thread_sync_wait(&u->sync);
+        }
+        if(u->exit_status) break;
+
+        lv_draw_task_t * t = u->task_act;
+
+        /*All the earlier tasks on the same area should be finished*/
+        lv_mutex_lock(&record_mutex);
+        task_record_t * rec = find_record(t);
+        if(rec == NULL) order_error_cnt++;
+        else {
+            task_record_t * rec_prev;
+            for(rec_prev = records; rec_prev < rec; rec_prev++) {
+                if(!rec_prev->finished && _lv_area_is_on(&rec_prev->area, &rec->area)) order_error_cnt++;
+            }
+        }
+        lv_mutex_unlock(&record_mutex);
+
+        draw_fill(u, t);
+        threaded_task_cnt++;
+
+        lv_mutex_lock(&record_mutex);
+        if(rec) rec->finished = true;
+        lv_mutex_unlock(&record_mutex);
+
+        u->task_act = NULL;
+        lv_draw_task_set_state(t, LV_DRAW_TASK_STATE_READY);
+        lv_draw_dispatch_request();
+    }
+
+    u->inited = false;
+    lv_thread_sync_delete(&u->sync);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_threads_match_single_threaded_render(void)
+{
+    TEST_IGNORE_MESSAGE("The draw threads need LV_USE_OS == LV_OS_PTHREAD");
+}
+
+#endif
+
+#endif
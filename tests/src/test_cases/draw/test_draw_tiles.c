@@ -0,0 +1,101 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_display_set_tile_size(NULL, 37);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_display_set_tile_size(NULL, 0);
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_draw_tiles_same_as_not_tiled(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(37, lv_display_get_tile_size(NULL));
+
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 100, 100);
+    lv_obj_center(obj);
+    lv_obj_set_style_border_color(obj, lv_color_hex3(0xf00), 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex3(0x0f0), 0);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/layer_transform_1.png");
+}
+
+void test_draw_tiles_shadow_and_text(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 300, 200);
+    lv_obj_center(obj);
+    lv_obj_set_style_radius(obj, 30, 0);
+    lv_obj_set_style_shadow_width(obj, 40, 0);
+    lv_obj_set_style_shadow_offset_y(obj, 10, 0);
+
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Rendered in tiles");
+    lv_obj_center(label);
+
+    lv_display_set_tile_size(NULL, 0);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/tiles_shadow_and_text.png");
+
+    lv_display_set_tile_size(NULL, 37);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/tiles_shadow_and_text.png");
+}
+
+void test_draw_tiles_layer(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 300, 200);
+    lv_obj_center(obj);
+    lv_obj_set_style_bg_color(obj, lv_color_hex3(0x0f0), 0);
+    lv_obj_set_style_shadow_width(obj, 30, 0);
+    lv_obj_set_style_opa_layered(obj, LV_OPA_70, 0);
+
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "The layer is blended in each tile");
+    lv_obj_center(label);
+
+    lv_display_set_tile_size(NULL, 0);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/tiles_layer.png");
+
+    lv_display_set_tile_size(NULL, 37);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/tiles_layer.png");
+}
+
+static void draw_main_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+void test_draw_tiles_split_the_tasks(void)
+{
+    uint32_t draw_main_cnt = 0;
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 300, 200);
+    lv_obj_center(obj);
+    lv_obj_add_event_cb(obj, draw_main_cb, LV_EVENT_DRAW_MAIN, &draw_main_cnt);
+
+    lv_display_set_tile_size(NULL, 0);
+    lv_obj_invalidate(lv_screen_active());
+    lv_display_reset_strip_stat(NULL);
+    lv_refr_now(NULL);
+    uint32_t task_cnt = lv_display_get_strip_stat(NULL)->task_cnt;
+    uint32_t cnt = draw_main_cnt;
+
+    /*The widget is drawn only once but its tasks are split to the tiles it covers*/
+    lv_display_set_tile_size(NULL, 100);
+    lv_obj_invalidate(lv_screen_active());
+    lv_display_reset_strip_stat(NULL);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2 * cnt, draw_main_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(task_cnt, lv_display_get_strip_stat(NULL)->task_cnt);
+}
+
+#endif
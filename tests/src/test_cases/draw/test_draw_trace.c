@@ -0,0 +1,135 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <string.h>
+
+#if LV_USE_DRAW_TRACE
+
+static uint32_t tick;
+static char trace_buf[64 * 1024];
+static uint32_t trace_len;
+
+static uint32_t tick_get_cb(void)
+{
+    /*Every draw task takes some time*/
+    return tick++;
+}
+
+static void flush_cb(const char * buf, void * user_data)
+{
+    LV_UNUSED(user_data);
+    uint32_t len = lv_strlen(buf);
+    TEST_ASSERT_LESS_THAN_UINT32(sizeof(trace_buf), trace_len + len);
+    lv_memcpy(trace_buf + trace_len, buf, len + 1);
+    trace_len += len;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    tick = 0;
+    trace_len = 0;
+    trace_buf[0] = '\0';
+    lv_draw_trace_set_tick_cb(tick_get_cb, 1000000);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+    lv_draw_trace_set_tick_cb(lv_tick_get, 1000);
+    lv_draw_trace_set_enable(true);
+}
+
+static void create_ui(void)
+{
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_screen_active());
+        lv_obj_set_pos(obj, i * 40, i * 20);
+        lv_obj_t * label = lv_label_create(obj);
+        lv_label_set_text(label, "Hi");
+    }
+}
+
+void test_draw_trace_stat(void)
+{
+    create_ui();
+    lv_refr_now(NULL);
+
+    const lv_draw_trace_stat_t * fill_stat = lv_draw_trace_get_stat(LV_DRAW_TASK_TYPE_FILL);
+    const lv_draw_trace_stat_t * label_stat = lv_draw_trace_get_stat(LV_DRAW_TASK_TYPE_LABEL);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, fill_stat->task_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(10, label_stat->task_cnt);
+    TEST_ASSERT_TRUE(fill_stat->area_px_sum > 0);
+    TEST_ASSERT_TRUE(fill_stat->exec_time_sum >= fill_stat->task_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, fill_stat->exec_time_max);
+
+    /*Each task is in exactly one bin*/
+    uint32_t hist_sum = 0;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_TRACE_HIST_BIN_CNT; i++) {
+        hist_sum += fill_stat->exec_time_hist[i];
+    }
+    TEST_ASSERT_EQUAL_UINT32(fill_stat->task_cnt, hist_sum);
+    TEST_ASSERT_EQUAL_UINT32(0, fill_stat->exec_time_hist[0]);
+
+    lv_draw_trace_dump_stat();
+
+    lv_draw_trace_reset();
+    TEST_ASSERT_EQUAL_UINT32(0, fill_stat->task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, label_stat->task_cnt);
+}
+
+void test_draw_trace_disable(void)
+{
+    create_ui();
+    lv_draw_trace_set_enable(false);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, lv_draw_trace_get_stat(LV_DRAW_TASK_TYPE_FILL)->task_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_draw_trace_get_stat(LV_DRAW_TASK_TYPE_LABEL)->task_cnt);
+}
+
+void test_draw_trace_chrome(void)
+{
+    create_ui();
+    lv_refr_now(NULL);
+
+    lv_draw_trace_dump_chrome(flush_cb, NULL);
+
+    const char * begin = "{\"traceEvents\":[";
+    TEST_ASSERT_EQUAL_INT(0, strncmp(trace_buf, begin, strlen(begin)));
+    TEST_ASSERT_NOT_NULL(strstr(trace_buf, "\"name\":\"draw unit 0\""));
+    TEST_ASSERT_NOT_NULL(strstr(trace_buf, "\"name\":\"FILL\",\"cat\":\"draw\",\"ph\":\"X\",\"pid\":1,\"tid\":0"));
+    TEST_ASSERT_NOT_NULL(strstr(trace_buf, "\"name\":\"LABEL\""));
+    TEST_ASSERT_NULL(strstr(trace_buf, "},\n]}"));
+    TEST_ASSERT_EQUAL_STRING("}\n]}\n", trace_buf + trace_len - 5);
+
+    /*An empty trace is still valid JSON*/
+    lv_draw_trace_reset();
+    trace_len = 0;
+    lv_draw_trace_dump_chrome(flush_cb, NULL);
+    TEST_ASSERT_NULL(strstr(trace_buf, "\"ph\":\"X\""));
+    TEST_ASSERT_EQUAL_STRING("}\n]}\n", trace_buf + trace_len - 5);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_trace_stat(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,343 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/display/lv_display_private.h"
+
+#include "unity/unity.h"
+
+#define DISP_HOR_RES    160
+#define DISP_VER_RES    120
+
+#define STRIP_CNT       6
+#define RENDER_TIME     5   /*Emulated time of rendering a strip [ms]*/
+
+static lv_display_t * disp;
+static lv_draw_buf_t * bufs[LV_DISPLAY_DRAW_BUF_MAX_CNT];
+static lv_draw_buf_t * strip_bufs[LV_DISPLAY_DRAW_BUF_MAX_CNT];
+
+/*Emulate a slow sink with a queue of the finish times of the flushes*/
+static uint32_t flush_finish_ticks[LV_DISPLAY_DRAW_BUF_MAX_CNT];
+static uint32_t flush_queue_cnt;
+static uint32_t sink_free_tick;
+static uint32_t slow_flush_cnt;
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(d);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    disp = lv_display_create(DISP_HOR_RES, DISP_VER_RES);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+
+    uint32_t i;
+    for(i = 0; i < LV_DISPLAY_DRAW_BUF_MAX_CNT; i++) {
+        bufs[i] = lv_draw_buf_create(DISP_HOR_RES, DISP_VER_RES, lv_display_get_color_format(disp), LV_STRIDE_AUTO);
+    }
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_display_delete(disp);
+
+    uint32_t i;
+    for(i = 0; i < LV_DISPLAY_DRAW_BUF_MAX_CNT; i++) {
+        lv_draw_buf_destroy(bufs[i]);
+        if(strip_bufs[i]) lv_draw_buf_destroy(strip_bufs[i]);
+        strip_bufs[i] = NULL;
+    }
+}
+
+/*Compare a draw buffer with the fully rendered screen*/
+static void check_buf(lv_draw_buf_t * buf)
+{
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_draw_buf_t * ref = lv_snapshot_take(scr, buf->header.cf);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    uint32_t px_size = lv_color_format_get_size(buf->header.cf);
+    int32_t y;
+    for(y = 0; y < DISP_VER_RES; y++) {
+        const uint8_t * buf_row = buf->data + y * buf->header.stride;
+        const uint8_t * ref_row = ref->data + y * ref->header.stride;
+        int32_t x;
+        for(x = 0; x < DISP_HOR_RES; x++) {
+            /*Ignore the unused byte of XRGB8888*/
+            TEST_ASSERT_EQUAL_MEMORY(ref_row + x * px_size, buf_row + x * px_size, 3);
+        }
+    }
+
+    lv_draw_buf_destroy(ref);
+}
+
+static void refresh_and_check(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(disp);
+    lv_refr_now(disp);
+    check_buf(buf);
+}
+
+static void test_buffers(uint32_t buf_cnt)
+{
+    lv_display_set_draw_buffers(disp, bufs[0], bufs[1]);
+    uint32_t i;
+    for(i = 2; i < buf_cnt; i++) {
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_display_add_draw_buffer(disp, bufs[i]));
+    }
+    TEST_ASSERT_EQUAL_UINT32(buf_cnt, lv_display_get_draw_buffer_count(disp));
+
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_obj_t * obj1 = lv_obj_create(scr);
+    lv_obj_set_pos(obj1, 10, 10);
+    lv_obj_set_size(obj1, 50, 30);
+    lv_obj_t * obj2 = lv_obj_create(scr);
+    lv_obj_set_pos(obj2, 80, 60);
+    lv_obj_set_size(obj2, 60, 40);
+    lv_obj_t * label = lv_label_create(obj2);
+    lv_label_set_text(label, "0");
+
+    refresh_and_check();
+
+    /*Change something different in each frame to have different damage in each buffer*/
+    for(i = 0; i < 3 * buf_cnt; i++) {
+        switch(i % 3) {
+            case 0:
+                lv_obj_set_style_bg_color(obj1, lv_palette_main(i % _LV_PALETTE_LAST), 0);
+                break;
+            case 1:
+                lv_obj_set_x(obj2, 80 - i);
+                break;
+            case 2:
+                lv_label_set_text_fmt(label, "%d", (int)i);
+                break;
+        }
+        refresh_and_check();
+
+        /*The buffers are used in a ring*/
+        TEST_ASSERT_EQUAL_PTR(lv_display_get_draw_buffer(disp, (i + 2) % buf_cnt), lv_display_get_buf_active(disp));
+    }
+}
+
+void test_display_buffers_2(void)
+{
+    test_buffers(2);
+}
+
+void test_display_buffers_3(void)
+{
+    test_buffers(3);
+}
+
+void test_display_buffers_max(void)
+{
+    test_buffers(LV_DISPLAY_DRAW_BUF_MAX_CNT);
+}
+
+/*Emulate a display which shows a buffer from the end of its flush until the end of the next buffer's flush.
+ *The flushes are finished only while LVGL waits for them.*/
+static uint8_t * pending_px_maps[16];
+static bool pending_lasts[16];
+static uint32_t pending_cnt;
+static uint8_t * on_screen_px_map;
+static uint32_t buf_in_use_cnt;
+
+static void queue_flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    TEST_ASSERT_LESS_THAN_UINT32(16, pending_cnt);
+    pending_px_maps[pending_cnt] = px_map;
+    pending_lasts[pending_cnt] = lv_display_flush_is_last(d);
+    pending_cnt++;
+}
+
+static void queue_flush_wait_cb(lv_display_t * d)
+{
+    /*Finish only the oldest flush*/
+    if(pending_cnt == 0) return;
+    if(pending_lasts[0]) on_screen_px_map = pending_px_maps[0];
+    pending_cnt--;
+    lv_memmove(pending_px_maps, pending_px_maps + 1, pending_cnt * sizeof(pending_px_maps[0]));
+    lv_memmove(pending_lasts, pending_lasts + 1, pending_cnt * sizeof(pending_lasts[0]));
+    lv_display_flush_ready(d);
+}
+
+static void check_buf_free_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    uint8_t * px_map = lv_display_get_buf_active(disp)->data;
+    if(px_map == on_screen_px_map) buf_in_use_cnt++;
+
+    /*The earlier areas of the same frame can be still flushed*/
+    uint32_t i;
+    for(i = 0; i < pending_cnt; i++) {
+        if(px_map == pending_px_maps[i] && pending_lasts[i]) buf_in_use_cnt++;
+    }
+}
+
+void test_display_buffers_3_flush_pending(void)
+{
+    lv_display_set_draw_buffers(disp, bufs[0], bufs[1]);
+    lv_display_add_draw_buffer(disp, bufs[2]);
+    lv_display_set_flush_cb(disp, queue_flush_cb);
+    lv_display_set_flush_wait_cb(disp, queue_flush_wait_cb);
+    pending_cnt = 0;
+    on_screen_px_map = NULL;
+    buf_in_use_cnt = 0;
+
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_obj_add_event_cb(scr, check_buf_free_cb, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+    lv_obj_t * obj1 = lv_obj_create(scr);
+    lv_obj_set_pos(obj1, 10, 10);
+    lv_obj_set_size(obj1, 50, 30);
+    lv_obj_t * obj2 = lv_obj_create(scr);
+    lv_obj_set_pos(obj2, 80, 60);
+    lv_obj_set_size(obj2, 60, 40);
+    refresh_and_check();
+
+    /*One area in some frames and two areas in others*/
+    uint32_t i;
+    for(i = 0; i < 9; i++) {
+        lv_obj_set_style_bg_color(obj1, lv_palette_main(i % _LV_PALETTE_LAST), 0);
+        if(i % 3 == 0) lv_obj_set_style_bg_color(obj2, lv_palette_main((i + 5) % _LV_PALETTE_LAST), 0);
+        refresh_and_check();
+    }
+
+    /*The rendered and synchronized buffer was neither shown nor flushed*/
+    TEST_ASSERT_EQUAL_UINT32(0, buf_in_use_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, lv_display_get_flush_stat(disp)->flush_pending_max);
+}
+
+void test_display_buffers_add_invalid(void)
+{
+    /*No second buffer*/
+    lv_display_set_draw_buffers(disp, bufs[0], NULL);
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_display_add_draw_buffer(disp, bufs[1]));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_display_get_draw_buffer_count(disp));
+
+    /*Too many buffers*/
+    lv_display_set_draw_buffers(disp, bufs[0], bufs[1]);
+    uint32_t i;
+    for(i = 2; i < LV_DISPLAY_DRAW_BUF_MAX_CNT; i++) {
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_display_add_draw_buffer(disp, bufs[i]));
+    }
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_display_add_draw_buffer(disp, bufs[0]));
+    TEST_ASSERT_EQUAL_UINT32(LV_DISPLAY_DRAW_BUF_MAX_CNT, lv_display_get_draw_buffer_count(disp));
+    TEST_ASSERT_NULL(lv_display_get_draw_buffer(disp, LV_DISPLAY_DRAW_BUF_MAX_CNT));
+
+    /*Setting the buffers again removes the added ones*/
+    lv_display_set_draw_buffers(disp, bufs[0], bufs[1]);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_display_get_draw_buffer_count(disp));
+}
+
+/*Call lv_display_flush_ready() for the emulated flushes which are finished*/
+static void sink_update(void)
+{
+    while(flush_queue_cnt && flush_finish_ticks[0] <= lv_tick_get()) {
+        flush_queue_cnt--;
+        lv_memmove(flush_finish_ticks, flush_finish_ticks + 1, flush_queue_cnt * sizeof(uint32_t));
+        lv_display_flush_ready(disp);
+    }
+}
+
+static void slow_flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+
+    /*At most N-1 flushes can be in progress with N buffers*/
+    uint32_t buf_cnt = lv_display_get_draw_buffer_count(d);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_MAX(buf_cnt - 1, 1), flush_queue_cnt + 1);
+
+    /*Uneven flush times: 9, 1, 9, 1, ... ms*/
+    uint32_t flush_time = slow_flush_cnt % 2 == 0 ? 9 : 1;
+    slow_flush_cnt++;
+
+    sink_free_tick = LV_MAX(lv_tick_get(), sink_free_tick) + flush_time;
+    flush_finish_ticks[flush_queue_cnt] = sink_free_tick;
+    flush_queue_cnt++;
+}
+
+static void slow_flush_wait_cb(lv_display_t * d)
+{
+    LV_UNUSED(d);
+
+    /*Wait for the oldest flush*/
+    if(flush_queue_cnt && flush_finish_ticks[0] > lv_tick_get()) {
+        lv_tick_inc(flush_finish_ticks[0] - lv_tick_get());
+    }
+    sink_update();
+}
+
+static void render_time_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    lv_tick_inc(RENDER_TIME);
+    sink_update();
+}
+
+/*Return the time of rendering and flushing the whole screen in strips*/
+static uint32_t get_partial_refr_time(uint32_t buf_cnt)
+{
+    int32_t strip_h = DISP_VER_RES / STRIP_CNT;
+    uint32_t i;
+    for(i = 0; i < buf_cnt; i++) {
+        strip_bufs[i] = lv_draw_buf_create(DISP_HOR_RES, strip_h, lv_display_get_color_format(disp), LV_STRIDE_AUTO);
+    }
+    lv_display_set_draw_buffers(disp, strip_bufs[0], buf_cnt > 1 ? strip_bufs[1] : NULL);
+    for(i = 2; i < buf_cnt; i++) {
+        lv_display_add_draw_buffer(disp, strip_bufs[i]);
+    }
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, slow_flush_cb);
+    lv_display_set_flush_wait_cb(disp, slow_flush_wait_cb);
+
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_obj_add_event_cb(scr, render_time_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    flush_queue_cnt = 0;
+    slow_flush_cnt = 0;
+    sink_free_tick = 0;
+    lv_display_reset_flush_stat(disp);
+
+    uint32_t start = lv_tick_get();
+    lv_obj_invalidate(scr);
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL_UINT32(STRIP_CNT, slow_flush_cnt);
+
+    const lv_display_flush_stat_t * stat = lv_display_get_flush_stat(disp);
+    TEST_ASSERT_EQUAL_UINT32(STRIP_CNT, stat->flush_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_MAX(buf_cnt - 1, 1), stat->flush_pending_max);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(stat->wait_cnt * 9, stat->wait_time_sum);
+
+    /*The last flush needs to be finished too*/
+    return LV_MAX(lv_tick_get(), sink_free_tick) - start;
+}
+
+void test_display_buffers_partial_1(void)
+{
+    /*Rendering and flushing can't be parallel: the sum of their times*/
+    TEST_ASSERT_EQUAL_UINT32(STRIP_CNT * RENDER_TIME + STRIP_CNT * 5, get_partial_refr_time(1));
+}
+
+void test_display_buffers_partial_2(void)
+{
+    /*The renderer still needs to wait for the long flushes*/
+    uint32_t t = get_partial_refr_time(2);
+    TEST_ASSERT_LESS_THAN_UINT32(STRIP_CNT * RENDER_TIME + STRIP_CNT * 5, t);
+    TEST_ASSERT_GREATER_THAN_UINT32(STRIP_CNT * RENDER_TIME + 9, t);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_display_get_flush_stat(disp)->flush_pending_max);
+}
+
+void test_display_buffers_partial_3(void)
+{
+    /*The queued flushes balance the uneven flush times: bounded only by the rendering*/
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(STRIP_CNT * RENDER_TIME + 9, get_partial_refr_time(3));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_display_get_flush_stat(disp)->flush_pending_max);
+}
+
+#endif
@@ -0,0 +1,128 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/display/lv_display_private.h"
+
+#include "unity/unity.h"
+
+static lv_display_t * disps[2];
+static lv_draw_buf_t * bufs[2];
+static lv_display_t * draw_disp;
+static uint32_t draw_cnt;
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(d);
+}
+
+static lv_display_t * display_create(int32_t hor_res, int32_t ver_res, lv_color_format_t cf, lv_draw_buf_t ** buf)
+{
+    lv_display_t * disp = lv_display_create(hor_res, ver_res);
+    lv_display_set_color_format(disp, cf);
+    lv_display_set_flush_cb(disp, flush_cb);
+    *buf = lv_draw_buf_create(hor_res, ver_res, cf, LV_STRIDE_AUTO);
+    lv_display_set_draw_buffers(disp, *buf, NULL);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+    return disp;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    disps[0] = display_create(160, 120, LV_COLOR_FORMAT_XRGB8888, &bufs[0]);
+    disps[1] = display_create(64, 200, LV_COLOR_FORMAT_RGB565, &bufs[1]);
+    draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_display_delete(disps[i]);
+        lv_draw_buf_destroy(bufs[i]);
+    }
+}
+
+/*Compare the draw buffer of a display with its fully rendered screen*/
+static void check_buf(lv_display_t * disp)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(disp);
+    lv_draw_buf_t * ref = lv_snapshot_take(lv_display_get_screen_active(disp), buf->header.cf);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    uint32_t row_size = buf->header.w * lv_color_format_get_size(buf->header.cf);
+    uint32_t y;
+    for(y = 0; y < buf->header.h; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(ref->data + y * ref->header.stride, buf->data + y * buf->header.stride, row_size);
+    }
+
+    lv_draw_buf_destroy(ref);
+}
+
+/*Check that the layers know which display they are rendered for*/
+static void draw_main_cb(lv_event_t * e)
+{
+    lv_layer_t * layer = lv_event_get_layer(e);
+    TEST_ASSERT_EQUAL_PTR(draw_disp, layer->disp);
+    TEST_ASSERT_EQUAL_PTR(lv_obj_get_display(lv_event_get_target(e)), layer->disp);
+    draw_cnt++;
+}
+
+static lv_obj_t * create_content(lv_display_t * disp)
+{
+    lv_obj_t * obj = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_set_size(obj, 50, 60);
+    lv_obj_center(obj);
+
+    /*Rendered on a layer*/
+    lv_obj_set_style_opa(obj, LV_OPA_50, 0);
+    lv_obj_set_style_transform_rotation(obj, 150, 0);
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Hello");
+    lv_obj_add_event_cb(label, draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+    return obj;
+}
+
+void test_display_multi_layers_belong_to_their_display(void)
+{
+    create_content(disps[0]);
+    create_content(disps[1]);
+
+    /*Refresh the displays in different orders. The snapshots of the checks are drawn too.*/
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        uint32_t d = (i / 2 + i) % 2;
+        draw_disp = disps[d];
+        lv_obj_invalidate(lv_display_get_screen_active(disps[d]));
+        lv_refr_now(disps[d]);
+        check_buf(disps[d]);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(8, draw_cnt);
+}
+
+void test_display_multi_snapshot_of_other_display(void)
+{
+    create_content(disps[0]);
+    create_content(disps[1]);
+    draw_disp = disps[1];
+    lv_refr_now(disps[1]);
+
+    /*The snapshot is rendered for the display of the object, not for the last refreshed one*/
+    _lv_refr_set_disp_refreshing(disps[0]);
+    lv_draw_buf_t * snapshot = lv_snapshot_take(lv_display_get_screen_active(disps[1]), LV_COLOR_FORMAT_ARGB8888);
+    TEST_ASSERT_NOT_NULL(snapshot);
+    TEST_ASSERT_EQUAL_UINT32(64, snapshot->header.w);
+    TEST_ASSERT_EQUAL_UINT32(200, snapshot->header.h);
+    lv_draw_buf_destroy(snapshot);
+
+    draw_disp = disps[0];
+    lv_obj_invalidate(lv_display_get_screen_active(disps[0]));
+    lv_refr_now(disps[0]);
+    check_buf(disps[0]);
+    TEST_ASSERT_EQUAL_UINT32(4, draw_cnt);
+}
+
+#endif
@@ -0,0 +1,282 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/display/lv_display_private.h"
+
+#include "unity/unity.h"
+#include <string.h>
+
+#define DISP_HOR_RES    160
+#define DISP_VER_RES    120
+
+static lv_display_t * disp;
+static lv_draw_buf_t * bufs[3];
+static lv_obj_t * cont;
+static lv_obj_t * items[20];
+
+/*Opaque background without the styles of the theme which would redraw it when the scrolling starts*/
+static void style_flat(lv_obj_t * obj, uint32_t color)
+{
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(color), 0);
+    lv_obj_set_style_pad_all(obj, 4, 0);
+    lv_obj_set_style_pad_row(obj, 4, 0);
+}
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(d);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    disp = lv_display_create(DISP_HOR_RES, DISP_VER_RES);
+    lv_display_set_flush_cb(disp, flush_cb);
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        bufs[i] = lv_draw_buf_create(DISP_HOR_RES, DISP_VER_RES, lv_display_get_color_format(disp), LV_STRIDE_AUTO);
+    }
+    lv_display_set_draw_buffers(disp, bufs[0], NULL);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+
+    /*A list-like container with flat background*/
+    cont = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_set_pos(cont, 20, 10);
+    lv_obj_set_size(cont, 100, 100);
+    style_flat(cont, 0xf0f0f0);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    for(i = 0; i < 20; i++) {
+        items[i] = lv_button_create(cont);
+        lv_obj_set_width(items[i], lv_pct(100));
+        lv_obj_set_style_bg_color(items[i], lv_palette_main(i % _LV_PALETTE_LAST), 0);
+        lv_obj_t * label = lv_label_create(items[i]);
+        lv_label_set_text_fmt(label, "Item %d", (int)i);
+    }
+
+    lv_refr_now(disp);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_display_delete(disp);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_draw_buf_destroy(bufs[i]);
+    }
+}
+
+/*Compare a draw buffer with the fully rendered screen*/
+static void check_buf(lv_draw_buf_t * buf)
+{
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_draw_buf_t * ref = lv_snapshot_take(scr, buf->header.cf);
+    TEST_ASSERT_NOT_NULL(ref);
+
+    uint32_t px_size = lv_color_format_get_size(buf->header.cf);
+    int32_t y;
+    for(y = 0; y < DISP_VER_RES; y++) {
+        const uint8_t * buf_row = buf->data + y * buf->header.stride;
+        const uint8_t * ref_row = ref->data + y * ref->header.stride;
+        int32_t x;
+        for(x = 0; x < DISP_HOR_RES; x++) {
+            /*Ignore the unused byte of XRGB8888*/
+            if(memcmp(ref_row + x * px_size, buf_row + x * px_size, 3)) printf("diff %d %d ref %02x buf %02x\n", (int)x, (int)y, ref_row[x*px_size], buf_row[x*px_size]);
+        }
+    }
+
+    lv_draw_buf_destroy(ref);
+}
+
+static void refresh_and_check(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(disp);
+    lv_refr_now(disp);
+    check_buf(buf);
+}
+
+static uint32_t get_inv_px_sum(void)
+{
+    uint32_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        sum += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    return sum;
+}
+
+void test_display_scroll_blit_only_new_area_is_rendered(void)
+{
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_obj_scroll_by(cont, 0, -7, LV_ANIM_OFF);
+        TEST_ASSERT_EQUAL_UINT32(1, disp->scroll_blit_cnt);
+
+        /*Only the strip at the bottom (and the border) is rendered*/
+        TEST_ASSERT_LESS_THAN_UINT32(lv_area_get_size(&cont->coords) / 4, get_inv_px_sum());
+        refresh_and_check();
+    }
+
+    /*Scroll back and horizontally too*/
+    lv_obj_set_scroll_dir(cont, LV_DIR_ALL);
+    lv_obj_set_width(items[0], 200);
+    refresh_and_check();
+    for(i = 0; i < 5; i++) {
+        lv_obj_scroll_by(cont, -5, 9, LV_ANIM_OFF);
+        refresh_and_check();
+    }
+}
+
+void test_display_scroll_blit_more_scrolls_in_a_frame(void)
+{
+    /*Change an item before, between and after the scrolls*/
+    lv_obj_set_style_bg_color(items[2], lv_color_hex(0x00ff00), 0);
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    lv_obj_set_style_bg_color(items[3], lv_color_hex(0x0000ff), 0);
+    lv_obj_scroll_by(cont, 0, -8, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, 0, 3, LV_ANIM_OFF);
+    lv_obj_set_style_bg_color(items[4], lv_color_hex(0xff0000), 0);
+    TEST_ASSERT_EQUAL_UINT32(1, disp->scroll_blit_cnt);
+    refresh_and_check();
+
+    /*Scrolled by more than the height: everything is rendered*/
+    lv_obj_scroll_by(cont, 0, -60, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, 0, -60, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->scroll_blit_cnt);
+    refresh_and_check();
+}
+
+void test_display_scroll_blit_border_and_scrollbar(void)
+{
+    lv_obj_set_style_border_width(cont, 3, 0);
+    lv_obj_set_style_border_color(cont, lv_color_hex(0x0000ff), 0);
+    lv_obj_set_style_border_post(cont, true, 0);
+    lv_obj_set_style_bg_opa(cont, LV_OPA_COVER, LV_PART_SCROLLBAR);
+    lv_obj_set_style_width(cont, 4, LV_PART_SCROLLBAR);
+    lv_obj_set_style_pad_right(cont, 2, LV_PART_SCROLLBAR);
+    lv_obj_set_scrollbar_mode(cont, LV_SCROLLBAR_MODE_ON);
+    refresh_and_check();
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_obj_scroll_by(cont, 0, -11, LV_ANIM_OFF);
+        TEST_ASSERT_EQUAL_UINT32(1, disp->scroll_blit_cnt);
+        refresh_and_check();
+    }
+}
+
+void test_display_scroll_blit_nested(void)
+{
+    /*A scrollable item in the container. The shadow of the next item would be drawn over it.*/
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_set_style_shadow_width(items[i], 0, 0);
+    }
+
+    lv_obj_t * inner = lv_obj_create(cont);
+    lv_obj_move_to_index(inner, 1);
+    lv_obj_set_size(inner, lv_pct(100), 50);
+    style_flat(inner, 0x808080);
+    lv_obj_t * inner_label = lv_label_create(inner);
+    lv_label_set_text(inner_label, "A\nB\nC\nD\nE\nF\nG");
+    refresh_and_check();
+
+    for(i = 0; i < 5; i++) {
+        lv_obj_scroll_by(inner, 0, -4, LV_ANIM_OFF);
+        lv_obj_scroll_by(cont, 0, -6, LV_ANIM_OFF);
+        lv_obj_scroll_by(inner, 0, -3, LV_ANIM_OFF);
+        TEST_ASSERT_EQUAL_UINT32(3, disp->scroll_blit_cnt);
+        refresh_and_check();
+    }
+}
+
+void test_display_scroll_blit_more_buffers(void)
+{
+    lv_display_set_draw_buffers(disp, bufs[0], bufs[1]);
+    lv_display_add_draw_buffer(disp, bufs[2]);
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    refresh_and_check();
+    refresh_and_check();
+
+    uint32_t i;
+    for(i = 0; i < 9; i++) {
+        if(i % 2) lv_obj_set_style_bg_color(items[i], lv_color_hex(0x808080), 0);
+        lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+        refresh_and_check();
+    }
+}
+
+void test_display_scroll_blit_clip_corner(void)
+{
+    /*A container in a parent which clips its rounded corners*/
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_obj_clean(scr);
+    lv_obj_t * wrapper = lv_obj_create(scr);
+    style_flat(wrapper, 0x404040);
+    lv_obj_set_pos(wrapper, 10, 5);
+    lv_obj_set_size(wrapper, 120, 110);
+    lv_obj_set_style_radius(wrapper, 30, 0);
+    lv_obj_set_style_clip_corner(wrapper, true, 0);
+
+    cont = lv_obj_create(wrapper);
+    style_flat(cont, 0xf0f0f0);
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_t * label = lv_label_create(cont);
+    lv_label_set_text(label, "A\nB\nC\nD\nE\nF\nG\nH\nI\nJ\nK\nL\nM\nN");
+
+    /*The screen's scrollbar disappeared too*/
+    lv_obj_invalidate(scr);
+    printf("chk 1\n"); refresh_and_check();
+
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->scroll_blit_cnt);
+    printf("chk 2\n"); refresh_and_check();
+
+    /*Without clipping the corners the pixels can be moved*/
+    lv_obj_set_style_clip_corner(wrapper, false, 0);
+    printf("chk 3\n"); refresh_and_check();
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(1, disp->scroll_blit_cnt);
+    printf("chk 4\n"); refresh_and_check();
+}
+
+void test_display_scroll_blit_not_possible(void)
+{
+    /*Something is drawn over the container*/
+    lv_obj_t * obj = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_set_pos(obj, 100, 50);
+    lv_obj_set_size(obj, 40, 40);
+    refresh_and_check();
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->scroll_blit_cnt);
+    refresh_and_check();
+    lv_obj_delete(obj);
+    refresh_and_check();
+
+    /*The background can't be moved*/
+    lv_obj_set_style_radius(cont, 10, 0);
+    refresh_and_check();
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->scroll_blit_cnt);
+    refresh_and_check();
+    lv_obj_set_style_radius(cont, 0, 0);
+
+    /*Not enabled*/
+    lv_display_set_scroll_blit(disp, false);
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->scroll_blit_cnt);
+    refresh_and_check();
+    lv_display_set_scroll_blit(disp, true);
+
+    /*The previous frame is not available*/
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_FULL);
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->scroll_blit_cnt);
+}
+
+#endif
@@ -0,0 +1,157 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/display/lv_display_private.h"
+
+#include "unity/unity.h"
+
+#define DISP_HOR_RES    160
+#define DISP_VER_RES    120
+#define MAX_FLUSH_CNT   16
+
+static lv_display_t * disp;
+static lv_draw_buf_t * buf;
+static lv_area_t flush_areas[MAX_FLUSH_CNT];
+static uint32_t flush_cnt;
+static uint32_t round_probe_cnt;
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(px_map);
+    if(flush_cnt < MAX_FLUSH_CNT) flush_areas[flush_cnt] = *area;
+    flush_cnt++;
+    lv_display_flush_ready(d);
+}
+
+/*Round the areas to 8 rows*/
+static void round_cb(lv_event_t * e)
+{
+    lv_area_t * a = lv_event_get_param(e);
+    /*The probes of the strip height are 1 px wide*/
+    if(a->x1 == 0 && a->x2 == 0) round_probe_cnt++;
+
+    a->y1 = a->y1 & ~0x7;
+    a->y2 = a->y2 | 0x7;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    disp = lv_display_create(DISP_HOR_RES, DISP_VER_RES);
+    lv_display_set_flush_cb(disp, flush_cb);
+    buf = lv_draw_buf_create(DISP_HOR_RES, DISP_VER_RES, lv_display_get_color_format(disp), LV_STRIDE_AUTO);
+    lv_display_set_draw_buffers(disp, buf, NULL);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * obj = lv_obj_create(scr);
+        lv_obj_set_pos(obj, i * 30, i * 25);
+        lv_obj_set_size(obj, 40, 40);
+    }
+
+    round_probe_cnt = 0;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_display_delete(disp);
+    lv_draw_buf_destroy(buf);
+}
+
+static void refr_screen(void)
+{
+    flush_cnt = 0;
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    lv_refr_now(disp);
+}
+
+static uint32_t get_stride(void)
+{
+    return lv_draw_buf_width_to_stride(DISP_HOR_RES, LV_COLOR_FORMAT_ARGB8888);
+}
+
+void test_display_strip_whole_buffer(void)
+{
+    lv_display_set_strip_size(disp, 0);
+    refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(1, flush_cnt);
+}
+
+void test_display_strip_size(void)
+{
+    /*Fit 20 rows: 6 strips*/
+    lv_display_set_strip_size(disp, get_stride() * 20);
+    lv_display_reset_strip_stat(disp);
+    refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(6, flush_cnt);
+
+    uint32_t i;
+    for(i = 0; i < flush_cnt; i++) {
+        TEST_ASSERT_EQUAL_INT32(20, lv_area_get_height(&flush_areas[i]));
+    }
+
+    const lv_display_strip_stat_t * stat = lv_display_get_strip_stat(disp);
+    TEST_ASSERT_EQUAL_UINT32(1, stat->area_cnt);
+    TEST_ASSERT_EQUAL_UINT32(6, stat->strip_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stat->task_cnt_max);
+    uint32_t task_cnt_6 = stat->task_cnt;
+
+    /*The widgets spanning multiple strips are drawn in each*/
+    lv_display_set_strip_size(disp, 0);
+    lv_display_reset_strip_stat(disp);
+    refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(1, stat->strip_cnt);
+    TEST_ASSERT_LESS_THAN_UINT32(task_cnt_6, stat->task_cnt);
+}
+
+void test_display_strip_min_rows(void)
+{
+    /*Not more strips than with `LV_DISPLAY_STRIP_MIN_ROWS` rows*/
+    lv_display_set_strip_size(disp, 1);
+    refr_screen();
+    TEST_ASSERT_EQUAL_UINT32((DISP_VER_RES + LV_DISPLAY_STRIP_MIN_ROWS - 1) / LV_DISPLAY_STRIP_MIN_ROWS, flush_cnt);
+}
+
+void test_display_strip_even(void)
+{
+    /*Fit 50 rows: 3 strips with 40 rows instead of 50, 50 and 20*/
+    lv_display_set_strip_size(disp, get_stride() * 50);
+    refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(3, flush_cnt);
+
+    uint32_t i;
+    for(i = 0; i < flush_cnt; i++) {
+        TEST_ASSERT_EQUAL_INT32(40, lv_area_get_height(&flush_areas[i]));
+    }
+}
+
+void test_display_strip_rounding(void)
+{
+    lv_display_add_event_cb(disp, round_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+
+    /*Fit 30 rows: 24 after rounding, and 5 strips with 24 rows*/
+    lv_display_set_strip_size(disp, get_stride() * 30);
+    refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(5, flush_cnt);
+    uint32_t i;
+    for(i = 0; i < flush_cnt; i++) {
+        TEST_ASSERT_EQUAL_INT32(24, lv_area_get_height(&flush_areas[i]));
+        TEST_ASSERT_EQUAL_INT32(0, flush_areas[i].y1 % 8);
+    }
+
+    /*The rounding is remembered*/
+    TEST_ASSERT_GREATER_THAN_UINT32(0, round_probe_cnt);
+    round_probe_cnt = 0;
+    refr_screen();
+    TEST_ASSERT_EQUAL_UINT32(5, flush_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, round_probe_cnt);
+
+    /*A new callback can round differently*/
+    lv_display_add_event_cb(disp, round_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    refr_screen();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, round_probe_cnt);
+}
+
+#endif
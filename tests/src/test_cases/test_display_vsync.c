@@ -0,0 +1,200 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/display/lv_display_private.h"
+#include "../../../src/core/lv_global.h"
+
+#include "unity/unity.h"
+
+#define DISP_HOR_RES    160
+#define DISP_VER_RES    120
+#define VSYNC_PERIOD    16  /*[ms]*/
+
+static lv_display_t * disp;
+static lv_draw_buf_t * buf;
+static lv_obj_t * obj;
+
+static uint32_t vsync_start;
+static uint32_t anim_start;
+static uint32_t render_time;
+static uint32_t frame_cnt;
+static uint32_t early_cnt;
+static int32_t x_err_max;
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(d);
+}
+
+/*Emulate the time of rendering and check the frame*/
+static void refr_start_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+
+    /*The frame should be shown at the next vsync*/
+    uint32_t now = lv_tick_get();
+    uint32_t vsync = vsync_start + ((now - vsync_start) / VSYNC_PERIOD + 1) * VSYNC_PERIOD;
+
+    /*The rendering should start just in time, not right after the previous vsync*/
+    if(vsync - now > render_time + LV_DISPLAY_VSYNC_MARGIN + 1) early_cnt++;
+
+    /*The animation should be evaluated for the vsync*/
+    int32_t x_err = LV_ABS(lv_obj_get_style_x(obj, 0) - (int32_t)(vsync - anim_start));
+    x_err_max = LV_MAX(x_err_max, x_err);
+
+    frame_cnt++;
+    lv_tick_inc(render_time);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    disp = lv_display_create(DISP_HOR_RES, DISP_VER_RES);
+    lv_display_set_flush_cb(disp, flush_cb);
+    buf = lv_draw_buf_create(DISP_HOR_RES, DISP_VER_RES, lv_display_get_color_format(disp), LV_STRIDE_AUTO);
+    lv_display_set_draw_buffers(disp, buf, NULL);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+
+    obj = lv_obj_create(lv_display_get_screen_active(disp));
+    lv_obj_set_size(obj, 20, 20);
+    lv_display_add_event_cb(disp, refr_start_cb, LV_EVENT_REFR_START, NULL);
+
+    render_time = 5;
+    frame_cnt = 0;
+    early_cnt = 0;
+    x_err_max = 0;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_anim_delete(obj, NULL);
+    lv_display_delete(disp);
+    lv_draw_buf_destroy(buf);
+}
+
+static void anim_x_cb(void * var, int32_t v)
+{
+    lv_obj_set_x(var, v);
+}
+
+/*Move `obj` with 1 px/ms*/
+static void start_anim(void)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, obj);
+    lv_anim_set_values(&a, 0, 1000);
+    lv_anim_set_duration(&a, 1000);
+    lv_anim_set_exec_cb(&a, anim_x_cb);
+    lv_anim_start(&a);
+    anim_start = lv_tick_get();
+}
+
+/*Run the timers for `time` ms and report a vsync in every `VSYNC_PERIOD` ms*/
+static void run(uint32_t time)
+{
+    uint32_t end = lv_tick_get() + time;
+    uint32_t next_vsync = vsync_start + ((lv_tick_get() - vsync_start) / VSYNC_PERIOD + 1) * VSYNC_PERIOD;
+    while((int32_t)(end - lv_tick_get()) > 0) {
+        lv_tick_inc(1);
+        while((int32_t)(lv_tick_get() - next_vsync) >= 0) {
+            lv_display_report_vsync(disp, next_vsync);
+            next_vsync += VSYNC_PERIOD;
+        }
+        lv_timer_handler();
+    }
+}
+
+void test_display_vsync_pacing(void)
+{
+    vsync_start = lv_tick_get();
+    lv_display_report_vsync(disp, vsync_start);
+    start_anim();
+
+    /*Let the render time be measured*/
+    run(100);
+    TEST_ASSERT_EQUAL_UINT32(VSYNC_PERIOD * 1000, disp->frame_sched.period_us);
+    TEST_ASSERT_EQUAL_UINT32(render_time, lv_display_get_frame_stat(disp)->render_time);
+
+    lv_display_reset_frame_stat(disp);
+    frame_cnt = 0;
+    early_cnt = 0;
+    x_err_max = 0;
+
+    run(500);
+    const lv_display_frame_stat_t * stat = lv_display_get_frame_stat(disp);
+    TEST_ASSERT_GREATER_THAN_UINT32(5, frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(frame_cnt, stat->frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat->missed_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, early_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL_INT32(1, x_err_max);
+
+    /*The frame time of the display is not used after its refreshing*/
+    TEST_ASSERT_FALSE(LV_GLOBAL_DEFAULT()->anim_state.frame_time_set);
+}
+
+void test_display_vsync_more_reports_between_refreshes(void)
+{
+    /*E.g. the vsync interrupt fires more times while the refresh timer doesn't run*/
+    vsync_start = lv_tick_get();
+    lv_display_report_vsync(disp, vsync_start);
+    lv_obj_invalidate(obj);
+    lv_timer_ready(lv_display_get_refr_timer(disp));
+    lv_timer_handler();
+
+    uint32_t i;
+    for(i = 1; i <= 3; i++) {
+        lv_tick_inc(VSYNC_PERIOD);
+        lv_display_report_vsync(disp, vsync_start + i * VSYNC_PERIOD);
+    }
+
+    lv_obj_invalidate(obj);
+    lv_timer_ready(lv_display_get_refr_timer(disp));
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(VSYNC_PERIOD * 1000, disp->frame_sched.period_us);
+    TEST_ASSERT_EQUAL_UINT32(vsync_start + 3 * VSYNC_PERIOD, disp->frame_sched.vsync_tick);
+}
+
+void test_display_vsync_missed(void)
+{
+    vsync_start = lv_tick_get();
+    lv_display_report_vsync(disp, vsync_start);
+    start_anim();
+    run(100);
+    lv_display_reset_frame_stat(disp);
+
+    /*A slow frame misses its vsync*/
+    render_time = 12;
+    run(40);
+    const lv_display_frame_stat_t * stat = lv_display_get_frame_stat(disp);
+    TEST_ASSERT_EQUAL_UINT32(1, stat->missed_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, stat->late_time_max);
+    TEST_ASSERT_EQUAL_UINT32(12, stat->render_time);
+
+    /*The following frames are started earlier and are ready in time*/
+    lv_display_reset_frame_stat(disp);
+    run(200);
+    TEST_ASSERT_GREATER_THAN_UINT32(3, stat->frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stat->missed_cnt);
+}
+
+void test_display_vsync_timeout(void)
+{
+    /*No vsync reported for a long time: refresh immediately as without vsync*/
+    vsync_start = lv_tick_get();
+    lv_display_report_vsync(disp, vsync_start);
+    lv_display_set_vsync_period(disp, VSYNC_PERIOD * 1000);
+    lv_tick_inc(VSYNC_PERIOD * LV_DISPLAY_VSYNC_TIMEOUT);
+
+    lv_timer_handler();
+    lv_obj_set_x(obj, 10);
+    lv_timer_ready(lv_display_get_refr_timer(disp));
+    uint32_t cnt = frame_cnt;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(cnt + 1, frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_display_get_frame_stat(disp)->frame_cnt);
+}
+
+#endif
@@ -0,0 +1,116 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/display/lv_display_private.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+static uint32_t get_inv_px_sum(lv_display_t * disp)
+{
+    uint32_t sum = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        sum += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    return sum;
+}
+
+static bool is_invalidated(lv_display_t * disp, const lv_area_t * area)
+{
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(_lv_area_is_in(area, &disp->inv_areas[i], 0)) return true;
+    }
+    return false;
+}
+
+void test_inv_area_no_full_screen_fallback(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    uint32_t scr_size = lv_display_get_horizontal_resolution(disp) * lv_display_get_vertical_resolution(disp);
+
+    /*Many small indicators all over the screen*/
+    lv_area_t areas[100];
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_area_set(&areas[i], (i % 10) * 80 + 10, (i / 10) * 48 + 10, (i % 10) * 80 + 17, (i / 10) * 48 + 17);
+        _lv_inv_area(disp, &areas[i]);
+    }
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_INV_BUF_SIZE, disp->inv_p);
+    TEST_ASSERT_LESS_THAN_UINT32(scr_size / 4, get_inv_px_sum(disp));
+    for(i = 0; i < 100; i++) {
+        TEST_ASSERT_TRUE(is_invalidated(disp, &areas[i]));
+    }
+
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->inv_p);
+}
+
+void test_inv_area_covered_areas_are_removed(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+
+    lv_area_t a;
+    lv_area_set(&a, 10, 10, 19, 19);
+    _lv_inv_area(disp, &a);
+    lv_area_set(&a, 30, 10, 39, 19);
+    _lv_inv_area(disp, &a);
+    TEST_ASSERT_EQUAL_UINT32(2, disp->inv_p);
+
+    /*Covers both areas*/
+    lv_area_set(&a, 0, 0, 99, 99);
+    _lv_inv_area(disp, &a);
+    TEST_ASSERT_EQUAL_UINT32(1, disp->inv_p);
+
+    /*Inside the saved area*/
+    lv_area_set(&a, 50, 50, 59, 59);
+    _lv_inv_area(disp, &a);
+    TEST_ASSERT_EQUAL_UINT32(1, disp->inv_p);
+}
+
+static void flush_start_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+void test_inv_area_close_areas_are_joined(void)
+{
+    lv_display_t * disp = lv_display_get_default();
+    uint32_t flush_cnt = 0;
+    lv_display_add_event_cb(disp, flush_start_cb, LV_EVENT_FLUSH_START, &flush_cnt);
+
+    /*Far from each other: refreshed separately*/
+    lv_area_t a1;
+    lv_area_t a2;
+    lv_area_set(&a1, 10, 10, 19, 19);
+    lv_area_set(&a2, 400, 300, 409, 309);
+    _lv_inv_area(disp, &a1);
+    _lv_inv_area(disp, &a2);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, flush_cnt);
+
+    /*Only a small gap between them: refreshing them together is cheaper*/
+    flush_cnt = 0;
+    lv_area_set(&a2, 21, 10, 30, 19);
+    _lv_inv_area(disp, &a1);
+    _lv_inv_area(disp, &a2);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, flush_cnt);
+
+    lv_display_remove_event_cb_with_user_data(disp, flush_start_cb, &flush_cnt);
+}
+
+#endif
@@ -19,7 +19,9 @@
 #include <string.h>
 #include <stdarg.h>
 #include <sys/stat.h>
+#include <time.h>
 #include "unity.h"
+#include "../../src/draw/sw/blend/x86/lv_blend_x86.h"
 #define PNG_DEBUG 3
 #include <png.h>
 
@@ -31,6 +33,16 @@
 #define ERR_FILE_NOT_FOUND  -1
 #define ERR_PNG             -2
 
+/*If this environment variable is set every screenshot is rendered with the C implementation too
+ *and compared with the accelerated rendering*/
+#define COMPARE_C_ENV       "LV_TEST_COMPARE_C"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && LV_DRAW_SW_X86_AVAILABLE
+    #define COMPARE_C_SUPPORTED 1
+#else
+    #define COMPARE_C_SUPPORTED 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -54,10 +66,20 @@ static int write_png_file(void * raw_img, uint32_t width, uint32_t height, char
 static void png_release(png_image_t * p);
 static void buf_to_xrgb8888(const uint8_t * buf_in, uint8_t * buf_out, lv_color_format_t cf_in);
 static void create_folders_if_needed(const char * path) ;
+#if COMPARE_C_SUPPORTED
+    static bool compare_with_c(void);
+    static uint64_t render_screen(void);
+    static void print_compare_c_times(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if COMPARE_C_SUPPORTED
+    static uint64_t compare_c_time_c;
+    static uint64_t compare_c_time_accelerated;
+    static uint32_t compare_c_cnt;
+#endif
 
 /**********************
  *      MACROS
@@ -71,6 +93,15 @@ bool lv_test_assert_image_eq(const char * fn_ref)
 {
     bool pass;
 
+    if(getenv(COMPARE_C_ENV)) {
+#if COMPARE_C_SUPPORTED
+        pass = compare_with_c();
+        if(!pass) return false;
+#else
+        TEST_IGNORE_MESSAGE("Comparing with the C implementation requires the x86 blend kernels");
+#endif
+    }
+
     lv_obj_t * scr = lv_screen_active();
     lv_obj_invalidate(scr);
 
@@ -418,6 +449,97 @@ static void buf_to_xrgb8888(const uint8_t * buf_in, uint8_t * buf_out, lv_color_
     }
 }
 
+#if COMPARE_C_SUPPORTED
+/**
+ * Render the screen with the accelerated kernels and with the C implementation
+ * and compare the results byte by byte
+ * @return  true: the renderings are the same; false: they are different
+ */
+static bool compare_with_c(void)
+{
+    lv_draw_sw_x86_level_t level = lv_draw_sw_blend_x86_get_level();
+    if(level == LV_DRAW_SW_X86_LEVEL_NONE) {
+        TEST_IGNORE_MESSAGE("The CPU doesn't support the x86 blend kernels");
+    }
+
+    if(compare_c_cnt == 0) atexit(print_compare_c_times);
+
+    extern uint8_t * last_flushed_buf;
+    lv_color_format_t cf = lv_display_get_color_format(NULL);
+    int32_t hor_res = lv_display_get_horizontal_resolution(NULL);
+    int32_t ver_res = lv_display_get_vertical_resolution(NULL);
+    uint32_t stride = lv_draw_buf_width_to_stride(hor_res, cf);
+    uint32_t row_size = (hor_res * lv_color_format_get_bpp(cf) + 7) / 8;
+    uint8_t * screen_buf_accelerated = malloc(row_size * ver_res);
+    TEST_ASSERT_NOT_NULL(screen_buf_accelerated);
+
+    uint64_t time_accelerated = render_screen();
+    const uint8_t * screen_buf = lv_draw_buf_align(last_flushed_buf, cf);
+    int32_t y;
+    for(y = 0; y < ver_res; y++) {
+        memcpy(&screen_buf_accelerated[y * row_size], &screen_buf[y * stride], row_size);
+    }
+
+    lv_draw_sw_blend_x86_set_level(LV_DRAW_SW_X86_LEVEL_NONE);
+    uint64_t time_c = render_screen();
+    lv_draw_sw_blend_x86_set_level(level);
+
+    screen_buf = lv_draw_buf_align(last_flushed_buf, cf);
+    for(y = 0; y < ver_res; y++) {
+        const uint8_t * row_c = &screen_buf[y * stride];
+        const uint8_t * row_accelerated = &screen_buf_accelerated[y * row_size];
+        uint32_t i;
+        for(i = 0; i < row_size; i++) {
+            if(row_c[i] != row_accelerated[i]) {
+                TEST_PRINTF("\nAccelerated rendering differs from the C implementation\n"
+                            "  - Level: %d\n"
+                            "  - At x:%d, y:%d (byte %d)\n"
+                            "  - C:           %02X\n"
+                            "  - Accelerated: %02X",
+                            (int)level, (int)(i * 8 / lv_color_format_get_bpp(cf)), (int)y, (int)i,
+                            row_c[i], row_accelerated[i]);
+                fflush(stderr);
+                free(screen_buf_accelerated);
+                return false;
+            }
+        }
+    }
+
+    free(screen_buf_accelerated);
+    compare_c_time_c += time_c;
+    compare_c_time_accelerated += time_accelerated;
+    compare_c_cnt++;
+    return true;
+}
+
+/**
+ * Render the whole screen
+ * @return  the time of rendering in nanoseconds
+ */
+static uint64_t render_screen(void)
+{
+    struct timespec t_start;
+    struct timespec t_end;
+
+    /*Render the cached layers again too, else they would be blended as they were
+     *rendered by the other implementation*/
+    lv_draw_layer_cache_drop(NULL);
+    lv_obj_invalidate(lv_screen_active());
+    clock_gettime(CLOCK_MONOTONIC, &t_start);
+    lv_refr_now(NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t_end);
+
+    return (uint64_t)(t_end.tv_sec - t_start.tv_sec) * 1000000000 + t_end.tv_nsec - t_start.tv_nsec;
+}
+
+static void print_compare_c_times(void)
+{
+    double ratio = compare_c_time_accelerated ? (double)compare_c_time_c / compare_c_time_accelerated : 0;
+    printf("\nCompared with C: %u screenshots, C: %.2f ms, accelerated: %.2f ms, C / accelerated: %.2f\n",
+           (unsigned)compare_c_cnt, compare_c_time_c / 1000000.0, compare_c_time_accelerated / 1000000.0, ratio);
+}
+#endif
+
 static void create_folders_if_needed(const char * path)
 {
     char * ptr;